@@ -0,0 +1,42 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+
+//-----------------------------------------------------------------------------
+static void BM_RMCCourseAngleStd(benchmark::State & state)
+{
+  double speed = 0.;
+  for (auto _ : state) {
+    speed += 0.01;
+    benchmark::DoNotOptimize(romea::core::rmcCourseAngleStd(speed, 0.02, 1.0));
+  }
+}
+BENCHMARK(BM_RMCCourseAngleStd);
+
+//-----------------------------------------------------------------------------
+static void BM_HDTCourseAngleStd(benchmark::State & state)
+{
+  double baseline = 0.5;
+  for (auto _ : state) {
+    baseline += 0.01;
+    benchmark::DoNotOptimize(romea::core::hdtCourseAngleStd(baseline, 0.02));
+  }
+}
+BENCHMARK(BM_HDTCourseAngleStd);
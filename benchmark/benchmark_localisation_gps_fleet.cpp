@@ -0,0 +1,72 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <memory>
+#include <string>
+
+// romea
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSFleet.hpp"
+
+//-----------------------------------------------------------------------------
+static std::string ggaSentence()
+{
+  romea::core::GGAFrame frame;
+  frame.talkerId = romea::core::TalkerId::GN;
+  frame.longitude = romea::core::Longitude(0.03);
+  frame.latitude = romea::core::Latitude(0.7854);
+  frame.geoidHeight = 400.8;
+  frame.altitudeAboveGeoid = 53.3;
+  frame.horizontalDilutionOfPrecision = 1.2;
+  frame.numberSatellitesUsedToComputeFix = 12;
+  frame.fixQuality = romea::core::FixQuality::RTK_FIX;
+  return frame.toNMEA();
+}
+
+//-----------------------------------------------------------------------------
+// arguments are the number of vehicles and the number of threads
+static void BM_FleetGGAThroughput(benchmark::State & state)
+{
+  const size_t numberOfVehicles = state.range(0);
+  const std::string sentence = ggaSentence();
+
+  romea::core::LocalisationGPSFleet fleet(state.range(1));
+  for (size_t id = 0; id < numberOfVehicles; ++id) {
+    fleet.addVehicle(
+      id, std::make_unique<romea::core::LocalisationDualAntennaGPSPlugin>(
+        std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX));
+  }
+
+  size_t step = 0;
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(++step);
+    for (size_t id = 0; id < numberOfVehicles; ++id) {
+      fleet.postSentence(id, stamp, sentence);
+    }
+    fleet.waitUntilIdle();
+  }
+
+  auto metrics = fleet.getMetrics();
+  state.SetItemsProcessed(metrics.processedInputs);
+  state.counters["stolen_tasks"] = metrics.pool.stolenTasks;
+  state.counters["max_queue_length"] = metrics.maximalVehicleQueueLength;
+}
+BENCHMARK(BM_FleetGGAThroughput)
+->Args({1000, 1})->Args({1000, 2})->Args({1000, 4})->Args({1000, 8})
+->UseRealTime();
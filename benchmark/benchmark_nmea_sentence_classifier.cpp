@@ -0,0 +1,87 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_gps/NMEASentenceClassifier.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// traffic of a receiver emitting more sentence types than the plugins use
+const std::vector<std::string> & mixedTraffic()
+{
+  static const std::vector<std::string> traffic = {
+    "$GNGGA,120000.00,4500.0000,N,00130.0000,E,4,12,1.2,53.3,M,400.8,M,2.5,1*00",
+    "$GNGSA,A,3,01,02,03,04,05,06,07,08,09,10,11,12,1.8,1.2,1.3*00",
+    "$GPGSV,3,1,11,01,45,120,44,02,30,200,42,03,60,300,45,04,10,050,35*00",
+    "$GNGST,120000.00,1.2,0.02,0.01,35.0,0.015,0.012,0.03*00",
+    "$GNRMC,120000.00,A,4500.0000,N,00130.0000,E,6.2,88.2,191026,0.9,W,R*00",
+    "$GNVTG,88.2,T,89.1,M,6.2,N,11.5,K,R*00",
+    "$GNZDA,120000.00,19,10,2026,00,00*00",
+    "$PUBX,00,120000.00,4500.0000,N,00130.0000,E,53.3,R2,0.01,0.01*00"};
+  return traffic;
+}
+
+//-----------------------------------------------------------------------------
+// classification by successive comparisons of the sentence id, as done by
+// integration layers before
+int classifyByComparison(const std::string & sentence)
+{
+  static const char * SENTENCE_IDS[] = {"GGA", "RMC", "HDT", "GSV", "GSA", "VTG", "ZDA", "GST"};
+  if (sentence.size() > 6 && sentence[0] == '$') {
+    for (int n = 0; n < 8; ++n) {
+      if (sentence.compare(3, 3, SENTENCE_IDS[n]) == 0) {
+        return n;
+      }
+    }
+  }
+  return 8;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+static void BM_ClassifyByComparison(benchmark::State & state)
+{
+  const auto & traffic = mixedTraffic();
+  for (auto _ : state) {
+    for (const auto & sentence : traffic) {
+      benchmark::DoNotOptimize(classifyByComparison(sentence));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * traffic.size());
+}
+BENCHMARK(BM_ClassifyByComparison);
+
+//-----------------------------------------------------------------------------
+static void BM_ClassifyByPerfectHash(benchmark::State & state)
+{
+  const auto & traffic = mixedTraffic();
+  for (auto _ : state) {
+    for (const auto & sentence : traffic) {
+      benchmark::DoNotOptimize(romea::core::classifyNMEASentence(sentence));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * traffic.size());
+}
+BENCHMARK(BM_ClassifyByPerfectHash);
@@ -0,0 +1,146 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_gps/ObservationQueue.hpp"
+
+namespace
+{
+
+const int64_t NUMBER_OF_OBSERVATIONS_PER_PRODUCER = 20000;
+
+//-----------------------------------------------------------------------------
+romea::core::ObservationPosition makePosition()
+{
+  romea::core::ObservationPosition positionObs;
+  positionObs.Y() << 12.3, -4.5;
+  positionObs.R() = Eigen::Matrix2d::Identity() * 0.0004;
+  positionObs.levelArm = Eigen::Vector3d(0.3, 0., 2.);
+  return positionObs;
+}
+
+//-----------------------------------------------------------------------------
+// stands for a filter whose observation insertion is protected by a lock,
+// producers block on it while the filter thread processes its inputs
+class LockedFilterInput
+{
+public:
+  void insert(const romea::core::Duration & stamp, const romea::core::ObservationPosition & obs)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observations_.push_back({romea::core::QueuedObservationType::POSITION, 0, stamp, {}, obs, {}});
+  }
+
+  size_t process()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t numberOfObservations = 0;
+    while (!observations_.empty()) {
+      benchmark::DoNotOptimize(observations_.front().positionObs.Y());
+      observations_.pop_front();
+      ++numberOfObservations;
+    }
+    return numberOfObservations;
+  }
+
+private:
+  std::mutex mutex_;
+  std::deque<romea::core::QueuedObservation> observations_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Publish, typename Drain>
+void runHandOff(const int64_t & numberOfProducers, Publish && publish, Drain && drain)
+{
+  std::vector<std::thread> producers;
+  for (int64_t producer = 0; producer < numberOfProducers; ++producer) {
+    producers.emplace_back([&publish]() {
+        const auto positionObs = makePosition();
+        for (int64_t n = 0; n < NUMBER_OF_OBSERVATIONS_PER_PRODUCER; ++n) {
+          while (!publish(romea::core::Duration(n), positionObs)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  int64_t numberOfObservations = numberOfProducers * NUMBER_OF_OBSERVATIONS_PER_PRODUCER;
+  while (numberOfObservations > 0) {
+    size_t numberOfDrainedObservations = drain();
+    if (numberOfDrainedObservations == 0) {
+      std::this_thread::yield();
+    }
+    numberOfObservations -= numberOfDrainedObservations;
+  }
+
+  for (auto & producer : producers) {
+    producer.join();
+  }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+// argument is the number of producer threads
+static void BM_LockedHandOff(benchmark::State & state)
+{
+  for (auto _ : state) {
+    LockedFilterInput input;
+    runHandOff(
+      state.range(0),
+      [&input](const romea::core::Duration & stamp, const romea::core::ObservationPosition & obs) {
+        input.insert(stamp, obs);
+        return true;
+      },
+      [&input]() {return input.process();});
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * NUMBER_OF_OBSERVATIONS_PER_PRODUCER);
+}
+BENCHMARK(BM_LockedHandOff)->Arg(1)->Arg(3)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//-----------------------------------------------------------------------------
+// argument is the number of producer threads
+static void BM_ObservationQueueHandOff(benchmark::State & state)
+{
+  for (auto _ : state) {
+    romea::core::ObservationQueue queue;
+    runHandOff(
+      state.range(0),
+      [&queue](const romea::core::Duration & stamp, const romea::core::ObservationPosition & obs) {
+        return queue.publish(0, stamp, obs);
+      },
+      [&queue]() {
+        return queue.drain(
+          [](const romea::core::QueuedObservation & observation) {
+            benchmark::DoNotOptimize(observation.positionObs.Y());
+          });
+      });
+    state.counters["maximal_depth"] = queue.getMaximalDepth();
+    state.counters["mean_latency_us"] = 1e-3 * queue.getMeanLatency().count();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * NUMBER_OF_OBSERVATIONS_PER_PRODUCER);
+}
+BENCHMARK(BM_ObservationQueueHandOff)->Arg(1)->Arg(3)->UseRealTime()->Unit(benchmark::kMillisecond);
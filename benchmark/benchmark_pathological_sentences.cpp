@@ -0,0 +1,146 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <cstdio>
+#include <memory>
+#include <string>
+
+// romea
+#include "romea_core_localisation_gps/RealtimeLocalisationGPSPlugin.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+std::string finishSentence(const std::string & body)
+{
+  unsigned char checksum = 0;
+  for (size_t n = 1; n < body.size(); ++n) {
+    checksum ^= static_cast<unsigned char>(body[n]);
+  }
+  char suffix[8];
+  std::snprintf(suffix, sizeof(suffix), "*%02X\r\n", checksum);
+  return body + suffix;
+}
+
+//-----------------------------------------------------------------------------
+// valid GGA sentence whose altitude field is a number of the given length
+std::string longGGASentence(const size_t & length)
+{
+  return finishSentence(
+    "$GNGGA,120000.00,4500.0000,N,00130.0000,E,4,12,1.2," + std::string(length, '9') +
+    ",M,400.8,M,2.5,1");
+}
+
+//-----------------------------------------------------------------------------
+std::string manyCommasSentence(const char * address, const size_t & length)
+{
+  return finishSentence(std::string("$") + address + std::string(length, ','));
+}
+
+//-----------------------------------------------------------------------------
+std::string hugeNumbersSentence(const size_t & length)
+{
+  std::string body = "$GPRMC";
+  while (body.size() < length) {
+    body += ",1e308";
+  }
+  return finishSentence(body);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Process>
+void measureThroughput(
+  benchmark::State & state,
+  const std::string & sentence,
+  Process && process)
+{
+  // the realtime plugin parses sentences with the scanners
+  romea::core::RealtimeLocalisationSingleAntennaGPSPlugin plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.);
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+
+  int64_t index = 0;
+  for (auto _ : state) {
+    auto stamp = romea::core::durationFromSecond(0.1 * index++);
+    benchmark::DoNotOptimize(process(plugin, stamp, sentence, position, course));
+  }
+
+  state.SetBytesProcessed(state.iterations() * sentence.size());
+  state.SetComplexityN(state.range(0));
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+static void BM_LongGGASentence(benchmark::State & state)
+{
+  measureThroughput(
+    state, longGGASentence(state.range(0)),
+    [](auto & plugin, auto & stamp, auto & sentence, auto & position, auto &) {
+      return plugin.processGGA(stamp, sentence, position);
+    });
+}
+BENCHMARK(BM_LongGGASentence)->RangeMultiplier(8)->Range(64, 1 << 18)->Complexity();
+
+//-----------------------------------------------------------------------------
+static void BM_ManyCommasGGASentence(benchmark::State & state)
+{
+  measureThroughput(
+    state, manyCommasSentence("GNGGA", state.range(0)),
+    [](auto & plugin, auto & stamp, auto & sentence, auto & position, auto &) {
+      return plugin.processGGA(stamp, sentence, position);
+    });
+}
+BENCHMARK(BM_ManyCommasGGASentence)->RangeMultiplier(8)->Range(64, 1 << 18)->Complexity();
+
+//-----------------------------------------------------------------------------
+static void BM_ManyCommasRMCSentence(benchmark::State & state)
+{
+  measureThroughput(
+    state, manyCommasSentence("GPRMC", state.range(0)),
+    [](auto & plugin, auto & stamp, auto & sentence, auto &, auto & course) {
+      return plugin.processRMC(stamp, sentence, course);
+    });
+}
+BENCHMARK(BM_ManyCommasRMCSentence)->RangeMultiplier(8)->Range(64, 1 << 18)->Complexity();
+
+//-----------------------------------------------------------------------------
+static void BM_HugeNumbersRMCSentence(benchmark::State & state)
+{
+  measureThroughput(
+    state, hugeNumbersSentence(state.range(0)),
+    [](auto & plugin, auto & stamp, auto & sentence, auto &, auto & course) {
+      return plugin.processRMC(stamp, sentence, course);
+    });
+}
+BENCHMARK(BM_HugeNumbersRMCSentence)->RangeMultiplier(8)->Range(64, 1 << 18)->Complexity();
+
+//-----------------------------------------------------------------------------
+static void BM_ManyCommasGSVSentence(benchmark::State & state)
+{
+  measureThroughput(
+    state, manyCommasSentence("GPGSV", state.range(0)),
+    [](auto & plugin, auto &, auto & sentence, auto &, auto &) {
+      plugin.processGSV(sentence);
+      return true;
+    });
+}
+BENCHMARK(BM_ManyCommasGSVSentence)->RangeMultiplier(8)->Range(64, 1 << 18)->Complexity();
@@ -0,0 +1,117 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <memory>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/NMEACorpusGenerator.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// ten minutes of a 10 Hz receiver, the serial line is kept clean because
+// corrupted sentences are the business of fuzzing
+std::vector<romea::core::NMEACorpusRecord> makeCorpus(const bool & emitsHDT)
+{
+  romea::core::NMEACorpusOptions options;
+  options.seed = 1;
+  options.emitsHDT = emitsHDT;
+  options.corruptChecksumProbability = 0.;
+  options.truncationProbability = 0.;
+  options.duration = romea::core::durationFromSecond(600.);
+
+  romea::core::NMEACorpusGenerator generator(options);
+  std::vector<romea::core::NMEACorpusRecord> corpus;
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    corpus.push_back(record);
+  }
+  return corpus;
+}
+
+//-----------------------------------------------------------------------------
+bool hasSentenceId(const std::string & sentence, const char * sentenceId)
+{
+  return sentence.compare(3, 3, sentenceId) == 0;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+static void BM_SingleAntennaPluginCorpusReplay(benchmark::State & state)
+{
+  const auto corpus = makeCorpus(false);
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+
+  for (auto _ : state) {
+    romea::core::LocalisationSingleAntennaGPSPlugin plugin(
+      std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.);
+    plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+
+    size_t numberOfObservations = 0;
+    for (const auto & record : corpus) {
+      if (hasSentenceId(record.sentence, "GGA")) {
+        numberOfObservations += plugin.processGGA(record.stamp, record.sentence, position);
+      } else if (hasSentenceId(record.sentence, "RMC")) {
+        plugin.processLinearSpeed(record.stamp, record.truth.linearSpeed);
+        numberOfObservations += plugin.processRMC(record.stamp, record.sentence, course);
+      } else {
+        plugin.processGSV(record.sentence);
+      }
+    }
+    benchmark::DoNotOptimize(numberOfObservations);
+  }
+
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_SingleAntennaPluginCorpusReplay)->Unit(benchmark::kMillisecond);
+
+//-----------------------------------------------------------------------------
+static void BM_DualAntennaPluginCorpusReplay(benchmark::State & state)
+{
+  const auto corpus = makeCorpus(true);
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+
+  for (auto _ : state) {
+    romea::core::LocalisationDualAntennaGPSPlugin plugin(
+      std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+    plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+
+    size_t numberOfObservations = 0;
+    for (const auto & record : corpus) {
+      if (hasSentenceId(record.sentence, "GGA")) {
+        numberOfObservations += plugin.processGGA(record.stamp, record.sentence, position);
+      } else if (hasSentenceId(record.sentence, "HDT")) {
+        numberOfObservations += plugin.processHDT(record.stamp, record.sentence, course);
+      } else if (hasSentenceId(record.sentence, "GSV")) {
+        plugin.processGSV(record.sentence);
+      }
+    }
+    benchmark::DoNotOptimize(numberOfObservations);
+  }
+
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_DualAntennaPluginCorpusReplay)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,102 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+#include <malloc.h>
+
+// std
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "../test/helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+
+namespace
+{
+std::atomic<int64_t> liveHeapBytes(0);
+}
+
+void * operator new(std::size_t size)
+{
+  if (void * ptr = std::malloc(size)) {
+    liveHeapBytes += malloc_usable_size(ptr);
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+  if (ptr) {
+    liveHeapBytes -= malloc_usable_size(ptr);
+    std::free(ptr);
+  }
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Plugin, typename ... Args>
+void measurePluginMemory(benchmark::State & state, Args && ... args)
+{
+  const size_t numberOfPlugins = 1000;
+  const std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+
+  for (auto _ : state) {
+    int64_t heapBytesBefore = liveHeapBytes;
+
+    std::vector<std::unique_ptr<Plugin>> plugins;
+    plugins.reserve(numberOfPlugins);
+    for (size_t n = 0; n < numberOfPlugins; ++n) {
+      auto gps = std::make_unique<romea::core::GPSReceiver>();
+      plugins.push_back(std::make_unique<Plugin>(std::move(gps), args ...));
+
+      romea::core::ObservationPosition position;
+      auto stamp = romea::core::durationFromSecond(0.5);
+      plugins.back()->processGGA(stamp, ggaSentence, position);
+      plugins.back()->makeDiagnosticReport(stamp);
+    }
+
+    state.counters["bytes_per_plugin"] =
+      static_cast<double>(liveHeapBytes - heapBytesBefore) / numberOfPlugins;
+    state.counters["sizeof_plugin"] = sizeof(Plugin);
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void BM_SingleAntennaPluginMemory(benchmark::State & state)
+{
+  measurePluginMemory<romea::core::LocalisationSingleAntennaGPSPlugin>(
+    state, romea::core::FixQuality::RTK_FIX, 1.0);
+}
+BENCHMARK(BM_SingleAntennaPluginMemory)->Iterations(1);
+
+//-----------------------------------------------------------------------------
+static void BM_DualAntennaPluginMemory(benchmark::State & state)
+{
+  measurePluginMemory<romea::core::LocalisationDualAntennaGPSPlugin>(
+    state, romea::core::FixQuality::RTK_FIX);
+}
+BENCHMARK(BM_DualAntennaPluginMemory)->Iterations(1);
@@ -0,0 +1,97 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <memory>
+#include <string>
+#include <utility>
+
+// romea
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/ProcessingTracer.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+std::string makeGGASentence()
+{
+  romea::core::GGAFrame frame;
+  frame.talkerId = romea::core::TalkerId::GN;
+  frame.longitude = romea::core::Longitude(0.03);
+  frame.latitude = romea::core::Latitude(0.7854);
+  frame.geoidHeight = 400.8;
+  frame.altitudeAboveGeoid = 53.3;
+  frame.horizontalDilutionOfPrecision = 1.2;
+  frame.numberSatellitesUsedToComputeFix = 12;
+  frame.fixQuality = romea::core::FixQuality::RTK_FIX;
+  frame.dgpsCorrectionAgeInSecond = 2.5;
+  frame.dgpsStationIdNumber = 1;
+  return frame.toNMEA();
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+// argument tells whether tracing is enabled
+static void BM_TraceScope(benchmark::State & state)
+{
+  romea::core::ProcessingTracer::enable(state.range(0) != 0);
+  int64_t step = 0;
+  for (auto _ : state) {
+    romea::core::TraceScope trace("benchmark", romea::core::Duration(++step));
+    trace.setOutcome(true);
+    // keeps the buffer from filling up, which would only measure drops
+    if ((step & 0xFFF) == 0) {
+      state.PauseTiming();
+      romea::core::ProcessingTracer::reset();
+      state.ResumeTiming();
+    }
+  }
+  romea::core::ProcessingTracer::enable(false);
+  romea::core::ProcessingTracer::reset();
+}
+BENCHMARK(BM_TraceScope)->Arg(0)->Arg(1);
+
+//-----------------------------------------------------------------------------
+// argument tells whether tracing is enabled, a disabled tracer must not
+// slow down sentence processing
+static void BM_ProcessGGA(benchmark::State & state)
+{
+  auto gps = std::make_unique<romea::core::GPSReceiver>();
+  romea::core::LocalisationSingleAntennaGPSPlugin plugin(
+    std::move(gps), romea::core::FixQuality::RTK_FIX, 1.);
+  const std::string ggaSentence = makeGGASentence();
+  romea::core::ObservationPosition positionObs;
+
+  romea::core::ProcessingTracer::enable(state.range(0) != 0);
+  int64_t step = 0;
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(++step / 10.);
+    benchmark::DoNotOptimize(plugin.processGGA(stamp, ggaSentence, positionObs));
+    if ((step & 0x7FF) == 0) {
+      state.PauseTiming();
+      romea::core::ProcessingTracer::reset();
+      state.ResumeTiming();
+    }
+  }
+  romea::core::ProcessingTracer::enable(false);
+  romea::core::ProcessingTracer::reset();
+}
+BENCHMARK(BM_ProcessGGA)->Arg(0)->Arg(1);
@@ -0,0 +1,165 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// posix
+#include <unistd.h>
+
+// romea
+#include "romea_core_localisation_gps/SharedObservationPublisher.hpp"
+#include "romea_core_localisation_gps/SharedObservationReader.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+std::string ringName(const std::string & benchmark)
+{
+  return "/romea_gps_benchmark_" + benchmark + "_" + std::to_string(getpid());
+}
+
+//-----------------------------------------------------------------------------
+romea::core::ObservationPosition makePosition()
+{
+  romea::core::ObservationPosition positionObs;
+  positionObs.Y(romea::core::ObservationPosition::POSITION_X) = 12.3;
+  positionObs.Y(romea::core::ObservationPosition::POSITION_Y) = -4.5;
+  positionObs.R() = Eigen::Matrix2d::Identity() * 0.0004;
+  positionObs.levelArm = Eigen::Vector3d(0.3, 0., 2.);
+  return positionObs;
+}
+
+//-----------------------------------------------------------------------------
+// stands for middleware serialization: the observation is written into a
+// message buffer which is copied and deserialized by each consumer
+std::vector<uint8_t> serialize(
+  const romea::core::Duration & stamp,
+  const romea::core::ObservationPosition & positionObs)
+{
+  std::vector<uint8_t> message(sizeof(int64_t) + 9 * sizeof(double));
+  int64_t count = stamp.count();
+  double values[9] = {
+    positionObs.Y(0), positionObs.Y(1),
+    positionObs.R()(0, 0), positionObs.R()(0, 1), positionObs.R()(1, 0), positionObs.R()(1, 1),
+    positionObs.levelArm.x(), positionObs.levelArm.y(), positionObs.levelArm.z()};
+  std::memcpy(message.data(), &count, sizeof(count));
+  std::memcpy(message.data() + sizeof(count), values, sizeof(values));
+  return message;
+}
+
+//-----------------------------------------------------------------------------
+romea::core::ObservationPosition deserialize(const std::vector<uint8_t> & message)
+{
+  double values[9];
+  std::memcpy(values, message.data() + sizeof(int64_t), sizeof(values));
+  romea::core::ObservationPosition positionObs;
+  positionObs.Y() << values[0], values[1];
+  positionObs.R() << values[2], values[3], values[4], values[5];
+  positionObs.levelArm << values[6], values[7], values[8];
+  return positionObs;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+// argument is the number of consumers
+static void BM_CopyPathPosition(benchmark::State & state)
+{
+  const auto positionObs = makePosition();
+  int64_t step = 0;
+  for (auto _ : state) {
+    auto message = serialize(romea::core::Duration(++step), positionObs);
+    for (int64_t consumer = 0; consumer < state.range(0); ++consumer) {
+      std::vector<uint8_t> copy(message);
+      benchmark::DoNotOptimize(deserialize(copy));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyPathPosition)->Arg(1)->Arg(4);
+
+//-----------------------------------------------------------------------------
+// argument is the number of consumers
+static void BM_SharedMemoryPosition(benchmark::State & state)
+{
+  const auto positionObs = makePosition();
+  romea::core::SharedObservationPublisher publisher(ringName("position"));
+  std::vector<std::unique_ptr<romea::core::SharedObservationReader>> readers;
+  for (int64_t consumer = 0; consumer < state.range(0); ++consumer) {
+    readers.push_back(
+      std::make_unique<romea::core::SharedObservationReader>(publisher.getName()));
+  }
+
+  romea::core::SharedObservationRecord record;
+  int64_t step = 0;
+  for (auto _ : state) {
+    publisher.publish(romea::core::Duration(++step), positionObs);
+    for (auto & reader : readers) {
+      reader->read(record);
+      benchmark::DoNotOptimize(romea::core::toObservationPosition(record));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SharedMemoryPosition)->Arg(1)->Arg(4);
+
+//-----------------------------------------------------------------------------
+// latency between publication and reception by a polling reader thread
+static void BM_SharedMemoryLatency(benchmark::State & state)
+{
+  const auto positionObs = makePosition();
+  romea::core::SharedObservationPublisher publisher(ringName("latency"));
+  romea::core::SharedObservationReader reader(publisher.getName());
+
+  std::atomic<bool> running(true);
+  std::atomic<uint64_t> numberOfReadRecords(0);
+  std::thread consumer([&]() {
+      romea::core::SharedObservationRecord record;
+      while (running.load(std::memory_order_relaxed)) {
+        if (reader.read(record)) {
+          numberOfReadRecords.store(record.index + 1, std::memory_order_release);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+  uint64_t numberOfRecords = 0;
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    publisher.publish(romea::core::Duration(numberOfRecords++), positionObs);
+    while (numberOfReadRecords.load(std::memory_order_acquire) != numberOfRecords) {
+      std::this_thread::yield();
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+
+  running = false;
+  consumer.join();
+}
+BENCHMARK(BM_SharedMemoryLatency)->UseManualTime();
@@ -0,0 +1,129 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Writes a synthetic NMEA corpus (see NMEACorpusGenerator), one sentence
+// per line prefixed by its stamp in nanoseconds, and optionally the ground
+// truth of each sentence as CSV, line by line with the corpus. Line endings
+// of sentences are stripped. A seed always gives the same corpus.
+//
+// usage: generate_nmea_corpus [--seed n] [--duration seconds] [--gnss-rate hz]
+//   [--speed m/s] [--single-antenna 1] [--dropout-rate per_second]
+//   [--multipath probability] [--hdop-spike probability] [--gsv-burst probability]
+//   [--corrupt-checksum probability] [--truncation probability]
+//   [--output path] [--truth path]
+
+// std
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// romea
+#include "romea_core_localisation_gps/NMEACorpusGenerator.hpp"
+
+namespace
+{
+
+struct Options
+{
+  romea::core::NMEACorpusOptions corpus;
+  std::string output;
+  std::string truth;
+};
+
+//-----------------------------------------------------------------------------
+Options parseOptions(int argc, char ** argv)
+{
+  Options options;
+  options.corpus.duration = romea::core::durationFromSecond(3600.);
+  for (int n = 1; n + 1 < argc; n += 2) {
+    const char * value = argv[n + 1];
+    if (!std::strcmp(argv[n], "--seed")) {
+      options.corpus.seed = std::strtoull(value, nullptr, 10);
+    } else if (!std::strcmp(argv[n], "--duration")) {
+      options.corpus.duration = romea::core::durationFromSecond(std::atof(value));
+    } else if (!std::strcmp(argv[n], "--gnss-rate")) {
+      options.corpus.gnssRate = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--speed")) {
+      options.corpus.linearSpeed = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--single-antenna")) {
+      options.corpus.emitsHDT = !std::atoi(value);
+    } else if (!std::strcmp(argv[n], "--dropout-rate")) {
+      options.corpus.rtkDropoutRate = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--multipath")) {
+      options.corpus.multipathProbability = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--hdop-spike")) {
+      options.corpus.hdopSpikeProbability = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--gsv-burst")) {
+      options.corpus.gsvBurstProbability = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--corrupt-checksum")) {
+      options.corpus.corruptChecksumProbability = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--truncation")) {
+      options.corpus.truncationProbability = std::atof(value);
+    } else if (!std::strcmp(argv[n], "--output")) {
+      options.output = value;
+    } else if (!std::strcmp(argv[n], "--truth")) {
+      options.truth = value;
+    } else {
+      std::cerr << "unknown option " << argv[n] << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  return options;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  Options options = parseOptions(argc, argv);
+
+  std::ofstream outputFile;
+  if (!options.output.empty()) {
+    outputFile.open(options.output);
+  }
+  std::ostream & output = options.output.empty() ? std::cout : outputFile;
+
+  std::ofstream truth;
+  if (!options.truth.empty()) {
+    truth.open(options.truth);
+    truth << "stamp,fault,x,y,course,linear_speed\n" << std::setprecision(12);
+  }
+
+  if (!output || (!options.truth.empty() && !truth)) {
+    std::cerr << "cannot open output files" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  romea::core::NMEACorpusGenerator generator(options.corpus);
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    size_t length = record.sentence.find_last_not_of("\r\n") + 1;
+    output << record.stamp.count() << ' ';
+    output.write(record.sentence.data(), length);
+    output << '\n';
+
+    if (truth.is_open()) {
+      truth << record.stamp.count() << ',' << toString(record.fault) << ',' <<
+        record.truth.position.x() << ',' << record.truth.position.y() << ',' <<
+        record.truth.course << ',' << record.truth.linearSpeed << '\n';
+    }
+  }
+
+  return output.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,338 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Stress harness reproducing the production threading model of a plugin:
+// an odometry thread feeding linear speeds, a serial thread feeding GGA and
+// RMC (or HDT) sentences and a diagnostics thread building reports, all at
+// configurable rates. It prints observation latency percentiles and the wait
+// and hold times of the plugin mutexes. Build with -DENABLE_THREAD_SANITIZER=ON
+// to run it under ThreadSanitizer. A rate of 0 runs the thread back to back,
+// which makes false sharing between threads show up as a throughput drop.
+//
+// usage: stress_plugin_contention [--duration seconds] [--antennas 1|2]
+//   [--odometry-rate hz] [--gnss-rate hz] [--diagnostics-rate hz] [--speedup factor]
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_gps/nmea/HDTFrame.hpp"
+#include "romea_core_gps/nmea/RMCFrame.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/LockProfiler.hpp"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+  double duration = 60.;
+  int antennas = 1;
+  double odometryRate = 10.;
+  double gnssRate = 1.;
+  double diagnosticsRate = 1.;
+  double speedup = 1.;
+};
+
+struct Latencies
+{
+  std::string name;
+  std::vector<double> samples;
+  size_t numberOfObservations = 0;
+};
+
+//-----------------------------------------------------------------------------
+Options parseOptions(int argc, char ** argv)
+{
+  Options options;
+  for (int n = 1; n + 1 < argc; n += 2) {
+    double value = std::atof(argv[n + 1]);
+    if (!std::strcmp(argv[n], "--duration")) {
+      options.duration = value;
+    } else if (!std::strcmp(argv[n], "--antennas")) {
+      options.antennas = static_cast<int>(value);
+    } else if (!std::strcmp(argv[n], "--odometry-rate")) {
+      options.odometryRate = value;
+    } else if (!std::strcmp(argv[n], "--gnss-rate")) {
+      options.gnssRate = value;
+    } else if (!std::strcmp(argv[n], "--diagnostics-rate")) {
+      options.diagnosticsRate = value;
+    } else if (!std::strcmp(argv[n], "--speedup")) {
+      options.speedup = value;
+    } else {
+      std::cerr << "unknown option " << argv[n] << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  return options;
+}
+
+//-----------------------------------------------------------------------------
+std::string ggaSentence()
+{
+  romea::core::GGAFrame frame;
+  frame.talkerId = romea::core::TalkerId::GN;
+  frame.longitude = romea::core::Longitude(0.03);
+  frame.latitude = romea::core::Latitude(0.7854);
+  frame.geoidHeight = 400.8;
+  frame.altitudeAboveGeoid = 53.3;
+  frame.horizontalDilutionOfPrecision = 1.2;
+  frame.numberSatellitesUsedToComputeFix = 12;
+  frame.fixQuality = romea::core::FixQuality::RTK_FIX;
+  return frame.toNMEA();
+}
+
+//-----------------------------------------------------------------------------
+std::string rmcSentence()
+{
+  romea::core::RMCFrame frame;
+  frame.talkerId = romea::core::TalkerId::GP;
+  frame.speedOverGroundInMeterPerSecond = 3.2;
+  frame.trackAngleTrue = 1.54;
+  frame.magneticDeviation = 0.0378;
+  return frame.toNMEA();
+}
+
+//-----------------------------------------------------------------------------
+std::string hdtSentence()
+{
+  romea::core::HDTFrame frame;
+  frame.talkerId = romea::core::TalkerId::GL;
+  frame.heading = 0.378;
+  return frame.toNMEA();
+}
+
+//-----------------------------------------------------------------------------
+// calls each step at the given rate of the simulated clock until stop,
+// or as fast as possible when rate is null
+void runPeriodically(
+  const double & rate,
+  const Options & options,
+  const std::atomic<bool> & stop,
+  const std::function<void()> & step)
+{
+  if (rate <= 0) {
+    while (!stop.load()) {
+      step();
+    }
+    return;
+  }
+
+  auto period = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double>(1 / (rate * options.speedup)));
+
+  auto next = Clock::now();
+  while (!stop.load()) {
+    step();
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Function>
+bool measure(Latencies & latencies, Function && function)
+{
+  auto start = Clock::now();
+  bool isObservationValid = function();
+  std::chrono::duration<double, std::micro> latency = Clock::now() - start;
+  latencies.samples.push_back(latency.count());
+  latencies.numberOfObservations += isObservationValid;
+  return isObservationValid;
+}
+
+//-----------------------------------------------------------------------------
+double percentile(const std::vector<double> & sortedSamples, const double & ratio)
+{
+  if (sortedSamples.empty()) {
+    return 0.;
+  }
+  size_t index = static_cast<size_t>(ratio * (sortedSamples.size() - 1) + 0.5);
+  return sortedSamples[index];
+}
+
+//-----------------------------------------------------------------------------
+void printLatencies(std::vector<Latencies> & latencies, const double & duration)
+{
+  std::cout << std::left << std::setw(24) << "operation" << std::right <<
+    std::setw(10) << "calls" << std::setw(12) << "calls/s" << std::setw(14) << "observations" <<
+    std::setw(11) << "p50 (us)" << std::setw(11) << "p90 (us)" <<
+    std::setw(11) << "p99 (us)" << std::setw(12) << "p99.9 (us)" <<
+    std::setw(11) << "max (us)" << std::endl;
+
+  std::cout << std::fixed << std::setprecision(2);
+  for (auto & operation : latencies) {
+    std::sort(operation.samples.begin(), operation.samples.end());
+    std::cout << std::left << std::setw(24) << operation.name << std::right <<
+      std::setw(10) << operation.samples.size() <<
+      std::setw(12) << operation.samples.size() / duration <<
+      std::setw(14) << operation.numberOfObservations <<
+      std::setw(11) << percentile(operation.samples, 0.5) <<
+      std::setw(11) << percentile(operation.samples, 0.9) <<
+      std::setw(11) << percentile(operation.samples, 0.99) <<
+      std::setw(12) << percentile(operation.samples, 0.999) <<
+      std::setw(11) << percentile(operation.samples, 1.) << std::endl;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void printLockProfiles()
+{
+  std::cout << std::left << std::setw(28) << "mutex" << std::right <<
+    std::setw(10) << "locks" << std::setw(13) << "contentions" <<
+    std::setw(16) << "mean wait (us)" << std::setw(15) << "max wait (us)" <<
+    std::setw(16) << "mean hold (us)" << std::setw(15) << "max hold (us)" << std::endl;
+
+  for (const auto & profile : romea::core::LockProfiler::getProfiles()) {
+    double locks = std::max<double>(profile.numberOfLocks, 1);
+    std::cout << std::left << std::setw(28) << profile.name << std::right <<
+      std::setw(10) << profile.numberOfLocks <<
+      std::setw(13) << profile.numberOfContentions <<
+      std::setw(16) << profile.totalWaitTime.count() / locks / 1000. <<
+      std::setw(15) << profile.maximalWaitTime.count() / 1000. <<
+      std::setw(16) << profile.totalHoldTime.count() / locks / 1000. <<
+      std::setw(15) << profile.maximalHoldTime.count() / 1000. << std::endl;
+  }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  Options options = parseOptions(argc, argv);
+  romea::core::LockProfiler::enable(true);
+
+  std::unique_ptr<romea::core::LocalisationSingleAntennaGPSPlugin> singleAntennaPlugin;
+  std::unique_ptr<romea::core::LocalisationDualAntennaGPSPlugin> dualAntennaPlugin;
+  romea::core::LocalisationGPSPluginBase * plugin = nullptr;
+  if (options.antennas == 1) {
+    singleAntennaPlugin = std::make_unique<romea::core::LocalisationSingleAntennaGPSPlugin>(
+      std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.);
+    plugin = singleAntennaPlugin.get();
+  } else {
+    dualAntennaPlugin = std::make_unique<romea::core::LocalisationDualAntennaGPSPlugin>(
+      std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+    plugin = dualAntennaPlugin.get();
+  }
+
+  const std::string gga = ggaSentence();
+  const std::string rmc = rmcSentence();
+  const std::string hdt = hdtSentence();
+
+  // stamps of the simulated clock run speedup times faster than the wall clock
+  const Clock::time_point start = Clock::now();
+  auto now = [&]() {
+      return std::chrono::duration_cast<romea::core::Duration>(
+        (Clock::now() - start) * options.speedup);
+    };
+
+  std::vector<Latencies> latencies(5);
+  latencies[0].name = "processLinearSpeed";
+  latencies[1].name = "processGGA";
+  latencies[2].name = options.antennas == 1 ? "processRMC" : "processHDT";
+  latencies[3].name = "makeDiagnosticReport";
+  latencies[4].name = "makeDiagnosticReportDelta";
+
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+
+  if (singleAntennaPlugin) {
+    threads.emplace_back(
+      [&]() {
+        runPeriodically(
+          options.odometryRate, options, stop, [&]() {
+            measure(
+              latencies[0], [&]() {
+                singleAntennaPlugin->processLinearSpeed(now(), 1.0);
+                return true;
+              });
+          });
+      });
+  }
+
+  threads.emplace_back(
+    [&]() {
+      romea::core::ObservationPosition position;
+      romea::core::ObservationCourse course;
+      runPeriodically(
+        options.gnssRate, options, stop, [&]() {
+          measure(latencies[1], [&]() {return plugin->processGGA(now(), gga, position);});
+          if (singleAntennaPlugin) {
+            measure(
+              latencies[2], [&]() {
+                return singleAntennaPlugin->processRMC(now(), rmc, course);
+              });
+          } else {
+            measure(
+              latencies[2], [&]() {
+                return dualAntennaPlugin->processHDT(now(), hdt, course);
+              });
+          }
+        });
+    });
+
+  threads.emplace_back(
+    [&]() {
+      uint64_t sequence = 0;
+      runPeriodically(
+        options.diagnosticsRate, options, stop, [&]() {
+          measure(
+            latencies[3], [&]() {
+              auto report = singleAntennaPlugin ?
+              singleAntennaPlugin->makeDiagnosticReport(now()) :
+              dualAntennaPlugin->makeDiagnosticReport(now());
+              return !report.diagnostics.empty();
+            });
+          measure(
+            latencies[4], [&]() {
+              auto delta = singleAntennaPlugin ?
+              singleAntennaPlugin->makeDiagnosticReportDelta(now(), sequence) :
+              dualAntennaPlugin->makeDiagnosticReportDelta(now(), sequence);
+              sequence = delta.sequence;
+              return true;
+            });
+        });
+    });
+
+  std::this_thread::sleep_for(std::chrono::duration<double>(options.duration));
+  stop = true;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  printLatencies(latencies, options.duration);
+  std::cout << std::endl;
+  printLockProfiles();
+
+  // fails when the plugin never produced observations under contention
+  return latencies[1].numberOfObservations != 0 &&
+         latencies[2].numberOfObservations != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
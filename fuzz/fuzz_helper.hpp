@@ -0,0 +1,40 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef FUZZ_HELPER_HPP_
+#define FUZZ_HELPER_HPP_
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+// Sentences are fed to long lived plugins with stamps moving forward, so that
+// rate checkups pass and inputs reach the fix and track angle checkups.
+inline romea::core::Duration nextFuzzStamp()
+{
+  static int64_t index = 0;
+  return romea::core::durationFromSecond(0.1 * index++);
+}
+
+inline std::string makeFuzzSentence(const uint8_t * data, const size_t & size)
+{
+  return std::string(reinterpret_cast<const char *>(data), size);
+}
+
+#endif  // FUZZ_HELPER_HPP_
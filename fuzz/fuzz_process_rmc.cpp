@@ -0,0 +1,44 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Feeds arbitrary bytes to processRMC of a single antenna plugin receiving
+// linear speeds and good GGA sentences, so that track angles are checked
+// against speed and position accuracy.
+
+// std
+#include <memory>
+#include <string>
+
+// romea
+#include "../test/helper.hpp"
+#include "fuzz_helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+
+//-----------------------------------------------------------------------------
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size)
+{
+  static romea::core::LocalisationSingleAntennaGPSPlugin plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.);
+  static const std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+
+  auto stamp = nextFuzzStamp();
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+  plugin.processGGA(stamp, ggaSentence, position);
+  plugin.processLinearSpeed(stamp, 1.);
+  plugin.processRMC(stamp, makeFuzzSentence(data, size), course);
+  plugin.makeDiagnosticReport(stamp);
+  return 0;
+}
@@ -0,0 +1,106 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Writes the seed corpora of the fuzz targets, one directory per entry point:
+// the hand built frames of the tests and a few sentences of a synthetic
+// corpus, receiver faults and serial line corruptions included.
+//
+// usage: make_fuzz_seeds directory
+
+// std
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// romea
+#include "../test/helper.hpp"
+#include "romea_core_localisation_gps/NMEACorpusGenerator.hpp"
+
+namespace
+{
+
+const size_t NUMBER_OF_GENERATED_SEEDS = 32;
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  if (argc != 2) {
+    std::cerr << "usage: make_fuzz_seeds directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::map<std::string, std::vector<std::string>> seeds;
+  seeds["gga"].push_back(minimalGoodGGAFrame().toNMEA());
+  seeds["gga"].push_back(romea::core::GGAFrame().toNMEA());
+  seeds["rmc"].push_back(minimalGoodRMCFrame().toNMEA());
+  seeds["rmc"].push_back(romea::core::RMCFrame().toNMEA());
+  seeds["hdt"].push_back(minimalGoodHDTFrame().toNMEA());
+  seeds["hdt"].push_back(romea::core::HDTFrame().toNMEA());
+  seeds["gsv"];
+  seeds["gst"].push_back("$GNGST,120000.00,1.8,0.03,0.01,90.0,0.011,0.029,0.05");
+  seeds["gst"].push_back("$GNGST,120000.00,1.8,,,,0.011,0.029,0.05");
+  seeds["gst"].push_back("$GNGST,,,,,,,,");
+
+  romea::core::NMEACorpusOptions options;
+  options.seed = 2;
+  options.gnssRate = 1.;
+  options.rtkDropoutRate = 0.05;
+  options.hdopSpikeProbability = 0.05;
+  options.gsvBurstProbability = 0.1;
+  options.corruptChecksumProbability = 0.1;
+  options.truncationProbability = 0.1;
+  romea::core::NMEACorpusGenerator generator(options);
+
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    std::string type = record.sentence.size() >= 6 ? record.sentence.substr(3, 3) : "";
+    for (auto & c : type) {
+      c = static_cast<char>(std::tolower(c));
+    }
+
+    // truncated sentences may have lost their type, they go to every target
+    for (auto & [entryPoint, sentences] : seeds) {
+      if ((type == entryPoint || record.fault == romea::core::NMEAFault::TRUNCATED) &&
+        sentences.size() < NUMBER_OF_GENERATED_SEEDS)
+      {
+        sentences.push_back(record.sentence);
+      }
+    }
+
+    bool isComplete = true;
+    for (const auto & [entryPoint, sentences] : seeds) {
+      isComplete &= sentences.size() >= NUMBER_OF_GENERATED_SEEDS;
+    }
+    if (isComplete) {
+      break;
+    }
+  }
+
+  for (const auto & [entryPoint, sentences] : seeds) {
+    std::filesystem::path directory = std::filesystem::path(argv[1]) / entryPoint;
+    std::filesystem::create_directories(directory);
+    for (size_t n = 0; n < sentences.size(); ++n) {
+      std::ofstream(directory / ("seed_" + std::to_string(n)), std::ios::binary) << sentences[n];
+    }
+  }
+  return EXIT_SUCCESS;
+}
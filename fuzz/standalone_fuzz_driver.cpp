@@ -0,0 +1,71 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Replays inputs through LLVMFuzzerTestOneInput when libFuzzer is not
+// available (gcc), so that fuzz targets still run their corpora as
+// regression tests. Arguments are files or directories of files, libFuzzer
+// options (starting with -) are ignored.
+
+// std
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size);
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+void runInput(const std::filesystem::path & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::vector<char> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  size_t numberOfInputs = 0;
+  for (int n = 1; n < argc; ++n) {
+    if (argv[n][0] == '-') {
+      continue;
+    }
+
+    std::filesystem::path path(argv[n]);
+    if (std::filesystem::is_directory(path)) {
+      for (const auto & entry : std::filesystem::directory_iterator(path)) {
+        runInput(entry.path());
+        numberOfInputs++;
+      }
+    } else if (std::filesystem::exists(path)) {
+      runInput(path);
+      numberOfInputs++;
+    } else {
+      std::cerr << "cannot find " << path << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "executed " << numberOfInputs << " inputs" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,36 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__CACHELINE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__CACHELINE_HPP_
+
+// std
+#include <cstddef>
+
+namespace romea
+{
+namespace core
+{
+
+// Cache line size of the x86-64 and ARMv8 (Cortex-A) targets. Members written
+// by different threads are aligned on it so that they never share a line.
+// std::hardware_destructive_interference_size is not used because its value
+// depends on compiler flags and would change the ABI of the plugins.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__CACHELINE_HPP_
@@ -17,14 +17,19 @@
 #define  ROMEA_CORE_LOCALISATION_GPS__CHECKUPGGAFIX_HPP_
 
 // std
-#include <list>
-#include <mutex>
-#include <string>
+#include <cstdint>
 
 // romea
 #include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
 #include "romea_core_gps/nmea/GGAFrame.hpp"
 
+// local
+#include "CompactDiagnosticReport.hpp"
+#include "DiagnosticHistory.hpp"
+#include "FixStatistics.hpp"
+#include "LockProfiler.hpp"
+
 
 namespace romea
 {
@@ -33,32 +38,115 @@ namespace core
 
 class CheckupGGAFix
 {
+public:
+  enum ReportInfo
+  {
+    TALKER = 0,
+    GEOID_HEIGHT,
+    ALTITUDE_ABOVE_GEOID,
+    FIX_QUALITY,
+    NUMBER_OF_SATELLITES,
+    HDOP,
+    CORRECTION_AGE,
+    BASE_STATION_ID,
+    LATITUDE,
+    LONGITUDE,
+    NUMBER_OF_REPORT_INFOS
+  };
+
+  enum ReportMessage : uint8_t
+  {
+    FIX_OK = 0,
+    FIX_INCOMPLETE,
+    HDOP_TOO_HIGH,
+    NOT_ENOUGH_SATELLITES,
+    FIX_QUALITY_TOO_LOW
+  };
+
+  using CompactReport = CompactDiagnosticReport<NUMBER_OF_REPORT_INFOS, 3>;
+
 public:
   explicit CheckupGGAFix(const FixQuality & minimalFixQuality);
 
-  DiagnosticStatus evaluate(const GGAFrame & ggaFrame);
+  DiagnosticStatus evaluate(
+    const GGAFrame & ggaFrame,
+    const Duration & stamp = Duration::zero());
+
+  // evaluates a frame taken from a snapshot to warm start the checkup, fix
+  // statistics are left untouched since the frame has already been counted
+  DiagnosticStatus replay(
+    const GGAFrame & ggaFrame,
+    const Duration & stamp);
+
+  // checks a frame without recording it, neither locks nor allocates
+  static DiagnosticStatus check(
+    const GGAFrame & ggaFrame,
+    const FixQuality & minimalFixQuality);
+
+  DiagnosticReport getReport()const;
 
-  const DiagnosticReport & getReport()const;
+  const DiagnosticHistory & getHistory()const;
+
+  // statistics are kept when the checkup is reset after a heart beat loss
+  FixStatistics getStatistics()const;
+
+  // last frame evaluated since construction or reset, false if none
+  bool getLastFrame(GGAFrame & ggaFrame, Duration & stamp)const;
 
   void reset();
 
+  void resetStatistics();
+
 private:
-  void declareReportInfos_();
-  void setReportInfos_(const GGAFrame & ggaFrame);
-  void addDiagnostic_(const DiagnosticStatus & status, const std::string & message);
+  DiagnosticStatus evaluate_(
+    const GGAFrame & ggaFrame,
+    const Duration & stamp,
+    const bool & updateStatistics);
 
-  bool checkFrameIsComplete_(const GGAFrame & ggaFrame);
-  void checkFixIsReliable_(const GGAFrame & ggaFrame);
-  bool checkFixQuality_(const GGAFrame & ggaFrame);
-  bool checkHorizontalDilutionOfPrecision_(const GGAFrame & ggaFrame);
-  bool checkNumberSatellitesUsedToComputeFix_(const GGAFrame & ggaFrame);
+  void setReportInfos_(const GGAFrame & ggaFrame);
+  void recordHistory_(
+    const Duration & stamp,
+    const DiagnosticStatus & status,
+    const GGAFrame & ggaFrame);
+
+  static void check_(
+    const GGAFrame & ggaFrame,
+    const FixQuality & minimalFixQuality,
+    CompactReport & report);
+
+  static bool checkFrameIsComplete_(
+    const GGAFrame & ggaFrame,
+    CompactReport & report);
+
+  static void checkFixIsReliable_(
+    const GGAFrame & ggaFrame,
+    const FixQuality & minimalFixQuality,
+    CompactReport & report);
+
+  static bool checkFixQuality_(
+    const GGAFrame & ggaFrame,
+    const FixQuality & minimalFixQuality,
+    CompactReport & report);
+
+  static bool checkHorizontalDilutionOfPrecision_(
+    const GGAFrame & ggaFrame,
+    CompactReport & report);
+
+  static bool checkNumberSatellitesUsedToComputeFix_(
+    const GGAFrame & ggaFrame,
+    CompactReport & report);
 
 private:
   FixQuality minimalFixQuality_;
   double maximalHorizontalDilutionOfPrecision_;
 
-  mutable std::mutex mutex_;
-  DiagnosticReport report_;
+  mutable ProfiledMutex mutex_;
+  CompactReport report_;
+  DiagnosticHistory history_;
+  FixStatistics statistics_;
+  bool hasLastFrame_;
+  GGAFrame lastFrame_;
+  Duration lastStamp_;
 };
 
 }  // namespace core
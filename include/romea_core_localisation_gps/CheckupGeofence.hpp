@@ -0,0 +1,62 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__CHECKUPGEOFENCE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__CHECKUPGEOFENCE_HPP_
+
+// std
+#include <memory>
+#include <optional>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+
+// local
+#include "Geofence.hpp"
+#include "LockProfiler.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Locates published positions with respect to the zones of a geofence:
+// OK inside field boundaries, WARN outside of them and ERROR inside an
+// exclusion zone. The nearest zone is reported along with its distance.
+class CheckupGeofence
+{
+public:
+  explicit CheckupGeofence(std::shared_ptr<const Geofence> geofence);
+
+  DiagnosticStatus evaluate(const Eigen::Vector2d & position);
+
+  DiagnosticReport getReport()const;
+
+  void reset();
+
+private:
+  static DiagnosticStatus toDiagnosticStatus_(const GeofenceStatus & status);
+
+private:
+  std::shared_ptr<const Geofence> geofence_;
+
+  mutable ProfiledMutex mutex_;
+  std::optional<GeofenceStatus> lastStatus_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__CHECKUPGEOFENCE_HPP_
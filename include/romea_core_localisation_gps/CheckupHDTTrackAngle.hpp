@@ -18,13 +18,18 @@
 
 
 // std
-#include <mutex>
-#include <string>
+#include <cstdint>
 
 // romea
 #include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
 #include "romea_core_gps/nmea/HDTFrame.hpp"
 
+// local
+#include "CompactDiagnosticReport.hpp"
+#include "DiagnosticHistory.hpp"
+#include "LockProfiler.hpp"
+
 
 namespace romea
 {
@@ -33,25 +38,49 @@ namespace core
 
 class CheckupHDTTrackAngle
 {
+public:
+  enum ReportInfo
+  {
+    TALKER = 0,
+    TRACK_ANGLE,
+    NUMBER_OF_REPORT_INFOS
+  };
+
+  enum ReportMessage : uint8_t
+  {
+    TRACK_ANGLE_OK = 0,
+    TRACK_ANGLE_INCOMPLETE
+  };
+
+  using CompactReport = CompactDiagnosticReport<NUMBER_OF_REPORT_INFOS, 1>;
+
 public:
   CheckupHDTTrackAngle();
 
-  DiagnosticStatus evaluate(const HDTFrame & hdtFrame);
+  DiagnosticStatus evaluate(
+    const HDTFrame & hdtFrame,
+    const Duration & stamp = Duration::zero());
+
+  // checks a frame without recording it, neither locks nor allocates
+  static DiagnosticStatus check(const HDTFrame & hdtFrame);
+
+  DiagnosticReport getReport()const;
 
-  const DiagnosticReport & getReport()const;
+  const DiagnosticHistory & getHistory()const;
 
   void reset();
 
 private:
-  bool checkFrameIsComplete_(const HDTFrame & rmcFrame);
+  static bool checkFrameIsComplete_(
+    const HDTFrame & hdtFrame,
+    CompactReport & report);
 
-  void declareReportInfos_();
   void setReportInfos_(const HDTFrame & rmcFrame);
-  void setDiagnostic_(const DiagnosticStatus & status, const std::string & message);
 
 private:
-  mutable std::mutex mutex_;
-  DiagnosticReport report_;
+  mutable ProfiledMutex mutex_;
+  CompactReport report_;
+  DiagnosticHistory history_;
 };
 
 }  // namespace core
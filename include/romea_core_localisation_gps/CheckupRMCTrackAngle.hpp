@@ -17,13 +17,18 @@
 #define ROMEA_CORE_LOCALISATION_GPS__CHECKUPRMCTRACKANGLE_HPP_
 
 // std
-#include <mutex>
-#include <string>
+#include <cstdint>
 
 // romea
 #include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
 #include "romea_core_gps/nmea/RMCFrame.hpp"
 
+// local
+#include "CompactDiagnosticReport.hpp"
+#include "DiagnosticHistory.hpp"
+#include "LockProfiler.hpp"
+
 namespace romea
 {
 namespace core
@@ -31,28 +36,66 @@ namespace core
 
 class CheckupRMCTrackAngle
 {
+public:
+  enum ReportInfo
+  {
+    TALKER = 0,
+    SPEED_OVER_GROUND,
+    TRACK_ANGLE,
+    MAGNETIC_DEVIATION,
+    NUMBER_OF_REPORT_INFOS
+  };
+
+  enum ReportMessage : uint8_t
+  {
+    TRACK_ANGLE_OK = 0,
+    TRACK_ANGLE_INCOMPLETE,
+    TRACK_ANGLE_NOT_RELIABLE
+  };
+
+  using CompactReport = CompactDiagnosticReport<NUMBER_OF_REPORT_INFOS, 1>;
+
 public:
   explicit CheckupRMCTrackAngle(const double & minimalSpeedOverGround);
 
-  DiagnosticStatus evaluate(const RMCFrame & rmcFrame);
+  DiagnosticStatus evaluate(
+    const RMCFrame & rmcFrame,
+    const Duration & stamp = Duration::zero());
+
+  // checks a frame without recording it, neither locks nor allocates
+  static DiagnosticStatus check(
+    const RMCFrame & rmcFrame,
+    const double & minimalSpeedOverGround);
 
-  const DiagnosticReport & getReport()const;
+  DiagnosticReport getReport()const;
+
+  const DiagnosticHistory & getHistory()const;
 
   void reset();
 
 private:
-  bool checkFrameIsComplete_(const RMCFrame & rmcFrame);
-  void checkFixIsReliable_(const RMCFrame & rmcFrame);
+  static void check_(
+    const RMCFrame & rmcFrame,
+    const double & minimalSpeedOverGround,
+    CompactReport & report);
+
+  static bool checkFrameIsComplete_(
+    const RMCFrame & rmcFrame,
+    CompactReport & report);
+
+  static void checkFixIsReliable_(
+    const RMCFrame & rmcFrame,
+    const double & minimalSpeedOverGround,
+    CompactReport & report);
 
-  void declareReportInfos_();
   void setReportInfos_(const RMCFrame & rmcFrame);
-  void setDiagnostic_(const DiagnosticStatus & status, const std::string & message);
 
 private:
   double minimalSpeedOverGround_;
 
-  mutable std::mutex mutex_;
-  DiagnosticReport report_;
+  mutable ProfiledMutex mutex_;
+  CompactReport report_;
+  DiagnosticHistory history_;
 };
 
 }  // namespace core
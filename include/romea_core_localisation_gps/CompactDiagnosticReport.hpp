@@ -0,0 +1,167 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__COMPACTDIAGNOSTICREPORT_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__COMPACTDIAGNOSTICREPORT_HPP_
+
+// std
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+template<typename T>
+struct OptionalValueType
+{
+  using type = T;
+};
+
+template<typename T>
+struct OptionalValueType<std::optional<T>>
+{
+  using type = T;
+};
+
+// Report of a checkup with a fixed set of infos and diagnostics. Infos are
+// indexed by an enum of the checkup and stored as doubles (NaN when empty),
+// diagnostic messages are indexes in a static message table of the checkup.
+// Nothing is allocated, the generic DiagnosticReport is only built on demand.
+template<size_t NumberOfInfos, size_t MaximalNumberOfDiagnostics>
+class CompactDiagnosticReport
+{
+public:
+  struct CompactDiagnostic
+  {
+    DiagnosticStatus status;
+    uint8_t message;
+  };
+
+public:
+  CompactDiagnosticReport()
+  : infos_(),
+    diagnostics_(),
+    numberOfDiagnostics_(0)
+  {
+    clearInfos();
+  }
+
+  void clearInfos()
+  {
+    infos_.fill(std::numeric_limits<double>::quiet_NaN());
+  }
+
+  template<typename T>
+  void setInfo(const size_t & index, const T & value)
+  {
+    if constexpr (std::is_enum_v<T>) {
+      infos_[index] = static_cast<double>(static_cast<std::underlying_type_t<T>>(value));
+    } else {
+      infos_[index] = static_cast<double>(value);
+    }
+  }
+
+  template<typename T>
+  void setInfo(const size_t & index, const std::optional<T> & value)
+  {
+    if (value) {
+      setInfo(index, *value);
+    } else {
+      infos_[index] = std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+
+  template<typename T>
+  std::optional<typename OptionalValueType<T>::type> getInfo(const size_t & index) const
+  {
+    using ValueType = typename OptionalValueType<T>::type;
+    if (std::isnan(infos_[index])) {
+      return std::nullopt;
+    } else if constexpr (std::is_enum_v<ValueType>) {
+      using UnderlyingType = std::underlying_type_t<ValueType>;
+      return static_cast<ValueType>(static_cast<UnderlyingType>(infos_[index]));
+    } else {
+      return static_cast<ValueType>(infos_[index]);
+    }
+  }
+
+  const double & getRawInfo(const size_t & index) const
+  {
+    return infos_[index];
+  }
+
+  void clearDiagnostics()
+  {
+    numberOfDiagnostics_ = 0;
+  }
+
+  void addDiagnostic(const DiagnosticStatus & status, const uint8_t & message)
+  {
+    if (numberOfDiagnostics_ < MaximalNumberOfDiagnostics) {
+      diagnostics_[numberOfDiagnostics_++] = {status, message};
+    }
+  }
+
+  void setDiagnostic(const DiagnosticStatus & status, const uint8_t & message)
+  {
+    clearDiagnostics();
+    addDiagnostic(status, message);
+  }
+
+  bool hasDiagnostics() const
+  {
+    return numberOfDiagnostics_ != 0;
+  }
+
+  DiagnosticStatus worseStatus() const
+  {
+    DiagnosticStatus status = DiagnosticStatus::OK;
+    for (size_t n = 0; n < numberOfDiagnostics_; ++n) {
+      if (static_cast<int>(diagnostics_[n].status) > static_cast<int>(status)) {
+        status = diagnostics_[n].status;
+      }
+    }
+    return status;
+  }
+
+  const CompactDiagnostic * beginDiagnostics() const
+  {
+    return diagnostics_.data();
+  }
+
+  const CompactDiagnostic * endDiagnostics() const
+  {
+    return diagnostics_.data() + numberOfDiagnostics_;
+  }
+
+private:
+  std::array<double, NumberOfInfos> infos_;
+  std::array<CompactDiagnostic, MaximalNumberOfDiagnostics> diagnostics_;
+  uint8_t numberOfDiagnostics_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__COMPACTDIAGNOSTICREPORT_HPP_
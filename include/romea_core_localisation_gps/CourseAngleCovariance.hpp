@@ -0,0 +1,43 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__COURSEANGLECOVARIANCE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__COURSEANGLECOVARIANCE_HPP_
+
+namespace romea
+{
+namespace core
+{
+
+// Course angle std used when no better information is available
+double defaultCourseAngleStd();
+
+// Course angle std of a track angle deduced from the displacement of the antenna
+// during one RMC period, each fix being affected by a noise of positionStd meters
+double rmcCourseAngleStd(
+  const double & speedOverGround,
+  const double & positionStd,
+  const double & rmcPeriod);
+
+// Course angle std of a heading deduced from the relative position of
+// two antennas separated by antennaBaseline meters
+double hdtCourseAngleStd(
+  const double & antennaBaseline,
+  const double & relativePositionStd);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__COURSEANGLECOVARIANCE_HPP_
@@ -0,0 +1,99 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__DIAGNOSTICHISTORY_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__DIAGNOSTICHISTORY_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+
+namespace romea
+{
+namespace core
+{
+
+struct DiagnosticRecord
+{
+  static constexpr size_t NUMBER_OF_VALUES = 3;
+
+  Duration stamp;
+  DiagnosticStatus status;
+  std::array<double, NUMBER_OF_VALUES> values;
+};
+
+// Fixed capacity ring of the last evaluations of a checkup.
+// Records are written by a single thread without lock nor allocation,
+// they can be read at any time from other threads.
+class DiagnosticHistory
+{
+public:
+  using ValueNames = std::array<std::string, DiagnosticRecord::NUMBER_OF_VALUES>;
+
+  static constexpr size_t DEFAULT_CAPACITY = 64;
+
+  DiagnosticHistory(
+    const std::string & name,
+    const ValueNames & valueNames,
+    const size_t & capacity = DEFAULT_CAPACITY);
+
+  void record(
+    const Duration & stamp,
+    const DiagnosticStatus & status,
+    const double & value0 = std::numeric_limits<double>::quiet_NaN(),
+    const double & value1 = std::numeric_limits<double>::quiet_NaN(),
+    const double & value2 = std::numeric_limits<double>::quiet_NaN());
+
+  std::vector<DiagnosticRecord> getRecords() const;
+
+  void dump(std::ostream & os) const;
+
+  const std::string & getName() const;
+
+  size_t capacity() const;
+
+private:
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence;
+    std::atomic<Duration::rep> stamp;
+    std::atomic<DiagnosticStatus> status;
+    std::array<std::atomic<double>, DiagnosticRecord::NUMBER_OF_VALUES> values;
+  };
+
+private:
+  std::string name_;
+  ValueNames valueNames_;
+
+  size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> numberOfRecords_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__DIAGNOSTICHISTORY_HPP_
@@ -0,0 +1,120 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__DIAGNOSTICREPORTDELTA_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__DIAGNOSTICREPORTDELTA_HPP_
+
+// std
+#include <cstdint>
+#include <list>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Changes of a diagnostic report between baseSequence and sequence of the
+// journal identified by journalId, a delta with a base sequence equal to
+// zero holds the full report
+struct DiagnosticReportDelta
+{
+  uint64_t journalId;
+  uint64_t baseSequence;
+  uint64_t sequence;
+  std::map<std::string, std::string> changedInfos;
+  std::vector<std::string> removedInfos;
+  std::optional<std::list<Diagnostic>> diagnostics;
+};
+
+bool isFull(const DiagnosticReportDelta & delta);
+
+std::vector<uint8_t> encode(const DiagnosticReportDelta & delta);
+
+DiagnosticReportDelta decodeDiagnosticReportDelta(const std::vector<uint8_t> & buffer);
+
+
+// Sender side: keeps the sequence at which each part of the report last changed.
+// Each journal draws a random non null id at construction, so that receivers
+// detect a restarted sender whatever its sequence.
+class DiagnosticReportJournal
+{
+public:
+  DiagnosticReportJournal();
+
+  const uint64_t & getId() const;
+
+  uint64_t update(const DiagnosticReport & report);
+
+  // the delta holds the full report when the since sequence is zero or
+  // ahead of the journal (receiver of a restarted sender)
+  DiagnosticReportDelta makeDelta(const uint64_t & sinceSequence) const;
+
+  const uint64_t & getSequence() const;
+
+private:
+  struct InfoEntry
+  {
+    std::string value;
+    uint64_t sequence;
+    bool removed;
+  };
+
+private:
+  uint64_t id_;
+  uint64_t sequence_;
+  std::map<std::string, InfoEntry> infos_;
+  std::list<Diagnostic> diagnostics_;
+  uint64_t diagnosticsSequence_;
+};
+
+
+// Receiver side: rebuilds the full report from successive deltas
+class DiagnosticReportDecoder
+{
+public:
+  DiagnosticReportDecoder();
+
+  // returns false if the delta cannot be applied because previous changes
+  // are missing or because it comes from another journal or its sequence
+  // went backward (the decoder is then reset), a full report must then be
+  // requested (since sequence 0)
+  bool apply(const DiagnosticReportDelta & delta);
+
+  bool apply(const std::vector<uint8_t> & buffer);
+
+  const DiagnosticReport & getReport() const;
+
+  const uint64_t & getSequence() const;
+
+private:
+  void reset_();
+
+private:
+  uint64_t journalId_;
+  uint64_t sequence_;
+  DiagnosticReport report_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__DIAGNOSTICREPORTDELTA_HPP_
@@ -0,0 +1,113 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__FIXSTATISTICS_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__FIXSTATISTICS_HPP_
+
+// std
+#include <array>
+#include <cstdint>
+#include <optional>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+
+// local
+#include "StreamingStatistics.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Availability statistics of GGA fixes since construction or last reset,
+// updated in constant time and memory per frame:
+// - mean, standard deviation, extrema and moving averages of HDOP and of
+//   the number of satellites
+// - time spent in each fix quality, the time elapsed between two frames is
+//   credited to the fix quality of the first one up to the maximal frame gap
+// - fix loss episodes, a fix is lost while the checkup status is not OK or
+//   when no frame has been received during the maximal frame gap
+class FixStatistics
+{
+public:
+  static constexpr size_t NUMBER_OF_FIX_QUALITIES =
+    static_cast<size_t>(FixQuality::SIMULATION_FIX) + 1;
+
+  explicit FixStatistics(
+    const Duration & averagingTimeConstant = durationFromSecond(60.),
+    const Duration & maximalFrameGap = durationFromSecond(5.));
+
+  void update(
+    const Duration & stamp,
+    const GGAFrame & ggaFrame,
+    const DiagnosticStatus & status);
+
+  void reset();
+
+  const RunningStatistics & getHDOPStatistics() const;
+  const RunningStatistics & getNumberOfSatellitesStatistics() const;
+  double getHDOPMovingAverage() const;
+  double getNumberOfSatellitesMovingAverage() const;
+
+  Duration getObservedTime() const;
+  Duration getTimeIn(const FixQuality & fixQuality) const;
+  // frames without fix quality and gaps between frames
+  Duration getTimeWithoutFix() const;
+  // ratio of the observed time spent in the given fix quality
+  double getAvailability(const FixQuality & fixQuality) const;
+
+  uint64_t getNumberOfFixLosses() const;
+  bool isFixLost() const;
+  // including the ongoing episode
+  Duration getTotalFixLossDuration() const;
+  Duration getMaximalFixLossDuration() const;
+
+  void appendReportInfos(DiagnosticReport & report) const;
+
+private:
+  void accumulateTime_(const Duration & stamp);
+  void startFixLoss_(const Duration & stamp);
+  void endFixLoss_(const Duration & stamp);
+  Duration getOngoingFixLossDuration_() const;
+
+private:
+  Duration averagingTimeConstant_;
+  Duration maximalFrameGap_;
+
+  RunningStatistics hdopStatistics_;
+  RunningStatistics numberOfSatellitesStatistics_;
+  ExponentialMovingAverage hdopMovingAverage_;
+  ExponentialMovingAverage numberOfSatellitesMovingAverage_;
+
+  std::optional<Duration> lastStamp_;
+  std::optional<FixQuality> lastFixQuality_;
+  Duration observedTime_;
+  std::array<Duration, NUMBER_OF_FIX_QUALITIES> timeInFixQuality_;
+  Duration timeWithoutFix_;
+
+  uint64_t numberOfFixLosses_;
+  bool isFixLost_;
+  Duration fixLossStamp_;
+  Duration totalFixLossDuration_;
+  Duration maximalFixLossDuration_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__FIXSTATISTICS_HPP_
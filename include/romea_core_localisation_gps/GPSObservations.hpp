@@ -0,0 +1,60 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__GPSOBSERVATIONS_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__GPSOBSERVATIONS_HPP_
+
+// romea
+#include "romea_core_common/geodesy/ENUConverter.hpp"
+#include "romea_core_gps/GPSReceiver.hpp"
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_gps/nmea/HDTFrame.hpp"
+#include "romea_core_gps/nmea/RMCFrame.hpp"
+#include "romea_core_localisation/ObservationCourse.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Observations are built from frames which have been checked beforehand,
+// these functions neither lock nor allocate
+
+double computeFixStd(const GGAFrame & ggaFrame, const GPSReceiver & gps);
+
+// Returns the fix std used to compute the position covariance
+double makePositionObservation(
+  const GGAFrame & ggaFrame,
+  const ENUConverter & enuConverter,
+  const GPSReceiver & gps,
+  ObservationPosition & positionObs);
+
+void makeRMCCourseObservation(
+  const RMCFrame & rmcFrame,
+  const double & linearSpeed,
+  const double & positionStd,
+  const double & rmcPeriod,
+  ObservationCourse & courseObs);
+
+void makeHDTCourseObservation(
+  const HDTFrame & hdtFrame,
+  const double & courseAngleStd,
+  ObservationCourse & courseObs);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__GPSOBSERVATIONS_HPP_
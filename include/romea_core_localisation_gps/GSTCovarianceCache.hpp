@@ -0,0 +1,67 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__GSTCOVARIANCECACHE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__GSTCOVARIANCECACHE_HPP_
+
+// eigen
+#include <Eigen/Core>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+// local
+#include "GSTFrame.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Keeps the ENU position covariance given by the last GST frame. It is
+// built from the error ellipse when the receiver provides one, otherwise
+// from latitude and longitude stds (without correlation). Receivers send
+// GST after GGA in an epoch, so a fix is usually given the covariance of
+// the previous epoch, hence the maximal age which should be about the GGA
+// period. As observation helpers, it neither locks nor allocates and it
+// must be updated by the thread feeding GGA sentences.
+class GSTCovarianceCache
+{
+public:
+  explicit GSTCovarianceCache(const Duration & maximalAge = durationFromSecond(1.));
+
+  void setMaximalAge(const Duration & maximalAge);
+
+  // returns false and forgets the cached covariance when the frame holds
+  // neither a usable error ellipse nor usable latitude and longitude stds
+  bool update(const Duration & stamp, const GSTFrame & gstFrame);
+
+  // null when there is no cached covariance or when it is more than the
+  // maximal age apart from the given stamp
+  const Eigen::Matrix2d * find(const Duration & stamp) const;
+
+  void reset();
+
+private:
+  Duration maximalAge_;
+  Duration stamp_;
+  Eigen::Matrix2d covariance_;
+  bool isAvailable_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__GSTCOVARIANCECACHE_HPP_
@@ -0,0 +1,48 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__GSTFRAME_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__GSTFRAME_HPP_
+
+// std
+#include <optional>
+
+// romea
+#include "romea_core_gps/nmea/TalkerId.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Pseudorange error statistics of a fix, stds are in meters and the
+// orientation of the error ellipse semi-major axis is in radians, clockwise
+// from true north like HDT headings
+struct GSTFrame
+{
+  TalkerId talkerId = TalkerId::UNSUPPORTED;
+  std::optional<double> rangeRMS;
+  std::optional<double> semiMajorAxisStd;
+  std::optional<double> semiMinorAxisStd;
+  std::optional<double> semiMajorAxisOrientation;
+  std::optional<double> latitudeStd;
+  std::optional<double> longitudeStd;
+  std::optional<double> altitudeStd;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__GSTFRAME_HPP_
@@ -0,0 +1,99 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__GSVCYCLECACHE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__GSVCYCLECACHE_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// local
+#include "CacheLine.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Keeps the last complete GSV cycle of each talker (GP, GL, GA, GB...) in
+// preallocated slots, so that satellite views can be replayed to warm start
+// a plugin. Sentences of a cycle are written into the buffer of the talker
+// which is not published and the buffers are swapped once the last sentence
+// of the cycle has been received; incomplete or out of order cycles are
+// dropped and the previous cycle is kept. Buffers are seqlocks made of
+// atomic words: the thread feeding GSV sentences neither locks nor
+// allocates, sentences can be read at any time from other threads.
+class GSVCycleCache
+{
+public:
+  static constexpr size_t MAXIMAL_NUMBER_OF_TALKERS = 8;
+  static constexpr size_t MAXIMAL_NUMBER_OF_SENTENCES = 9;
+  static constexpr size_t MAXIMAL_SENTENCE_LENGTH = 96;
+
+  GSVCycleCache();
+
+  GSVCycleCache(const GSVCycleCache &) = delete;
+  GSVCycleCache & operator=(const GSVCycleCache &) = delete;
+
+  // returns false when the sentence is dropped: not a GSV sentence, too
+  // long, out of its cycle or no talker slot left
+  bool update(const std::string & gsvSentence);
+
+  // sentences of the last complete cycles, ordered by talker then by
+  // sentence number
+  std::vector<std::string> getSentences() const;
+
+private:
+  static constexpr size_t NUMBER_OF_WORDS = MAXIMAL_SENTENCE_LENGTH / sizeof(uint64_t);
+  static constexpr uint8_t NO_BUFFER = 2;
+
+  struct Buffer
+  {
+    // odd while the buffer is written
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint8_t> numberOfSentences;
+    std::array<std::atomic<uint8_t>, MAXIMAL_NUMBER_OF_SENTENCES> lengths;
+    std::array<std::array<std::atomic<uint64_t>, NUMBER_OF_WORDS>,
+      MAXIMAL_NUMBER_OF_SENTENCES> words;
+  };
+
+  struct alignas(CACHE_LINE_SIZE) Slot
+  {
+    std::atomic<uint8_t> publishedBuffer;
+    std::array<Buffer, 2> buffers;
+
+    // only used by the writer
+    uint16_t talker;
+    uint8_t writtenBuffer;
+    uint8_t numberOfExpectedSentences;
+    uint8_t numberOfWrittenSentences;
+  };
+
+  Slot * findSlot_(const uint16_t & talker);
+  bool readBuffer_(const Slot & slot, std::vector<std::string> & sentences) const;
+
+private:
+  std::array<Slot, MAXIMAL_NUMBER_OF_TALKERS> slots_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__GSVCYCLECACHE_HPP_
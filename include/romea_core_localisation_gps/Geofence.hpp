@@ -0,0 +1,122 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__GEOFENCE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__GEOFENCE_HPP_
+
+// std
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// eigen
+#include <Eigen/Core>
+
+namespace romea
+{
+namespace core
+{
+
+struct GeofenceZone
+{
+  enum class Type
+  {
+    FIELD_BOUNDARY = 0,
+    EXCLUSION_ZONE
+  };
+
+  std::string name;
+  Type type;
+  // vertices in the ENU frame of the plugin anchor, the polygon is closed
+  // implicitly between the last and the first vertex
+  std::vector<Eigen::Vector2d> polygon;
+};
+
+struct GeofenceStatus
+{
+  // true when there is no field boundary
+  bool isInsideFieldBoundary;
+  std::optional<size_t> exclusionZone;
+  // zone whose boundary is the nearest one and distance to this boundary
+  std::optional<size_t> nearestZone;
+  double nearestZoneDistance;
+};
+
+// Field boundaries and exclusion zones indexed by a uniform grid built once
+// at construction. Each cell stores, for every zone whose bounding box
+// overlaps it, the edges of the zone crossing the cell and whether the cell
+// center lies inside the zone, so that a point is located by only testing
+// the segment between the point and its cell center against these edges.
+// The nearest boundary is searched ring by ring around the cell of the
+// point until no unvisited cell can be closer. Zones are expressed in the
+// ENU frame of an anchor and a geofence has to be built again when it
+// changes. Queries are const and can be made from any thread.
+class Geofence
+{
+public:
+  // cells are sized from the number of edges when cell size is null
+  explicit Geofence(std::vector<GeofenceZone> zones, const double & cellSize = 0);
+
+  GeofenceStatus locate(const Eigen::Vector2d & position) const;
+
+  const std::vector<GeofenceZone> & getZones() const;
+
+  const double & getCellSize() const;
+
+private:
+  struct Edge
+  {
+    Eigen::Vector2d begin;
+    Eigen::Vector2d end;
+  };
+
+  struct CellZone
+  {
+    uint32_t zone;
+    bool isCenterInside;
+    std::vector<Edge> edges;
+  };
+
+  using Cell = std::vector<CellZone>;
+
+  void build_();
+  bool isInside_(
+    const CellZone & cellZone,
+    const Eigen::Vector2d & position,
+    const Eigen::Vector2d & center) const;
+  double distanceToRing_(
+    const Eigen::Vector2d & position,
+    const int64_t & column,
+    const int64_t & row,
+    const int64_t & ring) const;
+  Eigen::Vector2d cellCenter_(const int64_t & column, const int64_t & row) const;
+  const Cell & cell_(const int64_t & column, const int64_t & row) const;
+
+private:
+  std::vector<GeofenceZone> zones_;
+  double cellSize_;
+
+  Eigen::Vector2d origin_;
+  int64_t numberOfColumns_;
+  int64_t numberOfRows_;
+  std::vector<Cell> cells_;
+  bool hasFieldBoundary_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__GEOFENCE_HPP_
@@ -0,0 +1,117 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__HDTCOURSESTREAM_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__HDTCOURSESTREAM_HPP_
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_gps/GPSReceiver.hpp"
+#include "romea_core_gps/nmea/HDTFrame.hpp"
+#include "romea_core_localisation/ObservationCourse.hpp"
+
+// local
+#include "CacheLine.hpp"
+#include "CheckupHDTTrackAngle.hpp"
+#include "PluginSnapshot.hpp"
+#include "StatusTransitionNotifier.hpp"
+#include "StreamRateDiagnostic.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Course stream of dual antenna receivers: HDT headings are directly turned
+// into course observations. Between HDT sentences, course observations can
+// be predicted at the yaw rate input rate by integrating the yaw rate from
+// the last valid HDT course, their variance growing with the yaw rate bias
+// over the elapsed time, until the next valid HDT course replaces the
+// prediction origin. The origin is shared with the thread feeding yaw rates
+// through a sequence lock so that predictions neither lock nor allocate.
+class HDTCourseStream
+{
+public:
+  // distance between antennas, the default one of the receiver when NaN
+  using Parameters = double;
+
+  static constexpr double HDT_RATE = 1.0;
+  static constexpr double YAW_RATE_BIAS_STD = 0.01;
+  static constexpr double MAXIMAL_PREDICTION_DURATION = 2.0 / HDT_RATE;
+
+  HDTCourseStream(const GPSReceiver & gps, const Parameters & antennaBaseline);
+
+  static Parameters defaultParameters();
+
+  bool processHDT(
+    const Duration & stamp,
+    const HDTFrame & hdtFrame,
+    StatusTransitionNotifier & notifier,
+    ObservationCourse & courseObs);
+
+  // returns false while no recent valid HDT course can be predicted or when
+  // the yaw rate is not finite (the prediction is then left untouched)
+  bool processYawRate(
+    const Duration & stamp,
+    const double & yawRate,
+    ObservationCourse & courseObs);
+
+  void checkHeartBeats(const Duration & stamp, StatusTransitionNotifier & notifier);
+
+  // odometry diagnostics are reported before the GNSS ones
+  void appendOdometryReport(DiagnosticReport & report) const;
+  void appendReport(DiagnosticReport & report) const;
+
+  void dumpOdometryHistory(std::ostream & os) const;
+  void dumpHistory(std::ostream & os) const;
+
+  void saveSnapshot(PluginSnapshot & snapshot) const;
+  void restoreSnapshot(
+    const PluginSnapshot & snapshot,
+    const Duration & shift,
+    StatusTransitionNotifier & notifier);
+
+private:
+  // only written at construction
+  double courseAngleStd_;
+
+  // written by the serial thread feeding HDT sentences
+  alignas(CACHE_LINE_SIZE) StreamRateDiagnostic hdtRateDiagnostic_;
+  CheckupHDTTrackAngle hdtTrackAngleDiagnostic_;
+
+  // last valid HDT course, odd sequence while being written
+  std::atomic<uint64_t> originSequence_;
+  std::atomic<Duration::rep> originStamp_;
+  std::atomic<double> originCourse_;
+  std::atomic<double> originVariance_;
+
+  // written by the thread feeding yaw rates
+  alignas(CACHE_LINE_SIZE) uint64_t predictionSequence_;
+  Duration predictionStamp_;
+  Duration predictionOriginStamp_;
+  double predictedCourse_;
+  double predictionOriginVariance_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__HDTCOURSESTREAM_HPP_
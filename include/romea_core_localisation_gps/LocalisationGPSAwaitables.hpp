@@ -0,0 +1,126 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSAWAITABLES_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSAWAITABLES_HPP_
+
+// This header only layer is meant for C++20 nodes, the library and its
+// synchronous API remain C++17.
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "LocalisationGPSAwaitables.hpp requires C++20 coroutines"
+#endif
+
+// std
+#include <coroutine>
+#include <utility>
+
+// local
+#include "LocalisationGPSPlugin.hpp"
+#include "ObservationWaitList.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+template<typename Observation>
+struct StampedObservation
+{
+  Duration stamp;
+  Observation observation;
+};
+
+// Awaits the next valid observation of a plugin without any callback nor
+// condition variable: the awaiting coroutine is resumed by the thread feeding
+// the plugin, from within the process function which produced the
+// observation, so it must neither feed the plugin nor block. Destroying a
+// suspended coroutine cancels its wait, which must not race with the feeding
+// thread resuming it.
+template<typename Observation>
+class NextObservationAwaitable
+{
+public:
+  explicit NextObservationAwaitable(ObservationWaitList<Observation> & waitList)
+  : waitList_(waitList),
+    waiter_(),
+    handle_(),
+    isWaiting_(false)
+  {
+  }
+
+  NextObservationAwaitable(const NextObservationAwaitable &) = delete;
+  NextObservationAwaitable & operator=(const NextObservationAwaitable &) = delete;
+
+  ~NextObservationAwaitable()
+  {
+    if (isWaiting_) {
+      waitList_.remove(waiter_);
+    }
+  }
+
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle)
+  {
+    handle_ = handle;
+    waiter_.resume = &resume_;
+    waiter_.context = this;
+    isWaiting_ = true;
+    // the coroutine may be resumed by the feeding thread as soon as the
+    // waiter is registered, nothing can be touched afterwards
+    waitList_.push(waiter_);
+  }
+
+  StampedObservation<Observation> await_resume()
+  {
+    return {waiter_.stamp, std::move(waiter_.observation)};
+  }
+
+private:
+  static void resume_(typename ObservationWaitList<Observation>::Waiter & waiter)
+  {
+    auto * awaitable = static_cast<NextObservationAwaitable *>(waiter.context);
+    awaitable->isWaiting_ = false;
+    awaitable->handle_.resume();
+  }
+
+private:
+  ObservationWaitList<Observation> & waitList_;
+  typename ObservationWaitList<Observation>::Waiter waiter_;
+  std::coroutine_handle<> handle_;
+  bool isWaiting_;
+};
+
+//-----------------------------------------------------------------------------
+inline NextObservationAwaitable<ObservationPosition> nextPosition(
+  LocalisationGPSPluginBase & plugin)
+{
+  return NextObservationAwaitable<ObservationPosition>(plugin.getPositionWaitList());
+}
+
+//-----------------------------------------------------------------------------
+inline NextObservationAwaitable<ObservationCourse> nextCourse(
+  LocalisationGPSPluginBase & plugin)
+{
+  return NextObservationAwaitable<ObservationCourse>(plugin.getCourseWaitList());
+}
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSAWAITABLES_HPP_
@@ -0,0 +1,188 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSFLEET_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSFLEET_HPP_
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+#include "romea_core_localisation/ObservationCourse.hpp"
+
+// local
+#include "LocalisationGPSPlugin.hpp"
+#include "WorkStealingThreadPool.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+using VehicleId = uint64_t;
+
+struct LocalisationGPSFleetMetrics
+{
+  size_t numberOfVehicles;
+  uint64_t postedInputs;
+  uint64_t processedInputs;
+  // unknown vehicle, sentence not supported by the vehicle plugin or full
+  // vehicle queue
+  uint64_t rejectedInputs;
+  // plugin has thrown while processing the input
+  uint64_t failedInputs;
+  uint64_t positionObservations;
+  uint64_t courseObservations;
+  size_t pendingInputs;
+  size_t maximalVehicleQueueLength;
+  // processed inputs per second since fleet construction
+  double throughput;
+  WorkStealingThreadPoolMetrics pool;
+};
+
+// Hosts the GPS plugins of many vehicles and processes their inputs on a
+// work stealing thread pool. Inputs of a vehicle are processed one at a
+// time in posting order, inputs of different vehicles run in parallel.
+// Observation callbacks are called from pool threads, never concurrently
+// for the same vehicle, and must be set before posting inputs. Inputs
+// posted to a vehicle whose queue is full are rejected.
+class LocalisationGPSFleet
+{
+public:
+  using PositionCallback = std::function<void (
+        const VehicleId &, const Duration &, const ObservationPosition &)>;
+  using CourseCallback = std::function<void (
+        const VehicleId &, const Duration &, const ObservationCourse &)>;
+
+  explicit LocalisationGPSFleet(
+    const size_t & numberOfThreads = std::thread::hardware_concurrency(),
+    const size_t & maximalBatchSize = 32,
+    const size_t & vehicleQueueCapacity = 1024);
+
+  // pending inputs are processed before destruction
+  ~LocalisationGPSFleet();
+
+  void addVehicle(
+    const VehicleId & vehicleId,
+    std::unique_ptr<LocalisationSingleAntennaGPSPlugin> plugin);
+
+  void addVehicle(
+    const VehicleId & vehicleId,
+    std::unique_ptr<LocalisationDualAntennaGPSPlugin> plugin);
+
+  LocalisationGPSPluginBase * getPlugin(const VehicleId & vehicleId);
+
+  void setPositionCallback(const PositionCallback & callback);
+
+  void setCourseCallback(const CourseCallback & callback);
+
+  // GGA, GST, GSV and RMC or HDT sentences according to the vehicle plugin,
+  // returns false when the input is rejected
+  bool postSentence(
+    const VehicleId & vehicleId,
+    const Duration & stamp,
+    const std::string & sentence);
+
+  // single antenna vehicles only
+  bool postLinearSpeed(
+    const VehicleId & vehicleId,
+    const Duration & stamp,
+    const double & linearSpeed);
+
+  void waitUntilIdle();
+
+  LocalisationGPSFleetMetrics getMetrics() const;
+
+private:
+  enum class InputType
+  {
+    SENTENCE,
+    LINEAR_SPEED
+  };
+
+  struct Input
+  {
+    InputType type;
+    Duration stamp;
+    std::string sentence;
+    double linearSpeed;
+  };
+
+  struct Vehicle
+  {
+    VehicleId id;
+    // shared pointer keeps the deleter of the actual plugin type
+    std::shared_ptr<LocalisationGPSPluginBase> plugin;
+    LocalisationSingleAntennaGPSPlugin * singleAntennaPlugin;
+    LocalisationDualAntennaGPSPlugin * dualAntennaPlugin;
+
+    std::mutex mutex;
+    std::deque<Input> inputs;
+    bool isScheduled;
+
+    ObservationPosition positionObs;
+    ObservationCourse courseObs;
+  };
+
+  void addVehicle_(std::unique_ptr<Vehicle> vehicle);
+  Vehicle * findVehicle_(const VehicleId & vehicleId) const;
+  bool post_(Vehicle * vehicle, Input && input);
+  void processVehicle_(Vehicle * vehicle);
+  void processInput_(Vehicle & vehicle, const Input & input);
+
+private:
+  size_t maximalBatchSize_;
+  size_t vehicleQueueCapacity_;
+
+  mutable std::shared_mutex vehiclesMutex_;
+  std::unordered_map<VehicleId, std::unique_ptr<Vehicle>> vehicles_;
+
+  PositionCallback positionCallback_;
+  CourseCallback courseCallback_;
+
+  std::chrono::steady_clock::time_point startTime_;
+  std::atomic<uint64_t> postedInputs_;
+  std::atomic<uint64_t> processedInputs_;
+  std::atomic<uint64_t> rejectedInputs_;
+  std::atomic<uint64_t> failedInputs_;
+  std::atomic<uint64_t> positionObservations_;
+  std::atomic<uint64_t> courseObservations_;
+  std::atomic<size_t> pendingInputs_;
+  std::atomic<size_t> maximalVehicleQueueLength_;
+
+  std::mutex idleMutex_;
+  std::condition_variable idleCondition_;
+
+  // declared last to be joined before vehicles are destroyed
+  WorkStealingThreadPool pool_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSFLEET_HPP_
@@ -18,112 +18,422 @@
 
 
 // std
+#include <atomic>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 // romea core
 #include "romea_core_gps/GPSReceiver.hpp"
 #include "romea_core_common/geodesy/ENUConverter.hpp"
-#include "romea_core_common/diagnostic/CheckupRate.hpp"
 #include "romea_core_localisation/ObservationPosition.hpp"
 #include "romea_core_localisation/ObservationCourse.hpp"
 
 // local
+#include "CacheLine.hpp"
 #include "CheckupGGAFix.hpp"
-#include "CheckupHDTTrackAngle.hpp"
-#include "CheckupRMCTrackAngle.hpp"
+#include "CheckupGeofence.hpp"
+#include "DiagnosticReportDelta.hpp"
+#include "GSTCovarianceCache.hpp"
+#include "GSVCycleCache.hpp"
+#include "HDTCourseStream.hpp"
+#include "LockProfiler.hpp"
+#include "NMEASentenceCounters.hpp"
+#include "ObservationQueue.hpp"
+#include "ObservationWaitList.hpp"
+#include "PluginSnapshot.hpp"
+#include "PositionAggregator.hpp"
+#include "PositionJumpGate.hpp"
+#include "ProcessingTracer.hpp"
+#include "RMCCourseStream.hpp"
+#include "SharedObservationPublisher.hpp"
+#include "StatusTransitionNotifier.hpp"
+#include "StreamRateDiagnostic.hpp"
 
 namespace romea
 {
 namespace core
 {
 
+// State and processing shared by all plugins: GGA positions, GSV satellites
+// views, status transitions and diagnostic report journal. Plugins are
+// LocalisationGPSPlugin instances, this class is not meant to be used alone
+// and cannot be deleted through a pointer to it.
 class LocalisationGPSPluginBase
 {
 public:
-  LocalisationGPSPluginBase(
-    std::unique_ptr<GPSReceiver> gps,
-    const FixQuality & minimalFixQuality);
-
-  virtual ~LocalisationGPSPluginBase() = default;
+  using StatusTransitionCallback = StatusTransitionNotifier::Callback;
 
+  // positions accepted by the jump gate or being aggregated and geofence
+  // zones are expressed in the ENU frame of the previous anchor, so the gate
+  // and the aggregation restart and the geofence is dropped and has to be
+  // set again. Must be called by the thread feeding GGA sentences.
   void setAnchor(const GeodeticCoordinates & wgs84_anchor);
 
+  // publishes one averaged position every numberOfFixes valid fixes or every
+  // window (see PositionAggregator), must be set before feeding sentences
+  void setPositionAggregation(const size_t & numberOfFixes, const Duration & window);
+
+  // fixes have already been gated by the given gate (realtime plugins), the
+  // plugin then neither gates them again nor reports its own gate but the
+  // given one, must be set before feeding sentences
+  void setExternalPositionJumpGate(const PositionJumpGate * positionJumpGate);
+
   bool processGGA(
     const Duration & stamp,
     const std::string & ggaSentence,
     ObservationPosition & positionObs);
 
+  bool processGGA(
+    const Duration & stamp,
+    const GGAFrame & ggaFrame,
+    ObservationPosition & positionObs);
+
+  // GST error ellipses give the covariance of the GGA positions which follow
+  // them by less than the maximal age, the HDOP based covariance being used
+  // otherwise, they must be fed by the thread feeding GGA sentences
+  bool processGST(
+    const Duration & stamp,
+    const std::string & gstSentence);
+
+  bool processGST(
+    const Duration & stamp,
+    const GSTFrame & gstFrame);
+
+  void setGSTMaximalAge(const Duration & maximalAge);
+
   void processGSV(const std::string & gsvSentence);
 
   const ENUConverter & getENUConverter()const;
 
-  DiagnosticReport makeDiagnosticReport(const Duration & stamp);
+  const GPSReceiver & getGPSReceiver()const;
+
+  // callbacks are called from the thread feeding the plugin
+  // each time the status of a checkup or the fix quality changes
+  void registerStatusTransitionCallback(const StatusTransitionCallback & callback);
+
+  // produced observations and status transitions are also written into the
+  // shared memory ring of the publisher, must be set before feeding sentences
+  void setSharedObservationPublisher(std::shared_ptr<SharedObservationPublisher> publisher);
+
+  // produced observations are also published into the queue drained by the
+  // localisation filter thread, tagged with the given source id, must be
+  // set before feeding sentences
+  void setObservationQueue(std::shared_ptr<ObservationQueue> queue, const uint32_t & sourceId);
+
+  // published positions are located with respect to the geofence zones,
+  // which are expressed in the ENU frame of the current anchor. The geofence
+  // is swapped atomically and can be replaced while sentences are fed.
+  void setGeofence(std::shared_ptr<const Geofence> geofence);
+
+  // waiters are resumed by the feeding thread right after the next valid
+  // position or course has been produced, LocalisationGPSAwaitables.hpp
+  // wraps them into C++20 awaitables
+  ObservationWaitList<ObservationPosition> & getPositionWaitList();
+
+  ObservationWaitList<ObservationCourse> & getCourseWaitList();
 
 protected:
-  virtual void checkHearBeats_(const Duration & stamp) = 0;
-  virtual DiagnosticReport makeDiagnosticReport_() = 0;
+  LocalisationGPSPluginBase(
+    std::unique_ptr<GPSReceiver> gps,
+    const FixQuality & minimalFixQuality);
+
+  ~LocalisationGPSPluginBase() = default;
+
+  bool processGGA_(
+    const Duration & stamp,
+    const GGAFrame & ggaFrame,
+    ObservationPosition & positionObs);
+
+  void checkGGAHeartBeat_(const Duration & stamp);
+  void appendGGAReport_(DiagnosticReport & report) const;
+  void dumpGGAHistory_(std::ostream & os) const;
+
+  DiagnosticReportDelta makeDiagnosticReportDelta_(
+    const DiagnosticReport & report,
+    const uint64_t & sinceSequence);
+
+  void publishCourse_(
+    const bool & isCourseValid,
+    const Duration & stamp,
+    const ObservationCourse & courseObs);
+
+  PluginSnapshot makeSnapshot_(const Duration & stamp) const;
+  bool restoreSnapshot_(
+    const PluginSnapshot & snapshot,
+    const Duration & stamp,
+    const Duration & maximalAge);
 
 protected:
+  // state is grouped by writing thread, each group starting on its own cache
+  // line to avoid false sharing between the odometry, serial and diagnostics
+  // threads
+
+  // configuration, only written at construction and by setters
   std::unique_ptr<GPSReceiver> gps_;
   ENUConverter enuConverter_;
+  std::shared_ptr<SharedObservationPublisher> publisher_;
+  std::shared_ptr<ObservationQueue> observationQueue_;
+  uint32_t observationSourceId_;
 
-  CheckupGreaterThanRate ggaRateDiagnostic_;
+  // written by the serial thread feeding GGA sentences
+  alignas(CACHE_LINE_SIZE) StreamRateDiagnostic ggaRateDiagnostic_;
   CheckupGGAFix ggaFixDiagnostic_;
-};
+  PositionAggregator positionAggregator_;
+  PositionJumpGate positionJumpGate_;
+  const PositionJumpGate * externalPositionJumpGate_;
+  GSTCovarianceCache gstCovarianceCache_;
+  // only accessed through std::atomic_load and std::atomic_store
+  std::shared_ptr<CheckupGeofence> geofenceDiagnostic_;
+  std::atomic<double> positionStd_;
 
+  // odometry linear speed used to bound position jumps, null when the
+  // plugin has no RMCCourseStream
+  const std::atomic<double> * odometryLinearSpeed_;
 
-class LocalisationSingleAntennaGPSPlugin : public LocalisationGPSPluginBase
+  // written by the thread feeding GSV sentences, kept to warm start plugins
+  GSVCycleCache gsvCycleCache_;
+
+  // updated by every feeding thread
+  StatusTransitionNotifier notifier_;
+  NMEASentenceCounters sentenceCounters_;
+
+  // written by waiting threads and by feeding threads
+  alignas(CACHE_LINE_SIZE) ObservationWaitList<ObservationPosition> positionWaitList_;
+  ObservationWaitList<ObservationCourse> courseWaitList_;
+
+  // written by the diagnostics thread
+  alignas(CACHE_LINE_SIZE) ProfiledMutex journalMutex_;
+  DiagnosticReportJournal journal_;
+};
+
+// Plugin composed at compile time of the course streams it needs
+// (RMCCourseStream, HDTCourseStream) on top of GGA positions. Heart beats,
+// reports and histories of the streams are gathered without virtual calls
+// and a plugin only carries the state of its own streams, for instance
+// LocalisationGPSPlugin<> only processes GGA and GSV sentences.
+// Each stream is built from the receiver and its Parameters, which can be
+// omitted when all streams provide default parameters.
+template<typename ... Streams>
+class LocalisationGPSPlugin : public LocalisationGPSPluginBase, private Streams...
 {
 public:
-  LocalisationSingleAntennaGPSPlugin(
+  template<typename Stream>
+  static constexpr bool hasStream = (std::is_same_v<Stream, Streams>|| ...);
+
+  LocalisationGPSPlugin(
     std::unique_ptr<GPSReceiver> gps,
     const FixQuality & minimalFixQuality,
-    const double & minimalSpeedOverGround);
+    const typename Streams::Parameters & ... parameters)
+  : LocalisationGPSPluginBase(std::move(gps), minimalFixQuality),
+    Streams(*gps_, parameters)...
+  {
+    if constexpr (hasStream<RMCCourseStream>) {
+      odometryLinearSpeed_ = &stream_<RMCCourseStream>().getLinearSpeed();
+    }
+  }
+
+  template<size_t N = sizeof...(Streams), typename = std::enable_if_t<N != 0>>
+  LocalisationGPSPlugin(
+    std::unique_ptr<GPSReceiver> gps,
+    const FixQuality & minimalFixQuality)
+  : LocalisationGPSPlugin(std::move(gps), minimalFixQuality, Streams::defaultParameters()...)
+  {
+  }
 
   void processLinearSpeed(
     const Duration & stamp,
-    const double & linearSpeed);
+    const double & linearSpeed)
+  {
+    TraceScope trace("processLinearSpeed", stamp);
+    stream_<RMCCourseStream>().processLinearSpeed(stamp, linearSpeed, notifier_);
+    notifier_.dispatch();
+  }
 
   bool processRMC(
     const Duration & stamp,
     const std::string & rmcSentence,
-    ObservationCourse & courseObs);
+    ObservationCourse & courseObs)
+  {
+    RMCFrame rmcFrame;
+    try {
+      TraceScope trace("parseRMC", stamp);
+      rmcFrame = RMCFrame(rmcSentence);
+    } catch (const std::exception &) {
+      // numeric fields too long to be parsed, the frame is left empty
+    }
+    return processRMC(stamp, rmcFrame, courseObs);
+  }
 
-private:
-  void checkHearBeats_(const Duration & stamp) override;
-  DiagnosticReport makeDiagnosticReport_() override;
+  bool processRMC(
+    const Duration & stamp,
+    const RMCFrame & rmcFrame,
+    ObservationCourse & courseObs)
+  {
+    TraceScope trace("processRMC", stamp);
+    bool isCourseValid = stream_<RMCCourseStream>().processRMC(
+      stamp, rmcFrame, positionStd_.load(), notifier_, courseObs);
+    notifier_.dispatch();
+    publishCourse_(isCourseValid, stamp, courseObs);
+    trace.setOutcome(isCourseValid);
+    return isCourseValid;
+  }
 
-private:
-  std::atomic<double> linearSpeed_;
-  CheckupGreaterThanRate linearSpeedRateDiagnostic_;
+  bool processHDT(
+    const Duration & stamp,
+    const std::string & hdtSentence,
+    ObservationCourse & courseObs)
+  {
+    HDTFrame hdtFrame;
+    try {
+      TraceScope trace("parseHDT", stamp);
+      hdtFrame = HDTFrame(hdtSentence);
+    } catch (const std::exception &) {
+      // numeric fields too long to be parsed, the frame is left empty
+    }
+    return processHDT(stamp, hdtFrame, courseObs);
+  }
 
-  CheckupGreaterThanRate rmcRateDiagnostic_;
-  CheckupRMCTrackAngle rmcTrackAngleDiagnostic_;
-};
+  bool processHDT(
+    const Duration & stamp,
+    const HDTFrame & hdtFrame,
+    ObservationCourse & courseObs)
+  {
+    TraceScope trace("processHDT", stamp);
+    bool isCourseValid = stream_<HDTCourseStream>().processHDT(
+      stamp, hdtFrame, notifier_, courseObs);
+    notifier_.dispatch();
+    publishCourse_(isCourseValid, stamp, courseObs);
+    trace.setOutcome(isCourseValid);
+    return isCourseValid;
+  }
 
-class LocalisationDualAntennaGPSPlugin : public LocalisationGPSPluginBase
-{
-public:
-  LocalisationDualAntennaGPSPlugin(
-    std::unique_ptr<GPSReceiver> gps,
-    const FixQuality & minimalFixQuality);
+  // predicted course observations between HDT sentences
+  bool processYawRate(
+    const Duration & stamp,
+    const double & yawRate,
+    ObservationCourse & courseObs)
+  {
+    TraceScope trace("processYawRate", stamp);
+    bool isCourseValid = stream_<HDTCourseStream>().processYawRate(stamp, yawRate, courseObs);
+    publishCourse_(isCourseValid, stamp, courseObs);
+    trace.setOutcome(isCourseValid);
+    return isCourseValid;
+  }
 
+  // classifies the sentence from its address and forwards it to the process
+  // function of its type without any string comparison (GST sentences only
+  // update the position covariance), other sentences
+  // (and RMC or HDT ones when the plugin has no matching stream) are only
+  // counted, sentenceType tells which of positionObs (GGA) or courseObs
+  // (RMC, HDT) has been filled when true is returned
+  bool processNMEA(
+    const Duration & stamp,
+    const std::string & sentence,
+    NMEASentenceType & sentenceType,
+    ObservationPosition & positionObs,
+    ObservationCourse & courseObs)
+  {
+    sentenceType = classifyNMEASentence(sentence);
+    sentenceCounters_.count(sentenceType);
 
-  bool processHDT(
+    switch (sentenceType) {
+      case NMEASentenceType::GGA:
+        return processGGA(stamp, sentence, positionObs);
+      case NMEASentenceType::GST:
+        processGST(stamp, sentence);
+        return false;
+      case NMEASentenceType::GSV:
+        processGSV(sentence);
+        return false;
+      case NMEASentenceType::RMC:
+        if constexpr (hasStream<RMCCourseStream>) {
+          return processRMC(stamp, sentence, courseObs);
+        }
+        return false;
+      case NMEASentenceType::HDT:
+        if constexpr (hasStream<HDTCourseStream>) {
+          return processHDT(stamp, sentence, courseObs);
+        }
+        return false;
+      default:
+        return false;
+    }
+  }
+
+  DiagnosticReport makeDiagnosticReport(const Duration & stamp)
+  {
+    TraceScope trace("makeDiagnosticReport", stamp);
+    checkGGAHeartBeat_(stamp);
+    (Streams::checkHeartBeats(stamp, notifier_), ...);
+    notifier_.dispatch();
+
+    DiagnosticReport report;
+    (Streams::appendOdometryReport(report), ...);
+    appendGGAReport_(report);
+    (Streams::appendReport(report), ...);
+    report += sentenceCounters_.getReport();
+    return report;
+  }
+
+  // only holds the parts of the report which changed since the given sequence
+  DiagnosticReportDelta makeDiagnosticReportDelta(
     const Duration & stamp,
-    const std::string & hdtSentence,
-    ObservationCourse & courseObs);
+    const uint64_t & sinceSequence)
+  {
+    return makeDiagnosticReportDelta_(makeDiagnosticReport(stamp), sinceSequence);
+  }
 
-private:
-  void checkHearBeats_(const Duration & stamp) override;
-  DiagnosticReport makeDiagnosticReport_() override;
+  // state needed to warm start a plugin after a restart, see PluginSnapshot,
+  // can be taken from any thread while the plugin is fed
+  PluginSnapshot makeSnapshot(const Duration & stamp) const
+  {
+    PluginSnapshot snapshot = makeSnapshot_(stamp);
+    (Streams::saveSnapshot(snapshot), ...);
+    return snapshot;
+  }
+
+  // to be called right after construction, before feeding the plugin. The
+  // anchor is always restored as by setAnchor(), the other parts of the state only when the
+  // snapshot is not older than maximal age, input stamps being shifted by
+  // the age of the snapshot. Returns false when the snapshot is stale.
+  bool restoreSnapshot(
+    const PluginSnapshot & snapshot,
+    const Duration & stamp,
+    const Duration & maximalAge = durationFromSecond(10.))
+  {
+    if (!restoreSnapshot_(snapshot, stamp, maximalAge)) {
+      return false;
+    }
+
+    (Streams::restoreSnapshot(snapshot, stamp - snapshot.stamp, notifier_), ...);
+    notifier_.dispatch();
+    return true;
+  }
+
+  void dumpDiagnosticHistory(std::ostream & os) const
+  {
+    (Streams::dumpOdometryHistory(os), ...);
+    dumpGGAHistory_(os);
+    (Streams::dumpHistory(os), ...);
+  }
 
 private:
-  CheckupGreaterThanRate hdtRateDiagnostic_;
-  CheckupHDTTrackAngle hdtTrackAngleDiagnostic_;
+  template<typename Stream>
+  Stream & stream_()
+  {
+    static_assert(hasStream<Stream>, "this plugin is not composed of the requested stream");
+    return *this;
+  }
 };
 
+using LocalisationSingleAntennaGPSPlugin = LocalisationGPSPlugin<RMCCourseStream>;
+using LocalisationDualAntennaGPSPlugin = LocalisationGPSPlugin<HDTCourseStream>;
+
 }  // namespace core
 }  // namespace romea
 
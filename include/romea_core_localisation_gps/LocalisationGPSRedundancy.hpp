@@ -0,0 +1,149 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSREDUNDANCY_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSREDUNDANCY_HPP_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+// local
+#include "LocalisationGPSPlugin.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+struct RedundantPositionObservation
+{
+  Duration stamp;
+  ObservationPosition observation;
+  // receiver whose fix has been selected or used as merge reference
+  size_t referenceReceiver;
+  size_t numberOfMergedReceivers;
+};
+
+struct RedundantGPSReceiverStatus
+{
+  uint64_t numberOfEpochs;
+  uint64_t numberOfValidFixes;
+  uint64_t numberOfSelections;
+  uint64_t numberOfDisagreements;
+  // the last valid fix of the receiver disagreed with the reference fix
+  bool isDisagreeing;
+};
+
+// Redundancy layer over the plugins of several receivers mounted on the same
+// vehicle. GGA fixes whose stamps lie within the epoch tolerance form an
+// epoch, closed as soon as every receiver has contributed, or by a fix of
+// the next epoch, or by flush() once the tolerance has elapsed, which bounds
+// the added latency to the epoch tolerance. Valid fixes are ranked by their
+// expected accuracy (UERE of their fix quality times HDOP). The reference fix
+// is the one consistent with most other fixes, and fixes which are not
+// consistent with it are flagged. Only one observation is emitted per epoch:
+// the reference fix, or in MERGE mode a consistency weighted merge of the
+// fixes agreeing with the reference when their antennas share the same
+// level arm. Each receiver can be fed by its own thread.
+class LocalisationGPSRedundancy
+{
+public:
+  enum class Mode
+  {
+    BEST,
+    MERGE
+  };
+
+  LocalisationGPSRedundancy(
+    const Mode & mode,
+    const Duration & epochTolerance,
+    const double & consistencyThreshold = 3.);
+
+  // plugins must be added before processing any sentence, callers keep their
+  // own pointer to feed the course streams
+  size_t addReceiver(std::shared_ptr<LocalisationGPSPluginBase> plugin);
+
+  size_t getNumberOfReceivers() const;
+
+  void setAnchor(const GeodeticCoordinates & wgs84_anchor);
+
+  // returns true when the fix closes an epoch which yields an observation
+  bool processGGA(
+    const size_t & receiverIndex,
+    const Duration & stamp,
+    const std::string & ggaSentence,
+    RedundantPositionObservation & positionObs);
+
+  bool processGGA(
+    const size_t & receiverIndex,
+    const Duration & stamp,
+    const GGAFrame & ggaFrame,
+    RedundantPositionObservation & positionObs);
+
+  // closes the current epoch when its tolerance has elapsed at the given stamp
+  bool flush(const Duration & stamp, RedundantPositionObservation & positionObs);
+
+  RedundantGPSReceiverStatus getReceiverStatus(const size_t & receiverIndex) const;
+
+  DiagnosticReport makeDiagnosticReport() const;
+
+private:
+  struct Candidate
+  {
+    bool hasContributed;
+    bool isValid;
+    Duration stamp;
+    ObservationPosition observation;
+    double fixStd;
+  };
+
+  struct Receiver
+  {
+    std::shared_ptr<LocalisationGPSPluginBase> plugin;
+    Candidate candidate;
+    RedundantGPSReceiverStatus status;
+  };
+
+  bool isEpochComplete_() const;
+  bool closeEpoch_(RedundantPositionObservation & positionObs);
+  bool areConsistent_(const Candidate & candidate1, const Candidate & candidate2) const;
+  void merge_(
+    const std::vector<size_t> & receiverIndexes,
+    RedundantPositionObservation & positionObs) const;
+
+private:
+  Mode mode_;
+  Duration epochTolerance_;
+  double consistencyThreshold_;
+
+  mutable std::mutex mutex_;
+  std::vector<Receiver> receivers_;
+  bool isEpochOpen_;
+  Duration epochStamp_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__LOCALISATIONGPSREDUNDANCY_HPP_
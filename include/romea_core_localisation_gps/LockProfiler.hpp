@@ -0,0 +1,96 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__LOCKPROFILER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__LOCKPROFILER_HPP_
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace romea
+{
+namespace core
+{
+
+struct LockProfile
+{
+  std::string name;
+  uint64_t numberOfLocks;
+  uint64_t numberOfContentions;
+  std::chrono::nanoseconds totalWaitTime;
+  std::chrono::nanoseconds maximalWaitTime;
+  std::chrono::nanoseconds totalHoldTime;
+  std::chrono::nanoseconds maximalHoldTime;
+};
+
+// Aggregates the wait and hold times of the plugin mutexes by name (all
+// gga_fix mutexes of all plugins share the same profile). Profiling is
+// disabled by default, mutexes then only pay a relaxed atomic load.
+class LockProfiler
+{
+public:
+  struct Counters
+  {
+    std::atomic<uint64_t> numberOfLocks{0};
+    std::atomic<uint64_t> numberOfContentions{0};
+    std::atomic<int64_t> totalWaitTime{0};
+    std::atomic<int64_t> maximalWaitTime{0};
+    std::atomic<int64_t> totalHoldTime{0};
+    std::atomic<int64_t> maximalHoldTime{0};
+  };
+
+  static void enable(const bool & enabled);
+
+  static bool isEnabled();
+
+  static Counters & getCounters(const std::string & name);
+
+  static std::vector<LockProfile> getProfiles();
+
+  static void reset();
+};
+
+// std::mutex replacement reporting its wait and hold times to LockProfiler
+class ProfiledMutex
+{
+public:
+  explicit ProfiledMutex(const char * name);
+
+  ProfiledMutex(const ProfiledMutex &) = delete;
+  ProfiledMutex & operator=(const ProfiledMutex &) = delete;
+
+  void lock();
+
+  bool try_lock();
+
+  void unlock();
+
+private:
+  std::mutex mutex_;
+  LockProfiler::Counters & counters_;
+  // only accessed by the owner of the mutex
+  std::chrono::steady_clock::time_point lockTime_;
+  bool isProfiled_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__LOCKPROFILER_HPP_
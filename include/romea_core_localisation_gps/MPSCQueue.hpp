@@ -0,0 +1,155 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__MPSCQUEUE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__MPSCQUEUE_HPP_
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// local
+#include "CacheLine.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Bounded lock free queue between any number of producer threads and one
+// consumer thread. Slots are allocated at construction and each of them
+// carries a sequence number telling whether it is free or filled, so that
+// producers only contend on a compare and swap of the tail and never block:
+// a full queue rejects new elements. The consumer reads elements in place
+// and stops at a slot claimed by a producer which has not filled it yet.
+template<typename T>
+class MPSCQueue
+{
+public:
+  explicit MPSCQueue(const size_t & capacity)
+  : capacity_(roundUpToPowerOfTwo_(capacity)),
+    mask_(capacity_ - 1),
+    slots_(new Slot[capacity_]),
+    head_(0),
+    tail_(0)
+  {
+    for (size_t n = 0; n < capacity_; ++n) {
+      slots_[n].sequence.store(n, std::memory_order_relaxed);
+    }
+  }
+
+  MPSCQueue(const MPSCQueue &) = delete;
+  MPSCQueue & operator=(const MPSCQueue &) = delete;
+
+  // producer side, fill is called with the claimed element
+  template<typename Fill>
+  bool tryEmplace(Fill && fill)
+  {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    Slot * slot;
+    while (true) {
+      slot = &slots_[tail & mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(tail);
+      if (difference == 0) {
+        if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        tail = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    fill(slot->value);
+    slot->sequence.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // producer side
+  bool tryPush(const T & value)
+  {
+    return tryEmplace([&value](T & element) {element = value;});
+  }
+
+  // consumer side, consume is called with the element before its slot is
+  // given back to producers
+  template<typename Consume>
+  bool tryConsume(Consume && consume)
+  {
+    size_t head = head_.load(std::memory_order_relaxed);
+    Slot & slot = slots_[head & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+      return false;
+    }
+
+    consume(slot.value);
+    slot.sequence.store(head + capacity_, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side
+  bool tryPop(T & value)
+  {
+    return tryConsume([&value](const T & element) {value = element;});
+  }
+
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  // only a hint when producers and consumer are running
+  size_t size() const
+  {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t roundUpToPowerOfTwo_(const size_t & capacity)
+  {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+private:
+  size_t capacity_;
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // head and tail are written by different threads
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__MPSCQUEUE_HPP_
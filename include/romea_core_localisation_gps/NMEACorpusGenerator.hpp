@@ -0,0 +1,154 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__NMEACORPUSGENERATOR_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__NMEACORPUSGENERATOR_HPP_
+
+// std
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+
+// eigen
+#include <Eigen/Core>
+
+// romea
+#include "romea_core_common/geodesy/ENUConverter.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+struct NMEACorpusOptions
+{
+  uint64_t seed = 0;
+
+  // trajectory, angles in radians
+  double anchorLatitude = 0.7854;
+  double anchorLongitude = 0.03;
+  double anchorAltitude = 454.1;
+  double linearSpeed = 3.;
+  double maximalYawRate = 0.3;
+
+  // receiver, sentences are emitted at gnss rate except GSV ones which
+  // are emitted once per second
+  double gnssRate = 10.;
+  double rtkPositionStd = 0.01;
+  double floatPositionStd = 0.3;
+  double courseStd = 0.005;
+  bool emitsHDT = true;
+
+  // faults, dropout rate is in dropouts per second and other ones are
+  // probabilities per epoch (or per sentence for corruptions)
+  double rtkDropoutRate = 0.005;
+  Duration rtkDropoutDuration = durationFromSecond(10.);
+  double multipathProbability = 0.002;
+  double multipathAmplitude = 3.;
+  double hdopSpikeProbability = 0.002;
+  double gsvBurstProbability = 0.01;
+  double corruptChecksumProbability = 0.001;
+  double truncationProbability = 0.001;
+
+  // corpus length, null for an endless corpus
+  Duration duration = Duration::zero();
+};
+
+enum class NMEAFault : uint8_t
+{
+  NONE = 0,
+  RTK_DROPOUT,
+  MULTIPATH,
+  HDOP_SPIKE,
+  GSV_BURST,
+  CORRUPT_CHECKSUM,
+  TRUNCATED
+};
+
+const char * toString(const NMEAFault & fault);
+
+// state of the simulated vehicle at the epoch of a sentence, position is
+// given in the ENU frame of the anchor and course is the ENU yaw angle
+struct NMEAGroundTruth
+{
+  Eigen::Vector2d position;
+  double course;
+  double linearSpeed;
+};
+
+struct NMEACorpusRecord
+{
+  Duration stamp;
+  std::string sentence;
+  NMEAFault fault;
+  NMEAGroundTruth truth;
+};
+
+// Deterministic generator of GGA, RMC, HDT and GSV sentences of a vehicle
+// wandering around an anchor, along with the ground truth of each epoch.
+// The receiver loses RTK corrections, suffers from multipath, HDOP spikes
+// and GSV bursts and the serial line corrupts checksums and truncates
+// sentences, all at configurable rates. Randomness only comes from a
+// mt19937_64 engine and hand written distributions (standard library ones
+// are implementation defined), so that a seed gives the same corpus on
+// every platform. Sentences are generated one epoch at a time and records
+// are not kept, corpora can be as long as needed.
+class NMEACorpusGenerator
+{
+public:
+  explicit NMEACorpusGenerator(const NMEACorpusOptions & options);
+
+  // false once the corpus duration is reached
+  bool next(NMEACorpusRecord & record);
+
+  const NMEACorpusOptions & getOptions() const;
+
+  const ENUConverter & getENUConverter() const;
+
+private:
+  void simulateEpoch_();
+  void emitGGA_(const NMEAGroundTruth & truth);
+  void emitRMC_(const NMEAGroundTruth & truth);
+  void emitHDT_(const NMEAGroundTruth & truth);
+  void emitGSV_(const NMEAGroundTruth & truth);
+  void emit_(std::string sentence, const NMEAFault & fault, const NMEAGroundTruth & truth);
+
+  double uniform_();
+  double normal_();
+  bool draw_(const double & probability);
+
+private:
+  NMEACorpusOptions options_;
+  ENUConverter enuConverter_;
+  std::mt19937_64 engine_;
+
+  uint64_t epoch_;
+  Duration stamp_;
+  double latitude_;
+  double longitude_;
+  double course_;
+  double linearSpeed_;
+  double yawRate_;
+  Duration rtkDropoutEnd_;
+
+  std::deque<NMEACorpusRecord> pendingRecords_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__NMEACORPUSGENERATOR_HPP_
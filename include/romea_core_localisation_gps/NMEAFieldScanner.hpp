@@ -0,0 +1,82 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__NMEAFIELDSCANNER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__NMEAFIELDSCANNER_HPP_
+
+// std
+#include <optional>
+#include <string_view>
+
+// romea
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_gps/nmea/HDTFrame.hpp"
+#include "romea_core_gps/nmea/RMCFrame.hpp"
+
+// local
+#include "GSTFrame.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Walks through the comma separated fields of a NMEA sentence in place.
+// A sentence is valid when it starts with $ followed by a five characters
+// address and, when it has one, its checksum is correct.
+class NMEAFieldScanner
+{
+public:
+  explicit NMEAFieldScanner(std::string_view sentence);
+
+  bool isValid() const;
+
+  std::string_view getTalker() const;
+
+  std::string_view getSentenceId() const;
+
+  // returns false when there is no field left
+  bool next(std::string_view & field);
+
+  bool skip(const size_t & numberOfFields);
+
+private:
+  std::string_view address_;
+  std::string_view fields_;
+  size_t position_;
+  bool isValid_;
+};
+
+// Number parsing without locale nor allocation, empty, malformed or non
+// finite fields give empty values
+std::optional<double> parseNMEANumber(const std::string_view & field);
+
+TalkerId parseNMEATalker(const std::string_view & talker);
+
+// Frames are filled like their string constructors would do, but without
+// allocating, fields are left empty when the sentence is not valid or is
+// not of the expected type, in which case false is returned
+bool scanGGAFrame(const std::string_view & sentence, GGAFrame & ggaFrame);
+
+bool scanRMCFrame(const std::string_view & sentence, RMCFrame & rmcFrame);
+
+bool scanHDTFrame(const std::string_view & sentence, HDTFrame & hdtFrame);
+
+bool scanGSTFrame(const std::string_view & sentence, GSTFrame & gstFrame);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__NMEAFIELDSCANNER_HPP_
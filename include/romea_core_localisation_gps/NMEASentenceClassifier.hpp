@@ -0,0 +1,55 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__NMEASENTENCECLASSIFIER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__NMEASENTENCECLASSIFIER_HPP_
+
+// std
+#include <cstdint>
+#include <string_view>
+
+namespace romea
+{
+namespace core
+{
+
+enum class NMEASentenceType : uint8_t
+{
+  GGA = 0,
+  RMC,
+  HDT,
+  GSV,
+  GSA,
+  VTG,
+  ZDA,
+  GST,
+  PROPRIETARY,
+  UNSUPPORTED,
+  MALFORMED,
+  NUMBER_OF_SENTENCE_TYPES
+};
+
+const char * toString(const NMEASentenceType & type);
+
+// Classifies a sentence from its address only ($ttSSS where tt is the
+// talker and SSS the sentence id, or $P followed by a manufacturer code),
+// neither fields nor checksum are read. Sentence ids are looked up in a
+// perfect hash table, which costs a few instructions whatever the type.
+NMEASentenceType classifyNMEASentence(const std::string_view & sentence);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__NMEASENTENCECLASSIFIER_HPP_
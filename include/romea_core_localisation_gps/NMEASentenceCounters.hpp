@@ -0,0 +1,59 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__NMEASENTENCECOUNTERS_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__NMEASENTENCECOUNTERS_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+
+// local
+#include "NMEASentenceClassifier.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Numbers of received sentences per type, counted by feeding threads and
+// read by the diagnostics thread
+class NMEASentenceCounters
+{
+public:
+  NMEASentenceCounters();
+
+  void count(const NMEASentenceType & type);
+
+  uint64_t getCount(const NMEASentenceType & type) const;
+
+  // only types which have been received are reported
+  DiagnosticReport getReport() const;
+
+  void reset();
+
+private:
+  std::array<std::atomic<uint64_t>,
+    static_cast<size_t>(NMEASentenceType::NUMBER_OF_SENTENCE_TYPES)> counts_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__NMEASENTENCECOUNTERS_HPP_
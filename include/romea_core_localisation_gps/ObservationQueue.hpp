@@ -0,0 +1,160 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__OBSERVATIONQUEUE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__OBSERVATIONQUEUE_HPP_
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_localisation/ObservationCourse.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+// local
+#include "CacheLine.hpp"
+#include "MPSCQueue.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+enum class QueuedObservationType : uint8_t
+{
+  POSITION = 0,
+  COURSE
+};
+
+// only the observation of the given type is meaningful
+struct QueuedObservation
+{
+  QueuedObservationType type;
+  uint32_t sourceId;
+  Duration stamp;
+  std::chrono::steady_clock::time_point publicationTime;
+  ObservationPosition positionObs;
+  ObservationCourse courseObs;
+};
+
+// Hands observations over to the localisation filter thread without lock:
+// plugins (or any other observation source, told apart by their ids) copy
+// them into preallocated slots of a bounded MPSCQueue and the filter thread
+// drains them in batches. Observations published into a full queue are
+// dropped and counted. The latency of an observation runs from its
+// publication to the beginning of the batch which drains it.
+class ObservationQueue
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 256;
+
+  explicit ObservationQueue(const size_t & capacity = DEFAULT_CAPACITY);
+
+  // producer side, returns false when the observation is dropped
+  bool publish(
+    const uint32_t & sourceId,
+    const Duration & stamp,
+    const ObservationPosition & positionObs);
+
+  bool publish(
+    const uint32_t & sourceId,
+    const Duration & stamp,
+    const ObservationCourse & courseObs);
+
+  // consumer side, calls handler with each drained observation (at most
+  // maximalBatchSize ones) and returns the number of drained observations
+  template<typename Handler>
+  size_t drain(
+    Handler && handler,
+    const size_t & maximalBatchSize = std::numeric_limits<size_t>::max())
+  {
+    auto drainTime = std::chrono::steady_clock::now();
+    size_t numberOfObservations = 0;
+    Duration latencySum = Duration::zero();
+    Duration maximalLatency = Duration::zero();
+    auto consume = [&](const QueuedObservation & observation) {
+        // observations published after the beginning of the batch have no latency
+        auto latency = std::max(
+          std::chrono::duration_cast<Duration>(drainTime - observation.publicationTime),
+          Duration::zero());
+        latencySum += latency;
+        maximalLatency = std::max(maximalLatency, latency);
+        handler(observation);
+      };
+
+    while (numberOfObservations < maximalBatchSize && queue_.tryConsume(consume)) {
+      ++numberOfObservations;
+    }
+
+    if (numberOfObservations != 0) {
+      updateLatency_(numberOfObservations, latencySum, maximalLatency);
+    }
+    return numberOfObservations;
+  }
+
+  size_t getCapacity() const;
+
+  // only a hint when producers and consumer are running
+  size_t getDepth() const;
+
+  size_t getMaximalDepth() const;
+
+  uint64_t getNumberOfPublishedObservations() const;
+
+  uint64_t getNumberOfDroppedObservations() const;
+
+  Duration getMeanLatency() const;
+
+  Duration getMaximalLatency() const;
+
+  // warns when observations have been dropped since the previous report
+  DiagnosticReport getReport() const;
+
+private:
+  template<typename Fill>
+  bool publish_(Fill && fill);
+
+  void updateLatency_(
+    const size_t & numberOfObservations,
+    const Duration & latencySum,
+    const Duration & maximalLatency);
+
+private:
+  MPSCQueue<QueuedObservation> queue_;
+
+  // updated by producer threads
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> numberOfPublishedObservations_;
+  std::atomic<uint64_t> numberOfDroppedObservations_;
+  std::atomic<size_t> maximalDepth_;
+
+  // updated by the consumer thread
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> numberOfDrainedObservations_;
+  std::atomic<int64_t> latencySum_;
+  std::atomic<int64_t> maximalLatency_;
+
+  // updated by the diagnostics thread
+  alignas(CACHE_LINE_SIZE) mutable std::atomic<uint64_t> numberOfReportedDrops_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__OBSERVATIONQUEUE_HPP_
@@ -0,0 +1,145 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__OBSERVATIONWAITLIST_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__OBSERVATIONWAITLIST_HPP_
+
+// std
+#include <atomic>
+#include <mutex>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+// local
+#include "LockProfiler.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Waiters of the next valid observation produced by a plugin. Waiters are
+// intrusive nodes owned by the waiting side (for instance the awaitables of
+// LocalisationGPSAwaitables.hpp, which live in coroutine frames), so that
+// waiting never allocates. The thread feeding the plugin resumes them in
+// registration order right after the observation has been produced, and
+// only pays a relaxed atomic load when nobody waits.
+template<typename Observation>
+class ObservationWaitList
+{
+public:
+  struct Waiter
+  {
+    // called by the feeding thread once stamp and observation are set, the
+    // waiter may be destroyed or registered again from it
+    void (* resume)(Waiter & waiter);
+    void * context;
+    Duration stamp;
+    Observation observation;
+    Waiter * next;
+  };
+
+  explicit ObservationWaitList(const char * name)
+  : mutex_(name),
+    head_(nullptr),
+    tail_(nullptr),
+    hasWaiters_(false)
+  {
+  }
+
+  ObservationWaitList(const ObservationWaitList &) = delete;
+  ObservationWaitList & operator=(const ObservationWaitList &) = delete;
+
+  // the waiter must stay alive until it is resumed or removed
+  void push(Waiter & waiter)
+  {
+    waiter.next = nullptr;
+    std::lock_guard<ProfiledMutex> lock(mutex_);
+    if (tail_ == nullptr) {
+      head_ = &waiter;
+    } else {
+      tail_->next = &waiter;
+    }
+    tail_ = &waiter;
+    hasWaiters_.store(true, std::memory_order_relaxed);
+  }
+
+  // returns false when the waiter is not registered, either because it has
+  // never been or because it is being resumed
+  bool remove(Waiter & waiter)
+  {
+    std::lock_guard<ProfiledMutex> lock(mutex_);
+    Waiter * previous = nullptr;
+    for (Waiter * current = head_; current != nullptr; current = current->next) {
+      if (current == &waiter) {
+        if (previous == nullptr) {
+          head_ = current->next;
+        } else {
+          previous->next = current->next;
+        }
+        if (tail_ == current) {
+          tail_ = previous;
+        }
+        hasWaiters_.store(head_ != nullptr, std::memory_order_relaxed);
+        return true;
+      }
+      previous = current;
+    }
+    return false;
+  }
+
+  // resumes the waiters registered before the call, waiters registered
+  // while resuming will wait for the next observation
+  void notify(const Duration & stamp, const Observation & observation)
+  {
+    if (!hasWaiters_.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    Waiter * waiter = nullptr;
+    {
+      std::lock_guard<ProfiledMutex> lock(mutex_);
+      waiter = head_;
+      head_ = tail_ = nullptr;
+      hasWaiters_.store(false, std::memory_order_relaxed);
+    }
+
+    while (waiter != nullptr) {
+      // the waiter may not outlive its resumption
+      Waiter * next = waiter->next;
+      waiter->stamp = stamp;
+      waiter->observation = observation;
+      waiter->resume(*waiter);
+      waiter = next;
+    }
+  }
+
+  bool empty() const
+  {
+    return !hasWaiters_.load(std::memory_order_relaxed);
+  }
+
+private:
+  ProfiledMutex mutex_;
+  Waiter * head_;
+  Waiter * tail_;
+  std::atomic<bool> hasWaiters_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__OBSERVATIONWAITLIST_HPP_
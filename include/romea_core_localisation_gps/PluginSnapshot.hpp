@@ -0,0 +1,69 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__PLUGINSNAPSHOT_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__PLUGINSNAPSHOT_HPP_
+
+// std
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/geodesy/GeodeticCoordinates.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// State of a plugin needed to warm start a new one after a restart: the ENU
+// anchor, the last input stamps of each rate checkup, which are replayed to
+// restore rate checkups, the last GGA sentence, which is evaluated again to
+// restore the fix checkup report, the last GSV cycle of each talker and the
+// odometry linear speed. Streams a plugin is not composed of are left empty.
+// Everything else starts afresh on restore: RMC and HDT track angle
+// checkups wait for the next sentences, fix statistics, the position jump
+// gate window, the position aggregation and the GST covariances are empty,
+// and the geofence has to be set again.
+struct PluginSnapshot
+{
+  static constexpr size_t NUMBER_OF_RATE_STAMPS = 16;
+
+  Duration stamp;
+  GeodeticCoordinates anchor;
+
+  std::vector<Duration> ggaStamps;
+  Duration lastGGAStamp;
+  std::string lastGGASentence;
+  std::vector<std::string> gsvSentences;
+
+  double linearSpeed;
+  std::vector<Duration> linearSpeedStamps;
+  std::vector<Duration> rmcStamps;
+  std::vector<Duration> hdtStamps;
+};
+
+PluginSnapshot makeEmptyPluginSnapshot(const Duration & stamp);
+
+std::vector<uint8_t> encode(const PluginSnapshot & snapshot);
+
+PluginSnapshot decodePluginSnapshot(const std::vector<uint8_t> & buffer);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__PLUGINSNAPSHOT_HPP_
@@ -0,0 +1,90 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__POSITIONAGGREGATOR_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__POSITIONAGGREGATOR_HPP_
+
+// std
+#include <cstddef>
+
+// eigen
+#include <Eigen/Core>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Decimates high rate GGA streams: ENU fixes are accumulated in inverse
+// variance weighted running sums and a single position is built once a
+// given number of fixes has been accumulated or once they span a given time
+// window (a null number of fixes or a null window disables the corresponding
+// bound). The position is given at the stamp of the last fix: the running
+// sums also hold a weighted linear regression of the fixes over time, so the
+// weighted mean is extrapolated from the mean stamp to the last one with the
+// window velocity instead of lagging by half of the accumulation span.
+// Successive receiver fixes are strongly correlated, so the covariance is
+// the weighted mean of the fix covariances rather than the one of a mean of
+// independent fixes.
+// As observation helpers, fixes are expected to be checked (and gated)
+// beforehand.
+class PositionAggregator
+{
+public:
+  explicit PositionAggregator(
+    const size_t & numberOfFixes = 1,
+    const Duration & window = Duration::zero());
+
+  // aggregation is disabled when each fix is published on its own
+  bool isEnabled() const;
+
+  // the fix std is the one of the isotropic covariance of the ENU fix,
+  // returns true when the aggregated position can be built
+  bool add(const Duration & stamp, const ObservationPosition & positionObs, const double & fixStd);
+
+  // overwrites the position and the covariance of the given observation by
+  // the aggregated ones, restarts accumulation and returns the aggregated std
+  double makePositionObservation(ObservationPosition & positionObs);
+
+  void reset();
+
+  size_t getNumberOfAccumulatedFixes() const;
+
+private:
+  size_t numberOfFixes_;
+  Duration window_;
+
+  Duration firstStamp_;
+  double lastTime_;
+  size_t numberOfAccumulatedFixes_;
+
+  // times are taken from the first stamp and positions from the first fix
+  // to keep the regression sums well conditioned
+  Eigen::Vector2d firstPosition_;
+  double weightSum_;
+  double timeSum_;
+  double squaredTimeSum_;
+  Eigen::Vector2d positionSum_;
+  Eigen::Vector2d timePositionSum_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__POSITIONAGGREGATOR_HPP_
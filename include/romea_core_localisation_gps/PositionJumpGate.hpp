@@ -0,0 +1,119 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__POSITIONJUMPGATE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__POSITIONJUMPGATE_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Checks each new ENU position against the last accepted one and a window
+// of recent accepted positions. The displacement since the last accepted
+// position is bounded by speed * dt + maximal acceleration * dt^2 / 2, the
+// speed being the odometry linear speed when it is known or else the mean
+// speed over the window (both kept in O(1) by running sums). The excess of
+// displacement, normalized by the std of both positions, decides whether
+// the fix is accepted, accepted with an inflated covariance which brings
+// the excess back to the gate threshold, or rejected. The window restarts
+// after a gap or too many consecutive rejections, so that a genuine jump
+// (RTK convergence for instance) is eventually followed.
+// evaluate() must be called by a single thread, getReport() from any thread.
+class PositionJumpGate
+{
+public:
+  enum class Decision : uint8_t
+  {
+    ACCEPTED = 0,
+    INFLATED,
+    REJECTED
+  };
+
+  static constexpr size_t WINDOW_SIZE = 16;
+
+  explicit PositionJumpGate(
+    const double & maximalAcceleration = 2.,
+    const double & gateThreshold = 3.,
+    const double & rejectionThreshold = 10.,
+    const Duration & maximalGap = durationFromSecond(2.),
+    const size_t & maximalConsecutiveRejections = 5);
+
+  // linear speed is NaN when unknown
+  Decision evaluate(
+    const Duration & stamp,
+    const double & linearSpeed,
+    ObservationPosition & positionObs);
+
+  // forgets the accepted positions, for instance when they are expressed in
+  // another ENU frame, counters are kept. Called by the evaluating thread.
+  void reset();
+
+  uint64_t getNumberOfRejections() const;
+
+  uint64_t getNumberOfInflations() const;
+
+  // only holds a diagnostic when the last fix has been gated
+  DiagnosticReport getReport() const;
+
+private:
+  struct Sample
+  {
+    Duration stamp;
+    double x;
+    double y;
+    double std;
+    // distance and duration since the previous sample of the window
+    double stepLength;
+    double stepDuration;
+  };
+
+  void restart_();
+  void accept_(const Duration & stamp, const ObservationPosition & positionObs);
+
+private:
+  double maximalAcceleration_;
+  double gateThreshold_;
+  double rejectionThreshold_;
+  Duration maximalGap_;
+  size_t maximalConsecutiveRejections_;
+
+  std::array<Sample, WINDOW_SIZE> window_;
+  size_t windowBegin_;
+  size_t windowSize_;
+  double windowLength_;
+  double windowDuration_;
+  size_t consecutiveRejections_;
+
+  std::atomic<Decision> lastDecision_;
+  std::atomic<double> lastExcess_;
+  std::atomic<uint64_t> numberOfRejections_;
+  std::atomic<uint64_t> numberOfInflations_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__POSITIONJUMPGATE_HPP_
@@ -0,0 +1,131 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__PROCESSINGTRACER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__PROCESSINGTRACER_HPP_
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+enum class TraceOutcome : uint8_t
+{
+  NONE = 0,
+  OBSERVATION,
+  NO_OBSERVATION
+};
+
+// begin and end times are steady clock times, stamp is the stamp of the
+// processed data, name must have a static lifetime (a string literal)
+struct TraceEvent
+{
+  const char * name;
+  Duration stamp;
+  std::chrono::steady_clock::time_point beginTime;
+  std::chrono::steady_clock::time_point endTime;
+  TraceOutcome outcome;
+  uint32_t threadIndex;
+};
+
+// Records the processing of plugin inputs as complete events into per
+// thread buffers and writes them in the Chrome trace event format (which
+// Perfetto UI opens as well). A buffer is allocated the first time a thread
+// records an event and is then written without lock nor allocation, events
+// being dropped once it is full. Tracing is disabled by default, traced
+// functions then only pay a relaxed atomic load.
+class ProcessingTracer
+{
+public:
+  static constexpr size_t DEFAULT_BUFFER_CAPACITY = 1 << 16;
+
+  static void enable(const bool & enabled);
+
+  static bool isEnabled();
+
+  // only applies to buffers allocated afterwards
+  static void setBufferCapacity(const size_t & capacity);
+
+  // name of the calling thread in traces
+  static void setThreadName(const std::string & name);
+
+  static void record(const TraceEvent & event);
+
+  static std::vector<TraceEvent> getEvents();
+
+  static uint64_t getNumberOfDroppedEvents();
+
+  static void writeChromeTrace(std::ostream & os);
+
+  // frees the buffers of exited threads and empties the other ones, must
+  // not be called while traced functions are running
+  static void reset();
+};
+
+// Traces the enclosing scope when tracing is enabled at its construction
+class TraceScope
+{
+public:
+  TraceScope(const char * name, const Duration & stamp)
+  : name_(name),
+    stamp_(stamp),
+    beginTime_(),
+    outcome_(TraceOutcome::NONE),
+    isTraced_(ProcessingTracer::isEnabled())
+  {
+    if (isTraced_) {
+      beginTime_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope & operator=(const TraceScope &) = delete;
+
+  ~TraceScope()
+  {
+    if (isTraced_) {
+      ProcessingTracer::record(
+        {name_, stamp_, beginTime_, std::chrono::steady_clock::now(), outcome_, 0});
+    }
+  }
+
+  void setOutcome(const bool & isObservationProduced)
+  {
+    outcome_ = isObservationProduced ? TraceOutcome::OBSERVATION : TraceOutcome::NO_OBSERVATION;
+  }
+
+private:
+  const char * name_;
+  Duration stamp_;
+  std::chrono::steady_clock::time_point beginTime_;
+  TraceOutcome outcome_;
+  bool isTraced_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__PROCESSINGTRACER_HPP_
@@ -0,0 +1,99 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__RMCCOURSESTREAM_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__RMCCOURSESTREAM_HPP_
+
+// std
+#include <atomic>
+#include <ostream>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_gps/GPSReceiver.hpp"
+#include "romea_core_gps/nmea/RMCFrame.hpp"
+#include "romea_core_localisation/ObservationCourse.hpp"
+
+// local
+#include "CacheLine.hpp"
+#include "CheckupRMCTrackAngle.hpp"
+#include "PluginSnapshot.hpp"
+#include "StatusTransitionNotifier.hpp"
+#include "StreamRateDiagnostic.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Course stream of single antenna receivers: RMC track angles are turned into
+// course observations using the linear speed given by the odometry, which is
+// why the linear speed stream belongs to this stream
+class RMCCourseStream
+{
+public:
+  // minimal speed over ground required to trust track angles
+  using Parameters = double;
+
+  static constexpr double RMC_RATE = 1.0;
+  static constexpr double LINEAR_SPEED_RATE = 10.0;
+
+  RMCCourseStream(const GPSReceiver & gps, const Parameters & minimalSpeedOverGround);
+
+  void processLinearSpeed(
+    const Duration & stamp,
+    const double & linearSpeed,
+    StatusTransitionNotifier & notifier);
+
+  bool processRMC(
+    const Duration & stamp,
+    const RMCFrame & rmcFrame,
+    const double & positionStd,
+    StatusTransitionNotifier & notifier,
+    ObservationCourse & courseObs);
+
+  void checkHeartBeats(const Duration & stamp, StatusTransitionNotifier & notifier);
+
+  // NaN when odometry is missing
+  const std::atomic<double> & getLinearSpeed() const;
+
+  // odometry diagnostics are reported before the GNSS ones
+  void appendOdometryReport(DiagnosticReport & report) const;
+  void appendReport(DiagnosticReport & report) const;
+
+  void dumpOdometryHistory(std::ostream & os) const;
+  void dumpHistory(std::ostream & os) const;
+
+  void saveSnapshot(PluginSnapshot & snapshot) const;
+  void restoreSnapshot(
+    const PluginSnapshot & snapshot,
+    const Duration & shift,
+    StatusTransitionNotifier & notifier);
+
+private:
+  // written by the odometry thread
+  alignas(CACHE_LINE_SIZE) std::atomic<double> linearSpeed_;
+  StreamRateDiagnostic linearSpeedRateDiagnostic_;
+
+  // written by the serial thread feeding RMC sentences
+  alignas(CACHE_LINE_SIZE) StreamRateDiagnostic rmcRateDiagnostic_;
+  CheckupRMCTrackAngle rmcTrackAngleDiagnostic_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__RMCCOURSESTREAM_HPP_
@@ -0,0 +1,231 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__REALTIMELOCALISATIONGPSPLUGIN_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__REALTIMELOCALISATIONGPSPLUGIN_HPP_
+
+// std
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// local
+#include "LocalisationGPSPlugin.hpp"
+#include "RealtimeRateMonitor.hpp"
+#include "SPSCQueue.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Realtime mode of the GPS plugins. Once constructed, process* methods are
+// wait free and do not allocate: sentences are scanned in place, rates are
+// checked by RealtimeRateMonitor and checked frames are handed through
+// lock free queues to a regular plugin, which evaluates the diagnostics
+// (reports, history, transition callbacks) when a non realtime thread calls
+// processPendingEvents() or makeDiagnosticReport(). Each stream must be fed
+// by a single thread. Events are dropped and counted when a queue is full.
+// Realtime positions go through the O(1) position jump gate, which is the
+// one reported by the regular plugin, but they are neither aggregated nor
+// given GST covariances, and the geofence is only evaluated by the regular
+// plugin as a diagnostic.
+class RealtimeLocalisationGPSPluginBase
+{
+public:
+  using StatusTransitionCallback = LocalisationGPSPluginBase::StatusTransitionCallback;
+
+  static constexpr size_t DEFAULT_EVENT_QUEUE_CAPACITY = 64;
+
+  virtual ~RealtimeLocalisationGPSPluginBase() = default;
+
+  // must be called before processing any sentence
+  void setAnchor(const GeodeticCoordinates & wgs84_anchor);
+
+  const ENUConverter & getENUConverter()const;
+
+  // realtime safe
+  bool processGGA(
+    const Duration & stamp,
+    const std::string_view & ggaSentence,
+    ObservationPosition & positionObs);
+
+  // not realtime safe, satellites views are allocated by the receiver. It is
+  // serialized with processPendingEvents() and can be called by any non
+  // realtime thread, realtime functions only read the antenna position and
+  // the UEREs of the receiver, which GSV sentences leave untouched
+  void processGSV(const std::string & gsvSentence);
+
+  // not realtime safe, called from a single diagnostics thread
+  void processPendingEvents();
+
+  DiagnosticReport makeDiagnosticReport(const Duration & stamp);
+
+  DiagnosticReportDelta makeDiagnosticReportDelta(
+    const Duration & stamp,
+    const uint64_t & sinceSequence);
+
+  void dumpDiagnosticHistory(std::ostream & os);
+
+  // callbacks are called by the thread processing pending events
+  void registerStatusTransitionCallback(const StatusTransitionCallback & callback);
+
+  uint64_t getNumberOfDroppedEvents() const;
+
+protected:
+  RealtimeLocalisationGPSPluginBase(
+    std::shared_ptr<LocalisationGPSPluginBase> plugin,
+    const FixQuality & minimalFixQuality,
+    const size_t & eventQueueCapacity);
+
+  template<typename Event>
+  void push_(SPSCQueue<Event> & queue, const Event & event);
+
+  double getPositionStd_(const Duration & stamp) const;
+
+  // odometry linear speed bounding position jumps, NaN when unknown
+  virtual double getLinearSpeed_(const Duration & stamp) const;
+
+  virtual void processPendingEvents_() = 0;
+
+  virtual DiagnosticReport makePluginDiagnosticReport_(const Duration & stamp) = 0;
+  virtual DiagnosticReportDelta makePluginDiagnosticReportDelta_(
+    const Duration & stamp,
+    const uint64_t & sinceSequence) = 0;
+  virtual void dumpPluginDiagnosticHistory_(std::ostream & os) const = 0;
+
+protected:
+  struct GGAEvent
+  {
+    Duration stamp;
+    GGAFrame frame;
+  };
+
+  // shared pointer keeps the deleter of the actual plugin type
+  std::shared_ptr<LocalisationGPSPluginBase> plugin_;
+  FixQuality minimalFixQuality_;
+
+  RealtimeRateMonitor ggaRate_;
+  PositionJumpGate positionJumpGate_;
+  std::atomic<double> positionStd_;
+  SPSCQueue<GGAEvent> ggaEvents_;
+
+  std::atomic<uint64_t> droppedEvents_;
+  std::mutex pendingEventsMutex_;
+  ObservationPosition pendingPositionObs_;
+  ObservationCourse pendingCourseObs_;
+};
+
+class RealtimeLocalisationSingleAntennaGPSPlugin : public RealtimeLocalisationGPSPluginBase
+{
+public:
+  RealtimeLocalisationSingleAntennaGPSPlugin(
+    std::unique_ptr<GPSReceiver> gps,
+    const FixQuality & minimalFixQuality,
+    const double & minimalSpeedOverGround,
+    const size_t & eventQueueCapacity = DEFAULT_EVENT_QUEUE_CAPACITY);
+
+  // realtime safe
+  void processLinearSpeed(
+    const Duration & stamp,
+    const double & linearSpeed);
+
+  // realtime safe
+  bool processRMC(
+    const Duration & stamp,
+    const std::string_view & rmcSentence,
+    ObservationCourse & courseObs);
+
+private:
+  double getLinearSpeed_(const Duration & stamp) const override;
+
+  void processPendingEvents_() override;
+
+  DiagnosticReport makePluginDiagnosticReport_(const Duration & stamp) override;
+  DiagnosticReportDelta makePluginDiagnosticReportDelta_(
+    const Duration & stamp,
+    const uint64_t & sinceSequence) override;
+  void dumpPluginDiagnosticHistory_(std::ostream & os) const override;
+
+private:
+  struct LinearSpeedEvent
+  {
+    Duration stamp;
+    double linearSpeed;
+  };
+
+  struct RMCEvent
+  {
+    Duration stamp;
+    RMCFrame frame;
+  };
+
+  LocalisationSingleAntennaGPSPlugin & singleAntennaPlugin_;
+  double minimalSpeedOverGround_;
+
+  RealtimeRateMonitor linearSpeedRate_;
+  std::atomic<double> linearSpeed_;
+  SPSCQueue<LinearSpeedEvent> linearSpeedEvents_;
+
+  RealtimeRateMonitor rmcRate_;
+  SPSCQueue<RMCEvent> rmcEvents_;
+};
+
+class RealtimeLocalisationDualAntennaGPSPlugin : public RealtimeLocalisationGPSPluginBase
+{
+public:
+  RealtimeLocalisationDualAntennaGPSPlugin(
+    std::unique_ptr<GPSReceiver> gps,
+    const FixQuality & minimalFixQuality,
+    const double & antennaBaseline = std::numeric_limits<double>::quiet_NaN(),
+    const size_t & eventQueueCapacity = DEFAULT_EVENT_QUEUE_CAPACITY);
+
+  // realtime safe
+  bool processHDT(
+    const Duration & stamp,
+    const std::string_view & hdtSentence,
+    ObservationCourse & courseObs);
+
+private:
+  void processPendingEvents_() override;
+
+  DiagnosticReport makePluginDiagnosticReport_(const Duration & stamp) override;
+  DiagnosticReportDelta makePluginDiagnosticReportDelta_(
+    const Duration & stamp,
+    const uint64_t & sinceSequence) override;
+  void dumpPluginDiagnosticHistory_(std::ostream & os) const override;
+
+private:
+  struct HDTEvent
+  {
+    Duration stamp;
+    HDTFrame frame;
+  };
+
+  LocalisationDualAntennaGPSPlugin & dualAntennaPlugin_;
+  double courseAngleStd_;
+
+  RealtimeRateMonitor hdtRate_;
+  SPSCQueue<HDTEvent> hdtEvents_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__REALTIMELOCALISATIONGPSPLUGIN_HPP_
@@ -0,0 +1,62 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__REALTIMERATEMONITOR_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__REALTIMERATEMONITOR_HPP_
+
+// std
+#include <array>
+#include <atomic>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Checks that a stream is received faster than rate * (1 - epsilon) from its
+// last stamps, without lock nor allocation. A gap longer than two periods
+// restarts the estimation like a heart beat loss. evaluate() must always be
+// called from the same thread, isAlive() can be called from any thread.
+class RealtimeRateMonitor
+{
+public:
+  static constexpr size_t WINDOW_SIZE = 5;
+
+  RealtimeRateMonitor(const double & rate, const double & epsilon);
+
+  DiagnosticStatus evaluate(const Duration & stamp);
+
+  // true when the last stamp is not older than two periods
+  bool isAlive(const Duration & stamp) const;
+
+private:
+  Duration maximalWindowDuration_;
+  Duration timeout_;
+
+  std::array<Duration, WINDOW_SIZE> stamps_;
+  size_t numberOfStamps_;
+
+  std::atomic<bool> hasStamp_;
+  std::atomic<Duration> lastStamp_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__REALTIMERATEMONITOR_HPP_
@@ -0,0 +1,104 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__SPSCQUEUE_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__SPSCQUEUE_HPP_
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// local
+#include "CacheLine.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Bounded wait free queue between one producer thread and one consumer
+// thread. Slots are allocated at construction, pushing and popping only
+// copy elements and never block: a full queue rejects new elements.
+template<typename T>
+class SPSCQueue
+{
+public:
+  explicit SPSCQueue(const size_t & capacity)
+  : buffer_(roundUpToPowerOfTwo_(capacity)),
+    mask_(buffer_.size() - 1),
+    head_(0),
+    tail_(0)
+  {
+  }
+
+  // producer side
+  bool tryPush(const T & value)
+  {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == buffer_.size()) {
+      return false;
+    }
+    buffer_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side
+  bool tryPop(T & value)
+  {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = buffer_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t capacity() const
+  {
+    return buffer_.size();
+  }
+
+  // only a hint when producer and consumer are running
+  size_t size() const
+  {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+private:
+  static size_t roundUpToPowerOfTwo_(const size_t & capacity)
+  {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+private:
+  std::vector<T> buffer_;
+  size_t mask_;
+
+  // head and tail are written by different threads
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__SPSCQUEUE_HPP_
@@ -0,0 +1,94 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONPUBLISHER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONPUBLISHER_HPP_
+
+// std
+#include <string>
+
+// posix
+#include <sys/types.h>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_localisation/ObservationCourse.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+// local
+#include "SharedObservationRing.hpp"
+#include "StatusTransitionNotifier.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Publishes observations and status transitions into a POSIX shared memory
+// ring (see SharedObservationRing) that any number of local processes can
+// map with SharedObservationReader. Publishing neither locks nor allocates
+// and can be done concurrently by several threads, as long as the ring is
+// large enough not to be wrapped around during a single write. Readers never
+// slow the publisher down: a reader which is too slow loses records.
+// The shared memory object is created at construction and removed at
+// destruction, its name must start with a slash (e.g. "/romea_gps").
+// Construction fails when an object of that name already exists, a stale
+// object left by a crashed publisher has to be removed first. Only the
+// object created by the publisher is removed, not one which replaced it.
+class SharedObservationPublisher
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+  explicit SharedObservationPublisher(
+    const std::string & name,
+    const size_t & capacity = DEFAULT_CAPACITY);
+
+  ~SharedObservationPublisher();
+
+  SharedObservationPublisher(const SharedObservationPublisher &) = delete;
+  SharedObservationPublisher & operator=(const SharedObservationPublisher &) = delete;
+
+  void publish(const Duration & stamp, const ObservationPosition & positionObs);
+
+  void publish(const Duration & stamp, const ObservationCourse & courseObs);
+
+  void publish(const StatusTransition & transition);
+
+  const std::string & getName() const;
+
+  uint64_t getNumberOfRecords() const;
+
+private:
+  template<size_t N>
+  void write_(
+    const SharedObservationType & type,
+    const Duration & stamp,
+    const std::array<double, N> & values);
+
+private:
+  std::string name_;
+  dev_t device_;
+  ino_t inode_;
+  size_t capacity_;
+  size_t size_;
+  SharedObservationRingHeader * header_;
+  SharedObservationSlot * slots_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONPUBLISHER_HPP_
@@ -0,0 +1,75 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONREADER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONREADER_HPP_
+
+// std
+#include <string>
+
+// romea
+#include "romea_core_localisation/ObservationCourse.hpp"
+#include "romea_core_localisation/ObservationPosition.hpp"
+
+// local
+#include "SharedObservationRing.hpp"
+#include "StatusTransitionNotifier.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Maps read only the ring of a SharedObservationPublisher, possibly from
+// another process, and reads its records in order. Reading neither locks
+// nor allocates, records overwritten before being read are counted as lost.
+class SharedObservationReader
+{
+public:
+  // only records published after construction are read unless
+  // fromOldestRecord is set
+  explicit SharedObservationReader(
+    const std::string & name,
+    const bool & fromOldestRecord = false);
+
+  ~SharedObservationReader();
+
+  SharedObservationReader(const SharedObservationReader &) = delete;
+  SharedObservationReader & operator=(const SharedObservationReader &) = delete;
+
+  // returns false when no new record is available
+  bool read(SharedObservationRecord & record);
+
+  uint64_t getNumberOfLostRecords() const;
+
+private:
+  size_t size_;
+  const SharedObservationRingHeader * header_;
+  const SharedObservationSlot * slots_;
+  uint64_t capacity_;
+  uint64_t nextIndex_;
+  uint64_t numberOfLostRecords_;
+};
+
+ObservationPosition toObservationPosition(const SharedObservationRecord & record);
+
+ObservationCourse toObservationCourse(const SharedObservationRecord & record);
+
+StatusTransition toStatusTransition(const SharedObservationRecord & record);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONREADER_HPP_
@@ -0,0 +1,98 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONRING_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONRING_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+// local
+#include "CacheLine.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+enum class SharedObservationType : uint8_t
+{
+  POSITION = 0,
+  COURSE,
+  STATUS
+};
+
+// Record copied out of the shared ring. Values are laid out as follows:
+// - POSITION: x, y, Rxx, Rxy, Ryy, level arm x, y and z
+// - COURSE: course angle and its variance
+// - STATUS: checkup, previous status, current status, previous fix quality
+//   and current fix quality, an empty status or fix quality being -1
+struct SharedObservationRecord
+{
+  static constexpr size_t NUMBER_OF_VALUES = 8;
+
+  uint64_t index;
+  SharedObservationType type;
+  Duration stamp;
+  std::array<double, NUMBER_OF_VALUES> values;
+};
+
+// Layout of the shared memory object written by SharedObservationPublisher
+// and mapped by SharedObservationReader: a header followed by a ring of
+// slots. Records are numbered from zero, record i being written in slot
+// i % capacity whose sequence is odd (2i + 1) while it is written and equal
+// to 2i + 2 once written, so that readers detect both torn and overwritten
+// records without any lock.
+struct SharedObservationSlot
+{
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint8_t> type;
+  std::atomic<Duration::rep> stamp;
+  std::array<std::atomic<double>, SharedObservationRecord::NUMBER_OF_VALUES> values;
+};
+
+struct SharedObservationRingHeader
+{
+  static constexpr uint32_t MAGIC = 0x524F4753;  // "ROGS"
+  static constexpr uint32_t VERSION = 1;
+
+  // written last by the publisher once the ring is initialized
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint64_t capacity;
+
+  // number of records claimed by writers
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> numberOfRecords;
+};
+
+static_assert(
+  std::atomic<uint64_t>::is_always_lock_free && std::atomic<double>::is_always_lock_free,
+  "shared observation ring requires address free atomics");
+
+inline size_t sharedObservationRingSize(const size_t & capacity)
+{
+  return sizeof(SharedObservationRingHeader) + capacity * sizeof(SharedObservationSlot);
+}
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__SHAREDOBSERVATIONRING_HPP_
@@ -0,0 +1,118 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__STATUSTRANSITIONNOTIFIER_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__STATUSTRANSITIONNOTIFIER_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_core_gps/nmea/FixQuality.hpp"
+
+// local
+#include "CacheLine.hpp"
+#include "LockProfiler.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+enum class GPSCheckup
+{
+  LINEAR_SPEED_RATE = 0,
+  GGA_RATE,
+  GGA_FIX,
+  RMC_RATE,
+  RMC_TRACK_ANGLE,
+  HDT_RATE,
+  HDT_TRACK_ANGLE,
+  GEOFENCE,
+  NUMBER_OF_CHECKUPS
+};
+
+const char * toString(const GPSCheckup & checkup);
+
+// An empty status or fix quality means that the checkup has no data
+// (not evaluated yet or reset after a heart beat loss)
+struct StatusTransition
+{
+  GPSCheckup checkup;
+  Duration stamp;
+  std::optional<DiagnosticStatus> previousStatus;
+  std::optional<DiagnosticStatus> currentStatus;
+  std::optional<FixQuality> previousFixQuality;
+  std::optional<FixQuality> currentFixQuality;
+};
+
+// Detects status and fix quality transitions of plugin checkups.
+// Transitions are queued by update() and the callbacks are only called by
+// dispatch(), which must be called outside of any checkup lock. Callbacks
+// are never called concurrently and are called in transition order.
+class StatusTransitionNotifier
+{
+public:
+  using Callback = std::function<void (const StatusTransition &)>;
+
+  StatusTransitionNotifier();
+
+  void registerCallback(const Callback & callback);
+
+  void update(
+    const GPSCheckup & checkup,
+    const Duration & stamp,
+    const std::optional<DiagnosticStatus> & status,
+    const std::optional<FixQuality> & fixQuality = std::nullopt);
+
+  void dispatch();
+
+private:
+  struct CheckupState
+  {
+    std::optional<DiagnosticStatus> status;
+    std::optional<FixQuality> fixQuality;
+  };
+
+  using CheckupStates = std::array<
+    CheckupState, static_cast<size_t>(GPSCheckup::NUMBER_OF_CHECKUPS)>;
+
+private:
+  // updated by every thread feeding the plugin
+  alignas(CACHE_LINE_SIZE) ProfiledMutex pendingMutex_;
+  CheckupStates states_;
+  std::vector<StatusTransition> pendingTransitions_;
+  std::atomic<bool> hasPendingTransitions_;
+
+  // only used by the dispatching thread
+  alignas(CACHE_LINE_SIZE) ProfiledMutex dispatchMutex_;
+  std::vector<StatusTransition> dispatchedTransitions_;
+  std::vector<Callback> callbacks_;
+  std::atomic<bool> hasCallbacks_;
+  std::atomic<std::thread::id> dispatchingThread_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__STATUSTRANSITIONNOTIFIER_HPP_
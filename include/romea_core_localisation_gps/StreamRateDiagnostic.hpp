@@ -0,0 +1,83 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__STREAMRATEDIAGNOSTIC_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__STREAMRATEDIAGNOSTIC_HPP_
+
+// std
+#include <ostream>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/diagnostic/CheckupRate.hpp"
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+// local
+#include "DiagnosticHistory.hpp"
+#include "StatusTransitionNotifier.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Rate checkup of an input stream of a plugin with its history, status
+// transitions are reported to the notifier of the plugin. The history records
+// the rate measured between two consecutive evaluations.
+class StreamRateDiagnostic
+{
+public:
+  StreamRateDiagnostic(
+    const GPSCheckup & checkup,
+    const std::string & streamName,
+    const double & rate);
+
+  DiagnosticStatus evaluate(
+    const Duration & stamp,
+    StatusTransitionNotifier & notifier);
+
+  // returns false and notifies a rate error when the stream is interrupted
+  bool checkHeartBeat(
+    const Duration & stamp,
+    StatusTransitionNotifier & notifier);
+
+  DiagnosticReport getReport() const;
+
+  const DiagnosticHistory & getHistory() const;
+
+  // stamps of the last evaluations, oldest first
+  std::vector<Duration> getLastStamps(const size_t & count) const;
+
+  // evaluates the rate at previously recorded stamps, shifted by the given
+  // duration, to warm start the checkup
+  void replay(
+    const std::vector<Duration> & stamps,
+    const Duration & shift,
+    StatusTransitionNotifier & notifier);
+
+private:
+  GPSCheckup checkup_;
+  CheckupGreaterThanRate rateDiagnostic_;
+  DiagnosticHistory history_;
+  Duration previousStamp_;
+  bool hasPreviousStamp_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__STREAMRATEDIAGNOSTIC_HPP_
@@ -0,0 +1,75 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__STREAMINGSTATISTICS_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__STREAMINGSTATISTICS_HPP_
+
+// std
+#include <cstdint>
+#include <optional>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Mean, variance (Welford), minimum and maximum of a stream of values in
+// constant time and memory, statistics of an empty stream are NaN
+class RunningStatistics
+{
+public:
+  RunningStatistics();
+
+  void update(const double & value);
+
+  uint64_t getCount() const;
+  double getMean() const;
+  double getVariance() const;
+  double getStandardDeviation() const;
+  double getMinimum() const;
+  double getMaximum() const;
+
+private:
+  uint64_t count_;
+  double mean_;
+  double sumOfSquaredDeviations_;
+  double minimum_;
+  double maximum_;
+};
+
+// Exponential moving average of irregularly sampled values, each value
+// weights according to the time elapsed since the previous one
+class ExponentialMovingAverage
+{
+public:
+  explicit ExponentialMovingAverage(const Duration & timeConstant);
+
+  void update(const Duration & stamp, const double & value);
+
+  double getValue() const;
+
+private:
+  double timeConstant_;
+  std::optional<Duration> lastStamp_;
+  double value_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__STREAMINGSTATISTICS_HPP_
@@ -0,0 +1,102 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_GPS__WORKSTEALINGTHREADPOOL_HPP_
+#define ROMEA_CORE_LOCALISATION_GPS__WORKSTEALINGTHREADPOOL_HPP_
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace romea
+{
+namespace core
+{
+
+struct WorkStealingThreadPoolMetrics
+{
+  size_t numberOfThreads;
+  size_t queuedTasks;
+  uint64_t executedTasks;
+  uint64_t stolenTasks;
+};
+
+// Thread pool where each worker owns a task deque. Workers pop their own
+// deque from the back (last submitted first, for cache locality) and steal
+// from the front of the other deques when theirs is empty. Tasks submitted
+// from a worker go to its own deque, other tasks are spread round robin.
+// Yielded tasks go to the front of the deque instead, so that a task which
+// resubmits itself runs after the tasks already queued on its worker (and
+// is the first one to be stolen) rather than starving them.
+class WorkStealingThreadPool
+{
+public:
+  using Task = std::function<void ()>;
+
+  explicit WorkStealingThreadPool(
+    const size_t & numberOfThreads = std::thread::hardware_concurrency());
+
+  WorkStealingThreadPool(const WorkStealingThreadPool &) = delete;
+  WorkStealingThreadPool & operator=(const WorkStealingThreadPool &) = delete;
+
+  // pending tasks are executed before workers are joined
+  ~WorkStealingThreadPool();
+
+  void submit(Task task);
+
+  void yield(Task task);
+
+  size_t getNumberOfThreads() const;
+
+  WorkStealingThreadPoolMetrics getMetrics() const;
+
+private:
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void push_(Task && task, const bool & toFront);
+  void run_(const size_t & workerIndex);
+  bool pop_(const size_t & workerIndex, Task & task);
+  bool steal_(const size_t & workerIndex, Task & task);
+
+private:
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> nextWorker_;
+
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCondition_;
+  std::atomic<size_t> queuedTasks_;
+  std::atomic<size_t> sleepingWorkers_;
+  bool stop_;
+
+  std::atomic<uint64_t> executedTasks_;
+  std::atomic<uint64_t> stolenTasks_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_GPS__WORKSTEALINGTHREADPOOL_HPP_
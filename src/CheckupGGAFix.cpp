@@ -14,6 +14,8 @@
 
 
 // std
+#include <array>
+#include <limits>
 #include <string>
 
 // local
@@ -23,7 +25,30 @@ namespace
 {
 const double MAXIMAL_HORIZONTAL_DILUTION_OF_PRECISION = 5;
 const uint16_t MINIMAL_NUMBER_OF_SATELLITES_TO_COMPUTE_FIX = 6;
-}
+
+const std::array<const char *, romea::core::CheckupGGAFix::NUMBER_OF_REPORT_INFOS>
+REPORT_INFO_NAMES = {
+  "talker",
+  "geoid_height",
+  "altitude_above_geoid",
+  "fix_quality",
+  "number_of_satellites",
+  "hdop",
+  "correction_age",
+  "base_station_id",
+  "latitude",
+  "longitude"
+};
+
+const std::array<const char *, 5> REPORT_MESSAGES = {
+  "GGA fix OK.",
+  "GGA fix is incomplete.",
+  "HDOP is two high.",
+  "Not enough satellites to compute fix.",
+  "Fix quality is too low."
+};
+
+}  // namespace
 
 namespace romea
 {
@@ -33,52 +58,119 @@ namespace core
 //-----------------------------------------------------------------------------
 CheckupGGAFix::CheckupGGAFix(const FixQuality & minimalFixQuality)
 : minimalFixQuality_(minimalFixQuality),
-  report_()
+  mutex_("gga_fix"),
+  report_(),
+  history_("gga_fix", {"fix_quality", "hdop", "number_of_satellites"}),
+  statistics_(),
+  hasLastFrame_(false),
+  lastFrame_(),
+  lastStamp_(Duration::zero())
 {
-  declareReportInfos_();
 }
 
 //-----------------------------------------------------------------------------
-DiagnosticStatus CheckupGGAFix::evaluate(const GGAFrame & ggaFrame)
+DiagnosticStatus CheckupGGAFix::evaluate(
+  const GGAFrame & ggaFrame,
+  const Duration & stamp)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
-  if (checkFrameIsComplete_(ggaFrame)) {
-    checkFixIsReliable_(ggaFrame);
-  }
+  return evaluate_(ggaFrame, stamp, true);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupGGAFix::replay(
+  const GGAFrame & ggaFrame,
+  const Duration & stamp)
+{
+  return evaluate_(ggaFrame, stamp, false);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupGGAFix::evaluate_(
+  const GGAFrame & ggaFrame,
+  const Duration & stamp,
+  const bool & updateStatistics)
+{
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  report_.clearDiagnostics();
+  check_(ggaFrame, minimalFixQuality_, report_);
 
   setReportInfos_(ggaFrame);
-  return worseStatus(report_.diagnostics);
+  DiagnosticStatus status = report_.worseStatus();
+  recordHistory_(stamp, status, ggaFrame);
+  if (updateStatistics) {
+    statistics_.update(stamp, ggaFrame, status);
+  }
+  hasLastFrame_ = true;
+  lastFrame_ = ggaFrame;
+  lastStamp_ = stamp;
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupGGAFix::check(
+  const GGAFrame & ggaFrame,
+  const FixQuality & minimalFixQuality)
+{
+  CompactReport report;
+  check_(ggaFrame, minimalFixQuality, report);
+  return report.worseStatus();
+}
+
+//-----------------------------------------------------------------------------
+void CheckupGGAFix::check_(
+  const GGAFrame & ggaFrame,
+  const FixQuality & minimalFixQuality,
+  CompactReport & report)
+{
+  if (checkFrameIsComplete_(ggaFrame, report)) {
+    checkFixIsReliable_(ggaFrame, minimalFixQuality, report);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void CheckupGGAFix::recordHistory_(
+  const Duration & stamp,
+  const DiagnosticStatus & status,
+  const GGAFrame & ggaFrame)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  history_.record(
+    stamp, status,
+    ggaFrame.fixQuality ? static_cast<int>(*ggaFrame.fixQuality) : nan,
+    ggaFrame.horizontalDilutionOfPrecision.value_or(nan),
+    ggaFrame.numberSatellitesUsedToComputeFix ? *ggaFrame.numberSatellitesUsedToComputeFix : nan);
 }
 
 
 //-----------------------------------------------------------------------------
 void CheckupGGAFix::setReportInfos_(const GGAFrame & ggaFrame)
 {
-  setReportInfo(report_, "talker", ggaFrame.talkerId);
-  setReportInfo(report_, "geoid_height", ggaFrame.geoidHeight);
-  setReportInfo(report_, "altitude_above_geoid", ggaFrame.altitudeAboveGeoid);
-  setReportInfo(report_, "fix_quality", ggaFrame.fixQuality);
-  setReportInfo(report_, "number_of_satellites", ggaFrame.numberSatellitesUsedToComputeFix);
-  setReportInfo(report_, "hdop", ggaFrame.horizontalDilutionOfPrecision);
-  setReportInfo(report_, "correction_age", ggaFrame.dgpsCorrectionAgeInSecond);
-  setReportInfo(report_, "base_station_id", ggaFrame.dgpsStationIdNumber);
+  report_.setInfo(TALKER, ggaFrame.talkerId);
+  report_.setInfo(GEOID_HEIGHT, ggaFrame.geoidHeight);
+  report_.setInfo(ALTITUDE_ABOVE_GEOID, ggaFrame.altitudeAboveGeoid);
+  report_.setInfo(FIX_QUALITY, ggaFrame.fixQuality);
+  report_.setInfo(NUMBER_OF_SATELLITES, ggaFrame.numberSatellitesUsedToComputeFix);
+  report_.setInfo(HDOP, ggaFrame.horizontalDilutionOfPrecision);
+  report_.setInfo(CORRECTION_AGE, ggaFrame.dgpsCorrectionAgeInSecond);
+  report_.setInfo(BASE_STATION_ID, ggaFrame.dgpsStationIdNumber);
 
   if (ggaFrame.latitude) {
-    setReportInfo(report_, "latitude", (*ggaFrame.latitude).toDouble());
+    report_.setInfo(LATITUDE, (*ggaFrame.latitude).toDouble());
   } else {
-    setReportInfo(report_, "latitude", ggaFrame.latitude);
+    report_.setInfo(LATITUDE, std::optional<double>());
   }
 
   if (ggaFrame.longitude) {
-    setReportInfo(report_, "longitude", (*ggaFrame.longitude).toDouble());
+    report_.setInfo(LONGITUDE, (*ggaFrame.longitude).toDouble());
   } else {
-    setReportInfo(report_, "longitude", ggaFrame.longitude);
+    report_.setInfo(LONGITUDE, std::optional<double>());
   }
 }
 
 //-----------------------------------------------------------------------------
-bool CheckupGGAFix::checkFrameIsComplete_(const GGAFrame & ggaFrame)
+bool CheckupGGAFix::checkFrameIsComplete_(
+  const GGAFrame & ggaFrame,
+  CompactReport & report)
 {
   if (ggaFrame.latitude &&
     ggaFrame.longitude &&
@@ -90,97 +182,142 @@ bool CheckupGGAFix::checkFrameIsComplete_(const GGAFrame & ggaFrame)
   {
     return true;
   } else {
-    addDiagnostic_(DiagnosticStatus::ERROR, "GGA fix is incomplete.");
+    report.addDiagnostic(DiagnosticStatus::ERROR, FIX_INCOMPLETE);
     return false;
   }
 }
 
 //-----------------------------------------------------------------------------
-void CheckupGGAFix::checkFixIsReliable_(const GGAFrame & ggaFrame)
+void CheckupGGAFix::checkFixIsReliable_(
+  const GGAFrame & ggaFrame,
+  const FixQuality & minimalFixQuality,
+  CompactReport & report)
 {
   if (*ggaFrame.fixQuality == FixQuality::SIMULATION_FIX ||
-    (checkHorizontalDilutionOfPrecision_(ggaFrame) &
-    checkNumberSatellitesUsedToComputeFix_(ggaFrame) &
-    checkFixQuality_(ggaFrame)))
+    (checkHorizontalDilutionOfPrecision_(ggaFrame, report) &
+    checkNumberSatellitesUsedToComputeFix_(ggaFrame, report) &
+    checkFixQuality_(ggaFrame, minimalFixQuality, report)))
   {
-    addDiagnostic_(DiagnosticStatus::OK, "GGA fix OK.");
+    report.addDiagnostic(DiagnosticStatus::OK, FIX_OK);
   }
 }
 
 
 //-----------------------------------------------------------------------------
-bool CheckupGGAFix::checkHorizontalDilutionOfPrecision_(const GGAFrame & ggaFrame)
+bool CheckupGGAFix::checkHorizontalDilutionOfPrecision_(
+  const GGAFrame & ggaFrame,
+  CompactReport & report)
 {
   if (*ggaFrame.horizontalDilutionOfPrecision <
     MAXIMAL_HORIZONTAL_DILUTION_OF_PRECISION)
   {
     return true;
   } else {
-    addDiagnostic_(DiagnosticStatus::WARN, "HDOP is two high.");
+    report.addDiagnostic(DiagnosticStatus::WARN, HDOP_TOO_HIGH);
     return false;
   }
 }
 
 //-----------------------------------------------------------------------------
-bool CheckupGGAFix::checkNumberSatellitesUsedToComputeFix_(const GGAFrame & ggaFrame)
+bool CheckupGGAFix::checkNumberSatellitesUsedToComputeFix_(
+  const GGAFrame & ggaFrame,
+  CompactReport & report)
 {
   if (*ggaFrame.numberSatellitesUsedToComputeFix >=
     MINIMAL_NUMBER_OF_SATELLITES_TO_COMPUTE_FIX)
   {
     return true;
   } else {
-    addDiagnostic_(DiagnosticStatus::WARN, "Not enough satellites to compute fix.");
+    report.addDiagnostic(DiagnosticStatus::WARN, NOT_ENOUGH_SATELLITES);
     return false;
   }
 }
 
 //-----------------------------------------------------------------------------
-bool CheckupGGAFix::checkFixQuality_(const GGAFrame & ggaFrame)
+bool CheckupGGAFix::checkFixQuality_(
+  const GGAFrame & ggaFrame,
+  const FixQuality & minimalFixQuality,
+  CompactReport & report)
 {
-  if (*ggaFrame.fixQuality >= minimalFixQuality_) {
+  if (*ggaFrame.fixQuality >= minimalFixQuality) {
     return true;
   } else {
-    addDiagnostic_(DiagnosticStatus::WARN, "Fix quality is too low.");
+    report.addDiagnostic(DiagnosticStatus::WARN, FIX_QUALITY_TOO_LOW);
     return false;
   }
 }
 
 //-----------------------------------------------------------------------------
-void CheckupGGAFix::declareReportInfos_()
+DiagnosticReport CheckupGGAFix::getReport()const
 {
-  setReportInfo(report_, "talker", "");
-  setReportInfo(report_, "geoid_height", "");
-  setReportInfo(report_, "altitude_above_geoid", "");
-  setReportInfo(report_, "fix_quality", "");
-  setReportInfo(report_, "number_of_satellites", "");
-  setReportInfo(report_, "hdop", "");
-  setReportInfo(report_, "correction_age", "");
-  setReportInfo(report_, "base_station_id", "");
-  setReportInfo(report_, "latitude", "");
-  setReportInfo(report_, "longitude", "");
+  using Frame = GGAFrame;
+
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  DiagnosticReport report;
+  for (auto it = report_.beginDiagnostics(); it != report_.endDiagnostics(); ++it) {
+    report.diagnostics.push_back({it->status, REPORT_MESSAGES[it->message]});
+  }
+
+  setReportInfo(report, REPORT_INFO_NAMES[TALKER],
+    report_.getInfo<decltype(Frame::talkerId)>(TALKER));
+  setReportInfo(report, REPORT_INFO_NAMES[GEOID_HEIGHT],
+    report_.getInfo<decltype(Frame::geoidHeight)>(GEOID_HEIGHT));
+  setReportInfo(report, REPORT_INFO_NAMES[ALTITUDE_ABOVE_GEOID],
+    report_.getInfo<decltype(Frame::altitudeAboveGeoid)>(ALTITUDE_ABOVE_GEOID));
+  setReportInfo(report, REPORT_INFO_NAMES[FIX_QUALITY],
+    report_.getInfo<decltype(Frame::fixQuality)>(FIX_QUALITY));
+  setReportInfo(report, REPORT_INFO_NAMES[NUMBER_OF_SATELLITES],
+    report_.getInfo<decltype(Frame::numberSatellitesUsedToComputeFix)>(NUMBER_OF_SATELLITES));
+  setReportInfo(report, REPORT_INFO_NAMES[HDOP],
+    report_.getInfo<decltype(Frame::horizontalDilutionOfPrecision)>(HDOP));
+  setReportInfo(report, REPORT_INFO_NAMES[CORRECTION_AGE],
+    report_.getInfo<decltype(Frame::dgpsCorrectionAgeInSecond)>(CORRECTION_AGE));
+  setReportInfo(report, REPORT_INFO_NAMES[BASE_STATION_ID],
+    report_.getInfo<decltype(Frame::dgpsStationIdNumber)>(BASE_STATION_ID));
+  setReportInfo(report, REPORT_INFO_NAMES[LATITUDE], report_.getInfo<double>(LATITUDE));
+  setReportInfo(report, REPORT_INFO_NAMES[LONGITUDE], report_.getInfo<double>(LONGITUDE));
+  statistics_.appendReportInfos(report);
+  return report;
 }
 
 //-----------------------------------------------------------------------------
-const DiagnosticReport & CheckupGGAFix::getReport()const
+const DiagnosticHistory & CheckupGGAFix::getHistory()const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return report_;
+  return history_;
+}
+
+//-----------------------------------------------------------------------------
+FixStatistics CheckupGGAFix::getStatistics()const
+{
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  return statistics_;
+}
+
+//-----------------------------------------------------------------------------
+bool CheckupGGAFix::getLastFrame(GGAFrame & ggaFrame, Duration & stamp)const
+{
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  if (hasLastFrame_) {
+    ggaFrame = lastFrame_;
+    stamp = lastStamp_;
+  }
+  return hasLastFrame_;
 }
 
 //-----------------------------------------------------------------------------
 void CheckupGGAFix::reset()
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
-  declareReportInfos_();
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  report_.clearDiagnostics();
+  report_.clearInfos();
+  hasLastFrame_ = false;
 }
 
 //-----------------------------------------------------------------------------
-void CheckupGGAFix::addDiagnostic_(const DiagnosticStatus & status, const std::string & message)
+void CheckupGGAFix::resetStatistics()
 {
-  report_.diagnostics.push_back(Diagnostic());
-  report_.diagnostics.back().status = status;
-  report_.diagnostics.back().message = message;
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  statistics_.reset();
 }
 
 }  // namespace core
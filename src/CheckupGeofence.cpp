@@ -0,0 +1,102 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <mutex>
+#include <string>
+#include <utility>
+
+// local
+#include "romea_core_localisation_gps/CheckupGeofence.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+CheckupGeofence::CheckupGeofence(std::shared_ptr<const Geofence> geofence)
+: geofence_(std::move(geofence)),
+  mutex_("geofence"),
+  lastStatus_()
+{
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupGeofence::evaluate(const Eigen::Vector2d & position)
+{
+  // located outside of the lock, the geofence is immutable
+  GeofenceStatus status = geofence_->locate(position);
+
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  lastStatus_ = status;
+  return toDiagnosticStatus_(status);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport CheckupGeofence::getReport()const
+{
+  std::optional<GeofenceStatus> status;
+  {
+    std::lock_guard<ProfiledMutex> lock(mutex_);
+    status = lastStatus_;
+  }
+
+  DiagnosticReport report;
+  if (!status) {
+    return report;
+  }
+
+  const auto & zones = geofence_->getZones();
+  if (status->exclusionZone) {
+    report.diagnostics.push_back(
+      {DiagnosticStatus::ERROR,
+        "Position is inside exclusion zone " + zones[*status->exclusionZone].name + "."});
+  } else if (!status->isInsideFieldBoundary) {
+    report.diagnostics.push_back(
+      {DiagnosticStatus::WARN, "Position is outside field boundaries."});
+  } else {
+    report.diagnostics.push_back(
+      {DiagnosticStatus::OK, "Position is inside field boundaries."});
+  }
+
+  if (status->nearestZone) {
+    setReportInfo(report, "nearest_zone", zones[*status->nearestZone].name);
+    setReportInfo(report, "nearest_zone_distance", status->nearestZoneDistance);
+  }
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+void CheckupGeofence::reset()
+{
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  lastStatus_.reset();
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupGeofence::toDiagnosticStatus_(const GeofenceStatus & status)
+{
+  if (status.exclusionZone) {
+    return DiagnosticStatus::ERROR;
+  } else if (!status.isInsideFieldBoundary) {
+    return DiagnosticStatus::WARN;
+  } else {
+    return DiagnosticStatus::OK;
+  }
+}
+
+}  // namespace core
+}  // namespace romea
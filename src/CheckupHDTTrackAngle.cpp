@@ -14,12 +14,29 @@
 
 
 // std
-#include <sstream>
+#include <array>
+#include <limits>
 #include <string>
 
 // local
 #include "romea_core_localisation_gps/CheckupHDTTrackAngle.hpp"
 
+namespace
+{
+
+const std::array<const char *, romea::core::CheckupHDTTrackAngle::NUMBER_OF_REPORT_INFOS>
+REPORT_INFO_NAMES = {
+  "talker",
+  "track_angle"
+};
+
+const std::array<const char *, 2> REPORT_MESSAGES = {
+  "HDT track angle OK.",
+  "HDT track angle is incomplete."
+};
+
+}  // namespace
+
 namespace romea
 {
 namespace core
@@ -27,70 +44,87 @@ namespace core
 
 //-----------------------------------------------------------------------------
 CheckupHDTTrackAngle::CheckupHDTTrackAngle()
-: mutex_(),
-  report_()
+: mutex_("hdt_track_angle"),
+  report_(),
+  history_("hdt_track_angle", {"track_angle", "", ""})
 {
-  declareReportInfos_();
 }
 
 //-----------------------------------------------------------------------------
-DiagnosticStatus CheckupHDTTrackAngle::evaluate(const HDTFrame & hdtFrame)
+DiagnosticStatus CheckupHDTTrackAngle::evaluate(
+  const HDTFrame & hdtFrame,
+  const Duration & stamp)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  checkFrameIsComplete_(hdtFrame);
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  checkFrameIsComplete_(hdtFrame, report_);
 
   setReportInfos_(hdtFrame);
-  return report_.diagnostics.front().status;
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  DiagnosticStatus status = report_.beginDiagnostics()->status;
+  history_.record(stamp, status, hdtFrame.heading.value_or(nan));
+  return status;
 }
 
 //-----------------------------------------------------------------------------
-const DiagnosticReport & CheckupHDTTrackAngle::getReport() const
+DiagnosticReport CheckupHDTTrackAngle::getReport() const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return report_;
+  using Frame = HDTFrame;
+
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  DiagnosticReport report;
+  for (auto it = report_.beginDiagnostics(); it != report_.endDiagnostics(); ++it) {
+    report.diagnostics.push_back({it->status, REPORT_MESSAGES[it->message]});
+  }
+
+  setReportInfo(report, REPORT_INFO_NAMES[TALKER],
+    report_.getInfo<decltype(Frame::talkerId)>(TALKER));
+  setReportInfo(report, REPORT_INFO_NAMES[TRACK_ANGLE],
+    report_.getInfo<decltype(Frame::heading)>(TRACK_ANGLE));
+  return report;
 }
 
 //-----------------------------------------------------------------------------
-bool CheckupHDTTrackAngle::checkFrameIsComplete_(const HDTFrame & hdtFrame)
+const DiagnosticHistory & CheckupHDTTrackAngle::getHistory() const
 {
-  if (hdtFrame.heading) {
-    setDiagnostic_(DiagnosticStatus::OK, "HDT track angle OK.");
-    return true;
-  } else {
-    setDiagnostic_(DiagnosticStatus::ERROR, "HDT track angle is incomplete.");
-    return false;
-  }
+  return history_;
 }
 
 //-----------------------------------------------------------------------------
-void CheckupHDTTrackAngle::setReportInfos_(const HDTFrame & hdtFrame)
+DiagnosticStatus CheckupHDTTrackAngle::check(const HDTFrame & hdtFrame)
 {
-  setReportInfo(report_, "talker", hdtFrame.talkerId);
-  setReportInfo(report_, "track_angle", hdtFrame.heading);
+  CompactReport report;
+  checkFrameIsComplete_(hdtFrame, report);
+  return report.worseStatus();
 }
 
 //-----------------------------------------------------------------------------
-void CheckupHDTTrackAngle::setDiagnostic_(
-  const DiagnosticStatus & status,
-  const std::string & message)
+bool CheckupHDTTrackAngle::checkFrameIsComplete_(
+  const HDTFrame & hdtFrame,
+  CompactReport & report)
 {
-  report_.diagnostics.clear();
-  report_.diagnostics.push_back({status, message});
+  if (hdtFrame.heading) {
+    report.setDiagnostic(DiagnosticStatus::OK, TRACK_ANGLE_OK);
+    return true;
+  } else {
+    report.setDiagnostic(DiagnosticStatus::ERROR, TRACK_ANGLE_INCOMPLETE);
+    return false;
+  }
 }
 
 //-----------------------------------------------------------------------------
-void CheckupHDTTrackAngle::declareReportInfos_()
+void CheckupHDTTrackAngle::setReportInfos_(const HDTFrame & hdtFrame)
 {
-  setReportInfo(report_, "talker", "");
-  setReportInfo(report_, "track_angle", "");
+  report_.setInfo(TALKER, hdtFrame.talkerId);
+  report_.setInfo(TRACK_ANGLE, hdtFrame.heading);
 }
 
 //-----------------------------------------------------------------------------
 void CheckupHDTTrackAngle::reset()
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
-  declareReportInfos_();
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  report_.clearDiagnostics();
+  report_.clearInfos();
 }
 
 }  // namespace core
@@ -14,12 +14,27 @@
 
 
 // std
+#include <array>
+#include <limits>
 #include <sstream>
 #include <string>
 
 // local
 #include "romea_core_localisation_gps/CheckupRMCTrackAngle.hpp"
 
+namespace
+{
+
+const std::array<const char *, romea::core::CheckupRMCTrackAngle::NUMBER_OF_REPORT_INFOS>
+REPORT_INFO_NAMES = {
+  "talker",
+  "speed_over_ground",
+  "track_angle",
+  "magnetic_deviation"
+};
+
+}  // namespace
+
 namespace romea
 {
 namespace core
@@ -28,54 +43,118 @@ namespace core
 //-----------------------------------------------------------------------------
 CheckupRMCTrackAngle::CheckupRMCTrackAngle(const double & minimalSpeedOverGround)
 : minimalSpeedOverGround_(minimalSpeedOverGround),
-  mutex_(),
-  report_()
+  mutex_("rmc_track_angle"),
+  report_(),
+  history_("rmc_track_angle", {"speed_over_ground", "track_angle", ""})
 {
-  declareReportInfos_();
 }
 
 
 //-----------------------------------------------------------------------------
-DiagnosticStatus CheckupRMCTrackAngle::evaluate(const RMCFrame & rmcFrame)
+DiagnosticStatus CheckupRMCTrackAngle::evaluate(
+  const RMCFrame & rmcFrame,
+  const Duration & stamp)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  if (checkFrameIsComplete_(rmcFrame)) {
-    checkFixIsReliable_(rmcFrame);
-  }
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  check_(rmcFrame, minimalSpeedOverGround_, report_);
   setReportInfos_(rmcFrame);
-  return report_.diagnostics.front().status;
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  DiagnosticStatus status = report_.beginDiagnostics()->status;
+  history_.record(
+    stamp, status,
+    rmcFrame.speedOverGroundInMeterPerSecond.value_or(nan),
+    rmcFrame.trackAngleTrue.value_or(nan));
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupRMCTrackAngle::check(
+  const RMCFrame & rmcFrame,
+  const double & minimalSpeedOverGround)
+{
+  CompactReport report;
+  check_(rmcFrame, minimalSpeedOverGround, report);
+  return report.worseStatus();
+}
+
+//-----------------------------------------------------------------------------
+void CheckupRMCTrackAngle::check_(
+  const RMCFrame & rmcFrame,
+  const double & minimalSpeedOverGround,
+  CompactReport & report)
+{
+  if (checkFrameIsComplete_(rmcFrame, report)) {
+    checkFixIsReliable_(rmcFrame, minimalSpeedOverGround, report);
+  }
 }
 
 //-----------------------------------------------------------------------------
-void CheckupRMCTrackAngle::checkFixIsReliable_(const RMCFrame & rmcFrame)
+void CheckupRMCTrackAngle::checkFixIsReliable_(
+  const RMCFrame & rmcFrame,
+  const double & minimalSpeedOverGround,
+  CompactReport & report)
 {
-  if (*rmcFrame.speedOverGroundInMeterPerSecond < minimalSpeedOverGround_) {
-    std::stringstream msg;
-    msg << "RMC track angle is not reliable ";
-    msg << "because vehicle speed is lower than ";
-    msg << minimalSpeedOverGround_ << " m/s.";
-    setDiagnostic_(DiagnosticStatus::WARN, msg.str());
+  if (*rmcFrame.speedOverGroundInMeterPerSecond < minimalSpeedOverGround) {
+    report.setDiagnostic(DiagnosticStatus::WARN, TRACK_ANGLE_NOT_RELIABLE);
   } else {
-    setDiagnostic_(DiagnosticStatus::OK, "RMC track angle OK.");
+    report.setDiagnostic(DiagnosticStatus::OK, TRACK_ANGLE_OK);
   }
 }
 
 //-----------------------------------------------------------------------------
-const DiagnosticReport & CheckupRMCTrackAngle::getReport() const
+DiagnosticReport CheckupRMCTrackAngle::getReport() const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return report_;
+  using Frame = RMCFrame;
+
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  DiagnosticReport report;
+  for (auto it = report_.beginDiagnostics(); it != report_.endDiagnostics(); ++it) {
+    switch (it->message) {
+      case TRACK_ANGLE_OK:
+        report.diagnostics.push_back({it->status, "RMC track angle OK."});
+        break;
+      case TRACK_ANGLE_INCOMPLETE:
+        report.diagnostics.push_back({it->status, "RMC track angle is incomplete."});
+        break;
+      default:
+        std::stringstream msg;
+        msg << "RMC track angle is not reliable ";
+        msg << "because vehicle speed is lower than ";
+        msg << minimalSpeedOverGround_ << " m/s.";
+        report.diagnostics.push_back({it->status, msg.str()});
+        break;
+    }
+  }
+
+  setReportInfo(report, REPORT_INFO_NAMES[TALKER],
+    report_.getInfo<decltype(Frame::talkerId)>(TALKER));
+  setReportInfo(report, REPORT_INFO_NAMES[SPEED_OVER_GROUND],
+    report_.getInfo<decltype(Frame::speedOverGroundInMeterPerSecond)>(SPEED_OVER_GROUND));
+  setReportInfo(report, REPORT_INFO_NAMES[TRACK_ANGLE],
+    report_.getInfo<decltype(Frame::trackAngleTrue)>(TRACK_ANGLE));
+  setReportInfo(report, REPORT_INFO_NAMES[MAGNETIC_DEVIATION],
+    report_.getInfo<decltype(Frame::magneticDeviation)>(MAGNETIC_DEVIATION));
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+const DiagnosticHistory & CheckupRMCTrackAngle::getHistory() const
+{
+  return history_;
 }
 
 //-----------------------------------------------------------------------------
-bool CheckupRMCTrackAngle::checkFrameIsComplete_(const RMCFrame & rmcFrame)
+bool CheckupRMCTrackAngle::checkFrameIsComplete_(
+  const RMCFrame & rmcFrame,
+  CompactReport & report)
 {
   if (rmcFrame.speedOverGroundInMeterPerSecond &&
     rmcFrame.trackAngleTrue)
   {
     return true;
   } else {
-    setDiagnostic_(DiagnosticStatus::ERROR, "RMC track angle is incomplete.");
+    report.setDiagnostic(DiagnosticStatus::ERROR, TRACK_ANGLE_INCOMPLETE);
     return false;
   }
 }
@@ -83,36 +162,19 @@ bool CheckupRMCTrackAngle::checkFrameIsComplete_(const RMCFrame & rmcFrame)
 //-----------------------------------------------------------------------------
 void CheckupRMCTrackAngle::setReportInfos_(const RMCFrame & rmcFrame)
 {
-  setReportInfo(report_, "talker", rmcFrame.talkerId);
-  setReportInfo(report_, "speed_over_ground", rmcFrame.speedOverGroundInMeterPerSecond);
-  setReportInfo(report_, "track_angle", rmcFrame.trackAngleTrue);
-  setReportInfo(report_, "magnetic_deviation", rmcFrame.magneticDeviation);
+  report_.setInfo(TALKER, rmcFrame.talkerId);
+  report_.setInfo(SPEED_OVER_GROUND, rmcFrame.speedOverGroundInMeterPerSecond);
+  report_.setInfo(TRACK_ANGLE, rmcFrame.trackAngleTrue);
+  report_.setInfo(MAGNETIC_DEVIATION, rmcFrame.magneticDeviation);
 }
 
-//-----------------------------------------------------------------------------
-void CheckupRMCTrackAngle::setDiagnostic_(
-  const DiagnosticStatus & status,
-  const std::string & message)
-{
-  report_.diagnostics.clear();
-  report_.diagnostics.push_back({status, message});
-}
-
-//-----------------------------------------------------------------------------
-void CheckupRMCTrackAngle::declareReportInfos_()
-{
-  setReportInfo(report_, "talker", "");
-  setReportInfo(report_, "speed_over_ground", "");
-  setReportInfo(report_, "track_angle", "");
-  setReportInfo(report_, "magnetic_deviation", "");
-}
 
 //-----------------------------------------------------------------------------
 void CheckupRMCTrackAngle::reset()
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
-  declareReportInfos_();
+  std::lock_guard<ProfiledMutex> lock(mutex_);
+  report_.clearDiagnostics();
+  report_.clearInfos();
 }
 
 }  // namespace core
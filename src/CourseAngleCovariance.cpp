@@ -0,0 +1,82 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// local
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+
+namespace
+{
+const double DEFAULT_COURSE_ANGLE_STD = 20 / 180. * M_PI;
+const double MINIMAL_COURSE_ANGLE_STD = 0.1 / 180. * M_PI;
+const double MAXIMAL_COURSE_ANGLE_STD = M_PI_2;
+
+double clampCourseAngleStd(const double & courseAngleStd)
+{
+  return std::clamp(courseAngleStd, MINIMAL_COURSE_ANGLE_STD, MAXIMAL_COURSE_ANGLE_STD);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+double defaultCourseAngleStd()
+{
+  return DEFAULT_COURSE_ANGLE_STD;
+}
+
+//-----------------------------------------------------------------------------
+double rmcCourseAngleStd(
+  const double & speedOverGround,
+  const double & positionStd,
+  const double & rmcPeriod)
+{
+  if (!std::isfinite(speedOverGround) ||
+    !std::isfinite(positionStd) ||
+    !std::isfinite(rmcPeriod))
+  {
+    return DEFAULT_COURSE_ANGLE_STD;
+  }
+
+  // the track angle is the direction of the displacement between two fixes,
+  // the lateral std of this displacement is sqrt(2) times the fix std
+  double displacement = std::abs(speedOverGround) * rmcPeriod;
+  return clampCourseAngleStd(std::atan2(M_SQRT2 * positionStd, displacement));
+}
+
+//-----------------------------------------------------------------------------
+double hdtCourseAngleStd(
+  const double & antennaBaseline,
+  const double & relativePositionStd)
+{
+  if (!std::isfinite(antennaBaseline) ||
+    !std::isfinite(relativePositionStd) ||
+    antennaBaseline <= 0)
+  {
+    return DEFAULT_COURSE_ANGLE_STD;
+  }
+
+  return clampCourseAngleStd(std::atan2(M_SQRT2 * relativePositionStd, antennaBaseline));
+}
+
+}  // namespace core
+}  // namespace romea
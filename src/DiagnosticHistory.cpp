@@ -0,0 +1,161 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+// local
+#include "romea_core_localisation_gps/DiagnosticHistory.hpp"
+
+namespace
+{
+
+const char * statusName(const romea::core::DiagnosticStatus & status)
+{
+  switch (status) {
+    case romea::core::DiagnosticStatus::OK:
+      return "OK";
+    case romea::core::DiagnosticStatus::WARN:
+      return "WARN";
+    case romea::core::DiagnosticStatus::ERROR:
+      return "ERROR";
+    default:
+      return "STALE";
+  }
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+DiagnosticHistory::DiagnosticHistory(
+  const std::string & name,
+  const ValueNames & valueNames,
+  const size_t & capacity)
+: name_(name),
+  valueNames_(valueNames),
+  capacity_(std::max<size_t>(capacity, 1)),
+  slots_(new Slot[capacity_]),
+  numberOfRecords_(0)
+{
+  for (size_t n = 0; n < capacity_; ++n) {
+    slots_[n].sequence.store(0, std::memory_order_relaxed);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void DiagnosticHistory::record(
+  const Duration & stamp,
+  const DiagnosticStatus & status,
+  const double & value0,
+  const double & value1,
+  const double & value2)
+{
+  // single writer: sequence is cleared while the slot is rewritten
+  // and set to the record number + 1 once the slot is complete
+  uint64_t index = numberOfRecords_.load(std::memory_order_relaxed);
+  Slot & slot = slots_[index % capacity_];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.stamp.store(stamp.count(), std::memory_order_relaxed);
+  slot.status.store(status, std::memory_order_relaxed);
+  slot.values[0].store(value0, std::memory_order_relaxed);
+  slot.values[1].store(value1, std::memory_order_relaxed);
+  slot.values[2].store(value2, std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+
+  numberOfRecords_.store(index + 1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+std::vector<DiagnosticRecord> DiagnosticHistory::getRecords() const
+{
+  uint64_t end = numberOfRecords_.load(std::memory_order_acquire);
+  uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+
+  std::vector<DiagnosticRecord> records;
+  records.reserve(end - begin);
+  for (uint64_t index = begin; index < end; ++index) {
+    const Slot & slot = slots_[index % capacity_];
+
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    DiagnosticRecord record;
+    record.stamp = Duration(slot.stamp.load(std::memory_order_relaxed));
+    record.status = slot.status.load(std::memory_order_relaxed);
+    for (size_t n = 0; n < DiagnosticRecord::NUMBER_OF_VALUES; ++n) {
+      record.values[n] = slot.values[n].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // slot has been overwritten by a newer record during the copy
+    if (sequence != index + 1 ||
+      slot.sequence.load(std::memory_order_relaxed) != index + 1)
+    {
+      continue;
+    }
+
+    records.push_back(record);
+  }
+
+  return records;
+}
+
+//-----------------------------------------------------------------------------
+void DiagnosticHistory::dump(std::ostream & os) const
+{
+  os << "# " << name_ << "\n";
+  os << "stamp,status";
+  for (const auto & valueName : valueNames_) {
+    if (!valueName.empty()) {
+      os << "," << valueName;
+    }
+  }
+  os << "\n";
+
+  for (const auto & record : getRecords()) {
+    os << std::fixed << std::setprecision(9) << durationToSecond(record.stamp);
+    os << std::defaultfloat << std::setprecision(6);
+    os << "," << statusName(record.status);
+    for (size_t n = 0; n < DiagnosticRecord::NUMBER_OF_VALUES; ++n) {
+      if (!valueNames_[n].empty()) {
+        os << "," << record.values[n];
+      }
+    }
+    os << "\n";
+  }
+}
+
+//-----------------------------------------------------------------------------
+const std::string & DiagnosticHistory::getName() const
+{
+  return name_;
+}
+
+//-----------------------------------------------------------------------------
+size_t DiagnosticHistory::capacity() const
+{
+  return capacity_;
+}
+
+}  // namespace core
+}  // namespace romea
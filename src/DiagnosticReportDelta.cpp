@@ -0,0 +1,388 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// local
+#include "romea_core_localisation_gps/DiagnosticReportDelta.hpp"
+
+namespace
+{
+
+const uint8_t DELTA_ENCODING_VERSION = 2;
+const uint8_t HAS_DIAGNOSTICS = 1;
+
+//-----------------------------------------------------------------------------
+void writeVarint(std::vector<uint8_t> & buffer, uint64_t value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+//-----------------------------------------------------------------------------
+void writeFixed64(std::vector<uint8_t> & buffer, const uint64_t & value)
+{
+  for (unsigned int shift = 0; shift < 64; shift += 8) {
+    buffer.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+//-----------------------------------------------------------------------------
+uint64_t drawJournalId()
+{
+  std::random_device device;
+  uint64_t id = 0;
+  while (id == 0) {
+    id = static_cast<uint64_t>(device()) << 32 | device();
+  }
+  return id;
+}
+
+//-----------------------------------------------------------------------------
+void writeString(std::vector<uint8_t> & buffer, const std::string & value)
+{
+  writeVarint(buffer, value.size());
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+//-----------------------------------------------------------------------------
+class Reader
+{
+public:
+  explicit Reader(const std::vector<uint8_t> & buffer)
+  : buffer_(buffer),
+    position_(0)
+  {
+  }
+
+  uint8_t readByte()
+  {
+    if (position_ >= buffer_.size()) {
+      throw std::runtime_error("Diagnostic report delta is truncated.");
+    }
+    return buffer_[position_++];
+  }
+
+  uint64_t readFixed64()
+  {
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 8) {
+      value |= static_cast<uint64_t>(readByte()) << shift;
+    }
+    return value;
+  }
+
+  uint64_t readVarint()
+  {
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = readByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    throw std::runtime_error("Diagnostic report delta contains an invalid varint.");
+  }
+
+  // a size can not exceed the number of remaining bytes
+  size_t readSize()
+  {
+    uint64_t size = readVarint();
+    if (size > buffer_.size() - position_) {
+      throw std::runtime_error("Diagnostic report delta is truncated.");
+    }
+    return static_cast<size_t>(size);
+  }
+
+  std::string readString()
+  {
+    size_t size = readSize();
+    std::string value(buffer_.begin() + position_, buffer_.begin() + position_ + size);
+    position_ += size;
+    return value;
+  }
+
+  bool isAtEnd() const
+  {
+    return position_ == buffer_.size();
+  }
+
+private:
+  const std::vector<uint8_t> & buffer_;
+  size_t position_;
+};
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+bool isFull(const DiagnosticReportDelta & delta)
+{
+  return delta.baseSequence == 0;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<uint8_t> encode(const DiagnosticReportDelta & delta)
+{
+  std::vector<uint8_t> buffer;
+  buffer.push_back(DELTA_ENCODING_VERSION);
+  writeFixed64(buffer, delta.journalId);
+  writeVarint(buffer, delta.baseSequence);
+  writeVarint(buffer, delta.sequence);
+
+  writeVarint(buffer, delta.changedInfos.size());
+  for (const auto & [name, value] : delta.changedInfos) {
+    writeString(buffer, name);
+    writeString(buffer, value);
+  }
+
+  writeVarint(buffer, delta.removedInfos.size());
+  for (const auto & name : delta.removedInfos) {
+    writeString(buffer, name);
+  }
+
+  if (delta.diagnostics) {
+    buffer.push_back(HAS_DIAGNOSTICS);
+    writeVarint(buffer, delta.diagnostics->size());
+    for (const auto & diagnostic : *delta.diagnostics) {
+      buffer.push_back(static_cast<uint8_t>(diagnostic.status));
+      writeString(buffer, diagnostic.message);
+    }
+  } else {
+    buffer.push_back(0);
+  }
+
+  return buffer;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportDelta decodeDiagnosticReportDelta(const std::vector<uint8_t> & buffer)
+{
+  Reader reader(buffer);
+  if (reader.readByte() != DELTA_ENCODING_VERSION) {
+    throw std::runtime_error("Diagnostic report delta encoding version is not supported.");
+  }
+
+  DiagnosticReportDelta delta;
+  delta.journalId = reader.readFixed64();
+  delta.baseSequence = reader.readVarint();
+  delta.sequence = reader.readVarint();
+
+  size_t numberOfChangedInfos = reader.readSize();
+  for (size_t n = 0; n < numberOfChangedInfos; ++n) {
+    std::string name = reader.readString();
+    delta.changedInfos[name] = reader.readString();
+  }
+
+  size_t numberOfRemovedInfos = reader.readSize();
+  for (size_t n = 0; n < numberOfRemovedInfos; ++n) {
+    delta.removedInfos.push_back(reader.readString());
+  }
+
+  if (reader.readByte() == HAS_DIAGNOSTICS) {
+    delta.diagnostics.emplace();
+    size_t numberOfDiagnostics = reader.readSize();
+    for (size_t n = 0; n < numberOfDiagnostics; ++n) {
+      uint8_t status = reader.readByte();
+      if (status > static_cast<uint8_t>(DiagnosticStatus::STALE)) {
+        throw std::runtime_error("Diagnostic report delta contains an invalid status.");
+      }
+      delta.diagnostics->push_back({static_cast<DiagnosticStatus>(status), reader.readString()});
+    }
+  }
+
+  if (!reader.isAtEnd()) {
+    throw std::runtime_error("Diagnostic report delta has trailing bytes.");
+  }
+
+  return delta;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportJournal::DiagnosticReportJournal()
+: id_(drawJournalId()),
+  sequence_(0),
+  infos_(),
+  diagnostics_(),
+  diagnosticsSequence_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DiagnosticReportJournal::update(const DiagnosticReport & report)
+{
+  const uint64_t nextSequence = sequence_ + 1;
+  bool hasChanged = false;
+
+  for (const auto & [name, value] : report.info) {
+    auto it = infos_.find(name);
+    if (it == infos_.end()) {
+      infos_.emplace(name, InfoEntry{value, nextSequence, false});
+      hasChanged = true;
+    } else if (it->second.removed || it->second.value != value) {
+      it->second = InfoEntry{value, nextSequence, false};
+      hasChanged = true;
+    }
+  }
+
+  for (auto & [name, entry] : infos_) {
+    if (!entry.removed && report.info.find(name) == report.info.end()) {
+      entry = InfoEntry{"", nextSequence, true};
+      hasChanged = true;
+    }
+  }
+
+  bool diagnosticsHaveChanged = diagnostics_.size() != report.diagnostics.size();
+  for (auto it1 = diagnostics_.cbegin(), it2 = report.diagnostics.cbegin();
+    !diagnosticsHaveChanged && it1 != diagnostics_.end(); ++it1, ++it2)
+  {
+    diagnosticsHaveChanged = it1->status != it2->status || it1->message != it2->message;
+  }
+
+  if (diagnosticsHaveChanged || diagnosticsSequence_ == 0) {
+    diagnostics_ = report.diagnostics;
+    diagnosticsSequence_ = nextSequence;
+    hasChanged = true;
+  }
+
+  if (hasChanged) {
+    sequence_ = nextSequence;
+  }
+  return sequence_;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportDelta DiagnosticReportJournal::makeDelta(const uint64_t & sinceSequence) const
+{
+  // a receiver ahead of the journal has followed a previous instance of the
+  // sender, it gets the full report
+  DiagnosticReportDelta delta;
+  delta.journalId = id_;
+  delta.baseSequence = sinceSequence <= sequence_ ? sinceSequence : 0;
+  delta.sequence = sequence_;
+
+  for (const auto & [name, entry] : infos_) {
+    if (entry.sequence > delta.baseSequence) {
+      if (entry.removed) {
+        // a full report does not need to list removed infos
+        if (delta.baseSequence != 0) {
+          delta.removedInfos.push_back(name);
+        }
+      } else {
+        delta.changedInfos[name] = entry.value;
+      }
+    }
+  }
+
+  if (diagnosticsSequence_ > delta.baseSequence) {
+    delta.diagnostics = diagnostics_;
+  }
+
+  return delta;
+}
+
+//-----------------------------------------------------------------------------
+const uint64_t & DiagnosticReportJournal::getId() const
+{
+  return id_;
+}
+
+//-----------------------------------------------------------------------------
+const uint64_t & DiagnosticReportJournal::getSequence() const
+{
+  return sequence_;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportDecoder::DiagnosticReportDecoder()
+: journalId_(0),
+  sequence_(0),
+  report_()
+{
+}
+
+//-----------------------------------------------------------------------------
+bool DiagnosticReportDecoder::apply(const DiagnosticReportDelta & delta)
+{
+  if (isFull(delta)) {
+    report_ = DiagnosticReport();
+    journalId_ = delta.journalId;
+  } else if (delta.journalId != journalId_ || delta.sequence < sequence_) {
+    // another journal or sequences going backward: the sender has been
+    // restarted and previous changes belong to its former instance
+    reset_();
+    return false;
+  } else if (delta.baseSequence > sequence_) {
+    return false;
+  } else if (delta.sequence == sequence_) {
+    return true;
+  }
+
+  for (const auto & [name, value] : delta.changedInfos) {
+    report_.info[name] = value;
+  }
+
+  for (const auto & name : delta.removedInfos) {
+    report_.info.erase(name);
+  }
+
+  if (delta.diagnostics) {
+    report_.diagnostics = *delta.diagnostics;
+  }
+
+  sequence_ = delta.sequence;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool DiagnosticReportDecoder::apply(const std::vector<uint8_t> & buffer)
+{
+  return apply(decodeDiagnosticReportDelta(buffer));
+}
+
+//-----------------------------------------------------------------------------
+void DiagnosticReportDecoder::reset_()
+{
+  journalId_ = 0;
+  sequence_ = 0;
+  report_ = DiagnosticReport();
+}
+
+//-----------------------------------------------------------------------------
+const DiagnosticReport & DiagnosticReportDecoder::getReport() const
+{
+  return report_;
+}
+
+//-----------------------------------------------------------------------------
+const uint64_t & DiagnosticReportDecoder::getSequence() const
+{
+  return sequence_;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,273 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <string>
+
+// local
+#include "romea_core_localisation_gps/FixStatistics.hpp"
+
+namespace
+{
+
+const std::array<const char *, romea::core::FixStatistics::NUMBER_OF_FIX_QUALITIES>
+FIX_QUALITY_NAMES = {
+  "invalid_fix",
+  "gps_fix",
+  "dgps_fix",
+  "pps_fix",
+  "rtk_fix",
+  "float_rtk_fix",
+  "estimated_fix",
+  "manual_fix",
+  "simulation_fix"
+};
+
+//-----------------------------------------------------------------------------
+size_t toIndex(const romea::core::FixQuality & fixQuality)
+{
+  return std::min(
+    static_cast<size_t>(fixQuality),
+    romea::core::FixStatistics::NUMBER_OF_FIX_QUALITIES - 1);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+FixStatistics::FixStatistics(
+  const Duration & averagingTimeConstant,
+  const Duration & maximalFrameGap)
+: averagingTimeConstant_(averagingTimeConstant),
+  maximalFrameGap_(maximalFrameGap),
+  hdopStatistics_(),
+  numberOfSatellitesStatistics_(),
+  hdopMovingAverage_(averagingTimeConstant),
+  numberOfSatellitesMovingAverage_(averagingTimeConstant)
+{
+  reset();
+}
+
+//-----------------------------------------------------------------------------
+void FixStatistics::reset()
+{
+  hdopStatistics_ = RunningStatistics();
+  numberOfSatellitesStatistics_ = RunningStatistics();
+  hdopMovingAverage_ = ExponentialMovingAverage(averagingTimeConstant_);
+  numberOfSatellitesMovingAverage_ = ExponentialMovingAverage(averagingTimeConstant_);
+
+  lastStamp_.reset();
+  lastFixQuality_.reset();
+  observedTime_ = Duration::zero();
+  timeInFixQuality_.fill(Duration::zero());
+  timeWithoutFix_ = Duration::zero();
+
+  numberOfFixLosses_ = 0;
+  isFixLost_ = false;
+  fixLossStamp_ = Duration::zero();
+  totalFixLossDuration_ = Duration::zero();
+  maximalFixLossDuration_ = Duration::zero();
+}
+
+//-----------------------------------------------------------------------------
+void FixStatistics::update(
+  const Duration & stamp,
+  const GGAFrame & ggaFrame,
+  const DiagnosticStatus & status)
+{
+  if (lastStamp_ && stamp < *lastStamp_) {
+    return;
+  }
+
+  accumulateTime_(stamp);
+
+  if (status == DiagnosticStatus::OK) {
+    endFixLoss_(stamp);
+  } else {
+    startFixLoss_(stamp);
+  }
+
+  if (ggaFrame.horizontalDilutionOfPrecision) {
+    hdopStatistics_.update(*ggaFrame.horizontalDilutionOfPrecision);
+    hdopMovingAverage_.update(stamp, *ggaFrame.horizontalDilutionOfPrecision);
+  }
+
+  if (ggaFrame.numberSatellitesUsedToComputeFix) {
+    numberOfSatellitesStatistics_.update(*ggaFrame.numberSatellitesUsedToComputeFix);
+    numberOfSatellitesMovingAverage_.update(stamp, *ggaFrame.numberSatellitesUsedToComputeFix);
+  }
+
+  lastStamp_ = stamp;
+  lastFixQuality_ = ggaFrame.fixQuality;
+}
+
+//-----------------------------------------------------------------------------
+void FixStatistics::accumulateTime_(const Duration & stamp)
+{
+  if (!lastStamp_) {
+    return;
+  }
+
+  Duration elapsedTime = stamp - *lastStamp_;
+  Duration creditedTime = std::min(elapsedTime, maximalFrameGap_);
+  observedTime_ += elapsedTime;
+  timeWithoutFix_ += elapsedTime - creditedTime;
+  if (lastFixQuality_) {
+    timeInFixQuality_[toIndex(*lastFixQuality_)] += creditedTime;
+  } else {
+    timeWithoutFix_ += creditedTime;
+  }
+
+  // no frame during the gap, the fix has been lost since the last frame
+  if (elapsedTime > maximalFrameGap_) {
+    startFixLoss_(*lastStamp_);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void FixStatistics::startFixLoss_(const Duration & stamp)
+{
+  if (!isFixLost_) {
+    isFixLost_ = true;
+    fixLossStamp_ = stamp;
+    ++numberOfFixLosses_;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void FixStatistics::endFixLoss_(const Duration & stamp)
+{
+  if (isFixLost_) {
+    isFixLost_ = false;
+    Duration duration = stamp - fixLossStamp_;
+    totalFixLossDuration_ += duration;
+    maximalFixLossDuration_ = std::max(maximalFixLossDuration_, duration);
+  }
+}
+
+//-----------------------------------------------------------------------------
+Duration FixStatistics::getOngoingFixLossDuration_() const
+{
+  return isFixLost_ ? *lastStamp_ - fixLossStamp_ : Duration::zero();
+}
+
+//-----------------------------------------------------------------------------
+const RunningStatistics & FixStatistics::getHDOPStatistics() const
+{
+  return hdopStatistics_;
+}
+
+//-----------------------------------------------------------------------------
+const RunningStatistics & FixStatistics::getNumberOfSatellitesStatistics() const
+{
+  return numberOfSatellitesStatistics_;
+}
+
+//-----------------------------------------------------------------------------
+double FixStatistics::getHDOPMovingAverage() const
+{
+  return hdopMovingAverage_.getValue();
+}
+
+//-----------------------------------------------------------------------------
+double FixStatistics::getNumberOfSatellitesMovingAverage() const
+{
+  return numberOfSatellitesMovingAverage_.getValue();
+}
+
+//-----------------------------------------------------------------------------
+Duration FixStatistics::getObservedTime() const
+{
+  return observedTime_;
+}
+
+//-----------------------------------------------------------------------------
+Duration FixStatistics::getTimeIn(const FixQuality & fixQuality) const
+{
+  return timeInFixQuality_[toIndex(fixQuality)];
+}
+
+//-----------------------------------------------------------------------------
+Duration FixStatistics::getTimeWithoutFix() const
+{
+  return timeWithoutFix_;
+}
+
+//-----------------------------------------------------------------------------
+double FixStatistics::getAvailability(const FixQuality & fixQuality) const
+{
+  if (observedTime_ == Duration::zero()) {
+    return 0.;
+  }
+  return durationToSecond(getTimeIn(fixQuality)) / durationToSecond(observedTime_);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t FixStatistics::getNumberOfFixLosses() const
+{
+  return numberOfFixLosses_;
+}
+
+//-----------------------------------------------------------------------------
+bool FixStatistics::isFixLost() const
+{
+  return isFixLost_;
+}
+
+//-----------------------------------------------------------------------------
+Duration FixStatistics::getTotalFixLossDuration() const
+{
+  return totalFixLossDuration_ + getOngoingFixLossDuration_();
+}
+
+//-----------------------------------------------------------------------------
+Duration FixStatistics::getMaximalFixLossDuration() const
+{
+  return std::max(maximalFixLossDuration_, getOngoingFixLossDuration_());
+}
+
+//-----------------------------------------------------------------------------
+void FixStatistics::appendReportInfos(DiagnosticReport & report) const
+{
+  setReportInfo(report, "hdop_mean", hdopStatistics_.getMean());
+  setReportInfo(report, "hdop_std", hdopStatistics_.getStandardDeviation());
+  setReportInfo(report, "hdop_max", hdopStatistics_.getMaximum());
+  setReportInfo(report, "hdop_moving_average", getHDOPMovingAverage());
+  setReportInfo(report, "number_of_satellites_mean", numberOfSatellitesStatistics_.getMean());
+  setReportInfo(report, "number_of_satellites_min", numberOfSatellitesStatistics_.getMinimum());
+  setReportInfo(
+    report, "number_of_satellites_moving_average", getNumberOfSatellitesMovingAverage());
+
+  setReportInfo(report, "observed_time", durationToSecond(observedTime_));
+  for (size_t index = 0; index < NUMBER_OF_FIX_QUALITIES; ++index) {
+    setReportInfo(
+      report, std::string("time_in_") + FIX_QUALITY_NAMES[index],
+      durationToSecond(timeInFixQuality_[index]));
+  }
+  setReportInfo(report, "time_without_fix", durationToSecond(timeWithoutFix_));
+  setReportInfo(report, "rtk_fix_availability", getAvailability(FixQuality::RTK_FIX));
+
+  setReportInfo(report, "fix_losses", numberOfFixLosses_);
+  setReportInfo(report, "fix_loss_total_duration", durationToSecond(getTotalFixLossDuration()));
+  setReportInfo(report, "fix_loss_max_duration", durationToSecond(getMaximalFixLossDuration()));
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,78 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// local
+#include "romea_core_localisation_gps/GPSObservations.hpp"
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+double computeFixStd(const GGAFrame & ggaFrame, const GPSReceiver & gps)
+{
+  return *ggaFrame.horizontalDilutionOfPrecision * gps.getUERE(*ggaFrame.fixQuality);
+}
+
+//-----------------------------------------------------------------------------
+double makePositionObservation(
+  const GGAFrame & ggaFrame,
+  const ENUConverter & enuConverter,
+  const GPSReceiver & gps,
+  ObservationPosition & positionObs)
+{
+  auto geodeticCoordinates = makeGeodeticCoordinates(
+    (*ggaFrame.latitude).toDouble(),
+    (*ggaFrame.longitude).toDouble(),
+    (*ggaFrame.altitudeAboveGeoid +
+    *ggaFrame.geoidHeight));
+
+  Eigen::Vector3d position = enuConverter.toENU(geodeticCoordinates);
+  double fixStd = computeFixStd(ggaFrame, gps);
+  positionObs.Y(ObservationPosition::POSITION_X) = position.x();
+  positionObs.Y(ObservationPosition::POSITION_Y) = position.y();
+  positionObs.R() = Eigen::Matrix2d::Identity() * fixStd * fixStd;
+  positionObs.levelArm = gps.getAntennaBodyPosition();
+  return fixStd;
+}
+
+//-----------------------------------------------------------------------------
+void makeRMCCourseObservation(
+  const RMCFrame & rmcFrame,
+  const double & linearSpeed,
+  const double & positionStd,
+  const double & rmcPeriod,
+  ObservationCourse & courseObs)
+{
+  double courseAngleStd = rmcCourseAngleStd(
+    *rmcFrame.speedOverGroundInMeterPerSecond, positionStd, rmcPeriod);
+  courseObs.Y() = trackAngleToCourseAngle(*rmcFrame.trackAngleTrue, linearSpeed);
+  courseObs.R() = courseAngleStd * courseAngleStd;
+}
+
+//-----------------------------------------------------------------------------
+void makeHDTCourseObservation(
+  const HDTFrame & hdtFrame,
+  const double & courseAngleStd,
+  ObservationCourse & courseObs)
+{
+  courseObs.Y() = headingToCourseAngle(*hdtFrame.heading);
+  courseObs.R() = courseAngleStd * courseAngleStd;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,100 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+
+// local
+#include "romea_core_localisation_gps/GSTCovarianceCache.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+bool isPositive(const std::optional<double> & value)
+{
+  return value && std::isfinite(*value) && *value > 0;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+GSTCovarianceCache::GSTCovarianceCache(const Duration & maximalAge)
+: maximalAge_(maximalAge),
+  stamp_(),
+  covariance_(Eigen::Matrix2d::Zero()),
+  isAvailable_(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+void GSTCovarianceCache::setMaximalAge(const Duration & maximalAge)
+{
+  maximalAge_ = maximalAge;
+}
+
+//-----------------------------------------------------------------------------
+bool GSTCovarianceCache::update(const Duration & stamp, const GSTFrame & gstFrame)
+{
+  if (isPositive(gstFrame.semiMajorAxisStd) &&
+    isPositive(gstFrame.semiMinorAxisStd) &&
+    gstFrame.semiMajorAxisOrientation &&
+    std::isfinite(*gstFrame.semiMajorAxisOrientation))
+  {
+    // the semi-major axis points to (sin, cos) in the ENU frame and the
+    // semi-minor one to (cos, -sin)
+    double majorVariance = *gstFrame.semiMajorAxisStd * *gstFrame.semiMajorAxisStd;
+    double minorVariance = *gstFrame.semiMinorAxisStd * *gstFrame.semiMinorAxisStd;
+    double s = std::sin(*gstFrame.semiMajorAxisOrientation);
+    double c = std::cos(*gstFrame.semiMajorAxisOrientation);
+    covariance_(0, 0) = majorVariance * s * s + minorVariance * c * c;
+    covariance_(1, 1) = majorVariance * c * c + minorVariance * s * s;
+    covariance_(0, 1) = covariance_(1, 0) = (majorVariance - minorVariance) * s * c;
+  } else if (isPositive(gstFrame.latitudeStd) && isPositive(gstFrame.longitudeStd)) {
+    covariance_(0, 0) = *gstFrame.longitudeStd * *gstFrame.longitudeStd;
+    covariance_(1, 1) = *gstFrame.latitudeStd * *gstFrame.latitudeStd;
+    covariance_(0, 1) = covariance_(1, 0) = 0.;
+  } else {
+    isAvailable_ = false;
+    return false;
+  }
+
+  stamp_ = stamp;
+  isAvailable_ = true;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+const Eigen::Matrix2d * GSTCovarianceCache::find(const Duration & stamp) const
+{
+  if (!isAvailable_ || stamp - stamp_ > maximalAge_ || stamp_ - stamp > maximalAge_) {
+    return nullptr;
+  }
+  return &covariance_;
+}
+
+//-----------------------------------------------------------------------------
+void GSTCovarianceCache::reset()
+{
+  isAvailable_ = false;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,199 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cstring>
+
+// local
+#include "romea_core_localisation_gps/GSVCycleCache.hpp"
+
+namespace
+{
+
+// $GPGSV,3,1,... : talker, total number and number of the sentence
+const size_t TALKER_POSITION = 1;
+const size_t TOTAL_POSITION = 7;
+const size_t NUMBER_POSITION = 9;
+const size_t MINIMAL_SENTENCE_LENGTH = 11;
+
+//-----------------------------------------------------------------------------
+uint8_t readDigit(const std::string & sentence, const size_t & position)
+{
+  char c = sentence[position];
+  return c >= '1' && c <= '9' && sentence[position + 1] == ',' ? c - '0' : 0;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+GSVCycleCache::GSVCycleCache()
+: slots_()
+{
+  for (auto & slot : slots_) {
+    slot.publishedBuffer.store(NO_BUFFER, std::memory_order_relaxed);
+    for (auto & buffer : slot.buffers) {
+      buffer.sequence.store(0, std::memory_order_relaxed);
+      buffer.numberOfSentences.store(0, std::memory_order_relaxed);
+      for (auto & length : buffer.lengths) {
+        length.store(0, std::memory_order_relaxed);
+      }
+    }
+    slot.talker = 0;
+    slot.writtenBuffer = NO_BUFFER;
+    slot.numberOfExpectedSentences = 0;
+    slot.numberOfWrittenSentences = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool GSVCycleCache::update(const std::string & gsvSentence)
+{
+  if (gsvSentence.size() < MINIMAL_SENTENCE_LENGTH ||
+    gsvSentence.size() > MAXIMAL_SENTENCE_LENGTH ||
+    gsvSentence.compare(3, 4, "GSV,") != 0)
+  {
+    return false;
+  }
+
+  uint8_t total = readDigit(gsvSentence, TOTAL_POSITION);
+  uint8_t number = readDigit(gsvSentence, NUMBER_POSITION);
+  uint16_t talker = static_cast<uint8_t>(gsvSentence[TALKER_POSITION]) << 8 |
+    static_cast<uint8_t>(gsvSentence[TALKER_POSITION + 1]);
+
+  Slot * slot = findSlot_(talker);
+  if (total == 0 || number == 0 || number > total || slot == nullptr) {
+    return false;
+  }
+
+  if (number == 1) {
+    // a new cycle overwrites the buffer which is not published, which stays
+    // odd if a previous cycle has been dropped while it was written
+    if (slot->writtenBuffer == NO_BUFFER) {
+      slot->writtenBuffer = slot->publishedBuffer.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+    }
+    Buffer & buffer = slot->buffers[slot->writtenBuffer];
+    uint64_t sequence = buffer.sequence.load(std::memory_order_relaxed);
+    if (sequence % 2 == 0) {
+      buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+    slot->numberOfExpectedSentences = total;
+    slot->numberOfWrittenSentences = 0;
+  } else if (slot->writtenBuffer == NO_BUFFER ||
+    total != slot->numberOfExpectedSentences ||
+    number != slot->numberOfWrittenSentences + 1)
+  {
+    slot->writtenBuffer = NO_BUFFER;
+    return false;
+  }
+
+  Buffer & buffer = slot->buffers[slot->writtenBuffer];
+  std::array<uint64_t, NUMBER_OF_WORDS> words{};
+  std::memcpy(words.data(), gsvSentence.data(), gsvSentence.size());
+  size_t numberOfWords = (gsvSentence.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  for (size_t n = 0; n < numberOfWords; ++n) {
+    buffer.words[number - 1][n].store(words[n], std::memory_order_relaxed);
+  }
+  buffer.lengths[number - 1].store(gsvSentence.size(), std::memory_order_relaxed);
+  slot->numberOfWrittenSentences = number;
+
+  if (number == total) {
+    buffer.numberOfSentences.store(total, std::memory_order_relaxed);
+    buffer.sequence.store(
+      buffer.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    slot->publishedBuffer.store(slot->writtenBuffer, std::memory_order_release);
+    slot->writtenBuffer = NO_BUFFER;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<std::string> GSVCycleCache::getSentences() const
+{
+  std::vector<std::string> sentences;
+  for (const auto & slot : slots_) {
+    readBuffer_(slot, sentences);
+  }
+  return sentences;
+}
+
+//-----------------------------------------------------------------------------
+GSVCycleCache::Slot * GSVCycleCache::findSlot_(const uint16_t & talker)
+{
+  for (auto & slot : slots_) {
+    if (slot.talker == talker) {
+      return &slot;
+    }
+    if (slot.talker == 0) {
+      slot.talker = talker;
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool GSVCycleCache::readBuffer_(
+  const Slot & slot,
+  std::vector<std::string> & sentences) const
+{
+  std::array<std::array<uint64_t, NUMBER_OF_WORDS>, MAXIMAL_NUMBER_OF_SENTENCES> words;
+  std::array<uint8_t, MAXIMAL_NUMBER_OF_SENTENCES> lengths;
+
+  while (true) {
+    uint8_t index = slot.publishedBuffer.load(std::memory_order_acquire);
+    if (index == NO_BUFFER) {
+      return false;
+    }
+
+    // an odd sequence means that the buffer is written again since it has
+    // been swapped out after the published index has been read
+    const Buffer & buffer = slot.buffers[index];
+    uint64_t sequence = buffer.sequence.load(std::memory_order_acquire);
+    if (sequence % 2 != 0) {
+      continue;
+    }
+
+    size_t numberOfSentences = buffer.numberOfSentences.load(std::memory_order_relaxed);
+    for (size_t n = 0; n < numberOfSentences; ++n) {
+      // a torn length is discarded with the copy but must stay in bounds
+      lengths[n] = std::min<size_t>(
+        buffer.lengths[n].load(std::memory_order_relaxed), MAXIMAL_SENTENCE_LENGTH);
+      size_t numberOfWords = (lengths[n] + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+      for (size_t m = 0; m < numberOfWords; ++m) {
+        words[n][m] = buffer.words[n][m].load(std::memory_order_relaxed);
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (buffer.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    for (size_t n = 0; n < numberOfSentences; ++n) {
+      sentences.emplace_back(reinterpret_cast<const char *>(words[n].data()), lengths[n]);
+    }
+    return true;
+  }
+}
+
+}  // namespace core
+}  // namespace romea
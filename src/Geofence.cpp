@@ -0,0 +1,338 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// local
+#include "romea_core_localisation_gps/Geofence.hpp"
+
+namespace
+{
+
+const int64_t MAXIMAL_NUMBER_OF_CELLS = 1 << 22;
+
+//-----------------------------------------------------------------------------
+double cross(const Eigen::Vector2d & u, const Eigen::Vector2d & v)
+{
+  return u.x() * v.y() - u.y() * v.x();
+}
+
+//-----------------------------------------------------------------------------
+// even-odd rule with an horizontal ray
+bool isInsidePolygon(const std::vector<Eigen::Vector2d> & polygon, const Eigen::Vector2d & point)
+{
+  bool isInside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const Eigen::Vector2d & a = polygon[i];
+    const Eigen::Vector2d & b = polygon[j];
+    if ((a.y() > point.y()) != (b.y() > point.y()) &&
+      point.x() < (b.x() - a.x()) * (point.y() - a.y()) / (b.y() - a.y()) + a.x())
+    {
+      isInside = !isInside;
+    }
+  }
+  return isInside;
+}
+
+//-----------------------------------------------------------------------------
+// vertices are counted on one side only so that a segment crossing the
+// polygon through a vertex flips the parity once
+bool crosses(
+  const Eigen::Vector2d & a,
+  const Eigen::Vector2d & b,
+  const Eigen::Vector2d & c,
+  const Eigen::Vector2d & d)
+{
+  return (cross(d - c, a - c) > 0) != (cross(d - c, b - c) > 0) &&
+         (cross(b - a, c - a) > 0) != (cross(b - a, d - a) > 0);
+}
+
+//-----------------------------------------------------------------------------
+double distanceToSegment(
+  const Eigen::Vector2d & point,
+  const Eigen::Vector2d & a,
+  const Eigen::Vector2d & b)
+{
+  Eigen::Vector2d ab = b - a;
+  double squaredLength = ab.squaredNorm();
+  double t = squaredLength > 0 ? std::clamp((point - a).dot(ab) / squaredLength, 0., 1.) : 0.;
+  return (a + t * ab - point).norm();
+}
+
+//-----------------------------------------------------------------------------
+// Liang-Barsky clipping of the segment by the box
+bool intersectsBox(
+  const Eigen::Vector2d & a,
+  const Eigen::Vector2d & b,
+  const Eigen::Vector2d & minimum,
+  const Eigen::Vector2d & maximum)
+{
+  double t0 = 0;
+  double t1 = 1;
+  Eigen::Vector2d direction = b - a;
+  for (int axis = 0; axis < 2; ++axis) {
+    if (direction[axis] == 0) {
+      if (a[axis] < minimum[axis] || a[axis] > maximum[axis]) {
+        return false;
+      }
+      continue;
+    }
+    double ta = (minimum[axis] - a[axis]) / direction[axis];
+    double tb = (maximum[axis] - a[axis]) / direction[axis];
+    t0 = std::max(t0, std::min(ta, tb));
+    t1 = std::min(t1, std::max(ta, tb));
+    if (t0 > t1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+Geofence::Geofence(std::vector<GeofenceZone> zones, const double & cellSize)
+: zones_(std::move(zones)),
+  cellSize_(cellSize),
+  origin_(Eigen::Vector2d::Zero()),
+  numberOfColumns_(0),
+  numberOfRows_(0),
+  cells_(),
+  hasFieldBoundary_(false)
+{
+  for (const auto & zone : zones_) {
+    if (zone.polygon.size() < 3) {
+      throw std::invalid_argument("Geofence zone " + zone.name + " has less than 3 vertices.");
+    }
+    hasFieldBoundary_ |= zone.type == GeofenceZone::Type::FIELD_BOUNDARY;
+  }
+
+  build_();
+}
+
+//-----------------------------------------------------------------------------
+void Geofence::build_()
+{
+  if (zones_.empty()) {
+    return;
+  }
+
+  Eigen::Vector2d minimum = zones_.front().polygon.front();
+  Eigen::Vector2d maximum = minimum;
+  size_t numberOfEdges = 0;
+  for (const auto & zone : zones_) {
+    for (const auto & vertex : zone.polygon) {
+      minimum = minimum.cwiseMin(vertex);
+      maximum = maximum.cwiseMax(vertex);
+    }
+    numberOfEdges += zone.polygon.size();
+  }
+
+  Eigen::Vector2d extent = maximum - minimum;
+  if (cellSize_ <= 0) {
+    // about one edge per cell
+    cellSize_ = std::max(
+      std::sqrt(extent.x() * extent.y() / numberOfEdges),
+      std::max(extent.maxCoeff() / 1024., 1e-3));
+  }
+
+  origin_ = minimum;
+  numberOfColumns_ = static_cast<int64_t>(extent.x() / cellSize_) + 1;
+  numberOfRows_ = static_cast<int64_t>(extent.y() / cellSize_) + 1;
+  if (numberOfColumns_ * numberOfRows_ > MAXIMAL_NUMBER_OF_CELLS) {
+    throw std::invalid_argument("Geofence cell size is too small for the zones extent.");
+  }
+  cells_.resize(numberOfColumns_ * numberOfRows_);
+
+  for (size_t z = 0; z < zones_.size(); ++z) {
+    const auto & polygon = zones_[z].polygon;
+
+    Eigen::Vector2d zoneMinimum = polygon.front();
+    Eigen::Vector2d zoneMaximum = zoneMinimum;
+    for (const auto & vertex : polygon) {
+      zoneMinimum = zoneMinimum.cwiseMin(vertex);
+      zoneMaximum = zoneMaximum.cwiseMax(vertex);
+    }
+
+    int64_t firstColumn = static_cast<int64_t>((zoneMinimum.x() - origin_.x()) / cellSize_);
+    int64_t lastColumn = static_cast<int64_t>((zoneMaximum.x() - origin_.x()) / cellSize_);
+    int64_t firstRow = static_cast<int64_t>((zoneMinimum.y() - origin_.y()) / cellSize_);
+    int64_t lastRow = static_cast<int64_t>((zoneMaximum.y() - origin_.y()) / cellSize_);
+
+    for (int64_t row = firstRow; row <= lastRow; ++row) {
+      for (int64_t column = firstColumn; column <= lastColumn; ++column) {
+        Eigen::Vector2d cellMinimum = origin_ + cellSize_ * Eigen::Vector2d(column, row);
+        Eigen::Vector2d cellMaximum = cellMinimum + Eigen::Vector2d::Constant(cellSize_);
+
+        CellZone cellZone{static_cast<uint32_t>(z), false, {}};
+        for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+          if (intersectsBox(polygon[j], polygon[i], cellMinimum, cellMaximum)) {
+            cellZone.edges.push_back({polygon[j], polygon[i]});
+          }
+        }
+        cellZone.isCenterInside = isInsidePolygon(polygon, cellCenter_(column, row));
+
+        // cells neither crossed by nor inside the zone are left out
+        if (!cellZone.edges.empty() || cellZone.isCenterInside) {
+          cells_[row * numberOfColumns_ + column].push_back(std::move(cellZone));
+        }
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+GeofenceStatus Geofence::locate(const Eigen::Vector2d & position) const
+{
+  GeofenceStatus status;
+  status.isInsideFieldBoundary = !hasFieldBoundary_;
+  status.exclusionZone = std::nullopt;
+  status.nearestZone = std::nullopt;
+  status.nearestZoneDistance = std::numeric_limits<double>::infinity();
+
+  if (cells_.empty() || !position.allFinite()) {
+    return status;
+  }
+
+  // positions outside of the grid are searched from the nearest cell
+  Eigen::Vector2d coordinates = ((position - origin_) / cellSize_).array().floor();
+  int64_t column = static_cast<int64_t>(
+    std::clamp(coordinates.x(), 0., static_cast<double>(numberOfColumns_ - 1)));
+  int64_t row = static_cast<int64_t>(
+    std::clamp(coordinates.y(), 0., static_cast<double>(numberOfRows_ - 1)));
+
+  // the grid covers every zone, a position outside of it is in none
+  if (coordinates.x() == column && coordinates.y() == row) {
+    Eigen::Vector2d center = cellCenter_(column, row);
+    for (const auto & cellZone : cell_(column, row)) {
+      if (isInside_(cellZone, position, center)) {
+        if (zones_[cellZone.zone].type == GeofenceZone::Type::FIELD_BOUNDARY) {
+          status.isInsideFieldBoundary = true;
+        } else if (!status.exclusionZone) {
+          status.exclusionZone = cellZone.zone;
+        }
+      }
+    }
+  }
+
+  // rings of cells around the cell of the position are visited until the
+  // unvisited ones are farther than the nearest boundary found so far
+  for (int64_t ring = 0; ; ++ring) {
+    int64_t firstRow = std::max<int64_t>(row - ring, 0);
+    int64_t lastRow = std::min(row + ring, numberOfRows_ - 1);
+    for (int64_t r = firstRow; r <= lastRow; ++r) {
+      bool isRingRow = r == row - ring || r == row + ring;
+      int64_t step = isRingRow || ring == 0 ? 1 : 2 * ring;
+      for (int64_t c = column - ring; c <= column + ring; c += step) {
+        if (c < 0 || c >= numberOfColumns_) {
+          continue;
+        }
+        for (const auto & cellZone : cell_(c, r)) {
+          for (const auto & edge : cellZone.edges) {
+            double distance = distanceToSegment(position, edge.begin, edge.end);
+            if (distance < status.nearestZoneDistance) {
+              status.nearestZoneDistance = distance;
+              status.nearestZone = cellZone.zone;
+            }
+          }
+        }
+      }
+    }
+
+    if (status.nearestZoneDistance <= distanceToRing_(position, column, row, ring + 1)) {
+      break;
+    }
+  }
+
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+double Geofence::distanceToRing_(
+  const Eigen::Vector2d & position,
+  const int64_t & column,
+  const int64_t & row,
+  const int64_t & ring) const
+{
+  // lower bound given by the sides of the ring which are in the grid,
+  // infinite once the grid has been entirely visited
+  double distance = std::numeric_limits<double>::infinity();
+  if (column + ring < numberOfColumns_) {
+    distance = std::min(distance, origin_.x() + (column + ring) * cellSize_ - position.x());
+  }
+  if (column - ring >= 0) {
+    distance = std::min(distance, position.x() - origin_.x() - (column - ring + 1) * cellSize_);
+  }
+  if (row + ring < numberOfRows_) {
+    distance = std::min(distance, origin_.y() + (row + ring) * cellSize_ - position.y());
+  }
+  if (row - ring >= 0) {
+    distance = std::min(distance, position.y() - origin_.y() - (row - ring + 1) * cellSize_);
+  }
+  return std::max(distance, 0.);
+}
+
+//-----------------------------------------------------------------------------
+bool Geofence::isInside_(
+  const CellZone & cellZone,
+  const Eigen::Vector2d & position,
+  const Eigen::Vector2d & center) const
+{
+  bool isInside = cellZone.isCenterInside;
+  for (const auto & edge : cellZone.edges) {
+    if (crosses(edge.begin, edge.end, center, position)) {
+      isInside = !isInside;
+    }
+  }
+  return isInside;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::Vector2d Geofence::cellCenter_(const int64_t & column, const int64_t & row) const
+{
+  return origin_ + cellSize_ * Eigen::Vector2d(column + 0.5, row + 0.5);
+}
+
+//-----------------------------------------------------------------------------
+const Geofence::Cell & Geofence::cell_(const int64_t & column, const int64_t & row) const
+{
+  return cells_[row * numberOfColumns_ + column];
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<GeofenceZone> & Geofence::getZones() const
+{
+  return zones_;
+}
+
+//-----------------------------------------------------------------------------
+const double & Geofence::getCellSize() const
+{
+  return cellSize_;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,183 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_gps/HDTCourseStream.hpp"
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+#include "romea_core_localisation_gps/GPSObservations.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+HDTCourseStream::HDTCourseStream(
+  const GPSReceiver & gps,
+  const Parameters & antennaBaseline)
+: courseAngleStd_(hdtCourseAngleStd(antennaBaseline, gps.getUERE(FixQuality::RTK_FIX))),
+  hdtRateDiagnostic_(GPSCheckup::HDT_RATE, "hdt", HDT_RATE),
+  hdtTrackAngleDiagnostic_(),
+  originSequence_(0),
+  originStamp_(0),
+  originCourse_(0),
+  originVariance_(0),
+  predictionSequence_(0),
+  predictionStamp_(Duration::zero()),
+  predictionOriginStamp_(Duration::zero()),
+  predictedCourse_(0),
+  predictionOriginVariance_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+HDTCourseStream::Parameters HDTCourseStream::defaultParameters()
+{
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+//-----------------------------------------------------------------------------
+bool HDTCourseStream::processHDT(
+  const Duration & stamp,
+  const HDTFrame & hdtFrame,
+  StatusTransitionNotifier & notifier,
+  ObservationCourse & courseObs)
+{
+  if (hdtRateDiagnostic_.evaluate(stamp, notifier) != DiagnosticStatus::OK) {
+    return false;
+  }
+
+  DiagnosticStatus status = hdtTrackAngleDiagnostic_.evaluate(hdtFrame, stamp);
+  notifier.update(GPSCheckup::HDT_TRACK_ANGLE, stamp, status);
+
+  if (status == DiagnosticStatus::OK) {
+    makeHDTCourseObservation(hdtFrame, courseAngleStd_, courseObs);
+
+    uint64_t sequence = originSequence_.load(std::memory_order_relaxed);
+    originSequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    originStamp_.store(stamp.count(), std::memory_order_relaxed);
+    originCourse_.store(courseObs.Y(), std::memory_order_relaxed);
+    originVariance_.store(courseObs.R(), std::memory_order_relaxed);
+    originSequence_.store(sequence + 2, std::memory_order_release);
+    return true;
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+bool HDTCourseStream::processYawRate(
+  const Duration & stamp,
+  const double & yawRate,
+  ObservationCourse & courseObs)
+{
+  if (!std::isfinite(yawRate)) {
+    return false;
+  }
+
+  uint64_t sequence = originSequence_.load(std::memory_order_acquire);
+  if (sequence != predictionSequence_ && sequence % 2 == 0) {
+    Duration originStamp(originStamp_.load(std::memory_order_relaxed));
+    double originCourse = originCourse_.load(std::memory_order_relaxed);
+    double originVariance = originVariance_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // the origin is only taken when it has not been overwritten meanwhile,
+    // otherwise prediction goes on from the previous one
+    if (originSequence_.load(std::memory_order_relaxed) == sequence) {
+      predictionSequence_ = sequence;
+      predictionStamp_ = originStamp;
+      predictionOriginStamp_ = originStamp;
+      predictedCourse_ = originCourse;
+      predictionOriginVariance_ = originVariance;
+    }
+  }
+
+  if (predictionSequence_ == 0 || stamp < predictionStamp_) {
+    return false;
+  }
+
+  double elapsedTime = durationToSecond(stamp - predictionOriginStamp_);
+  if (elapsedTime > MAXIMAL_PREDICTION_DURATION) {
+    return false;
+  }
+
+  predictedCourse_ = std::remainder(
+    predictedCourse_ + yawRate * durationToSecond(stamp - predictionStamp_), 2 * M_PI);
+  predictionStamp_ = stamp;
+
+  double driftStd = YAW_RATE_BIAS_STD * elapsedTime;
+  courseObs.Y() = predictedCourse_;
+  courseObs.R() = predictionOriginVariance_ + driftStd * driftStd;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::checkHeartBeats(
+  const Duration & stamp,
+  StatusTransitionNotifier & notifier)
+{
+  if (!hdtRateDiagnostic_.checkHeartBeat(stamp, notifier)) {
+    hdtTrackAngleDiagnostic_.reset();
+    notifier.update(GPSCheckup::HDT_TRACK_ANGLE, stamp, std::nullopt);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::appendOdometryReport(DiagnosticReport & /*report*/) const
+{
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::appendReport(DiagnosticReport & report) const
+{
+  report += hdtRateDiagnostic_.getReport();
+  report += hdtTrackAngleDiagnostic_.getReport();
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::dumpOdometryHistory(std::ostream & /*os*/) const
+{
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::dumpHistory(std::ostream & os) const
+{
+  hdtRateDiagnostic_.getHistory().dump(os);
+  hdtTrackAngleDiagnostic_.getHistory().dump(os);
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::saveSnapshot(PluginSnapshot & snapshot) const
+{
+  snapshot.hdtStamps = hdtRateDiagnostic_.getLastStamps(PluginSnapshot::NUMBER_OF_RATE_STAMPS);
+}
+
+//-----------------------------------------------------------------------------
+void HDTCourseStream::restoreSnapshot(
+  const PluginSnapshot & snapshot,
+  const Duration & shift,
+  StatusTransitionNotifier & notifier)
+{
+  hdtRateDiagnostic_.replay(snapshot.hdtStamps, shift, notifier);
+}
+
+}  // namespace core
+}  // namespace romea
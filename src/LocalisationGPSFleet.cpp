@@ -0,0 +1,317 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// local
+#include "romea_core_localisation_gps/LocalisationGPSFleet.hpp"
+#include "romea_core_localisation_gps/NMEASentenceClassifier.hpp"
+
+namespace
+{
+
+void updateMaximum(std::atomic<size_t> & maximum, const size_t & value)
+{
+  size_t current = maximum.load(std::memory_order_relaxed);
+  while (value > current &&
+    !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+LocalisationGPSFleet::LocalisationGPSFleet(
+  const size_t & numberOfThreads,
+  const size_t & maximalBatchSize,
+  const size_t & vehicleQueueCapacity)
+: maximalBatchSize_(std::max<size_t>(maximalBatchSize, 1)),
+  vehicleQueueCapacity_(std::max<size_t>(vehicleQueueCapacity, 1)),
+  vehiclesMutex_(),
+  vehicles_(),
+  positionCallback_(),
+  courseCallback_(),
+  startTime_(std::chrono::steady_clock::now()),
+  postedInputs_(0),
+  processedInputs_(0),
+  rejectedInputs_(0),
+  failedInputs_(0),
+  positionObservations_(0),
+  courseObservations_(0),
+  pendingInputs_(0),
+  maximalVehicleQueueLength_(0),
+  idleMutex_(),
+  idleCondition_(),
+  pool_(numberOfThreads)
+{
+}
+
+//-----------------------------------------------------------------------------
+LocalisationGPSFleet::~LocalisationGPSFleet()
+{
+  waitUntilIdle();
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::addVehicle(
+  const VehicleId & vehicleId,
+  std::unique_ptr<LocalisationSingleAntennaGPSPlugin> plugin)
+{
+  auto vehicle = std::make_unique<Vehicle>();
+  vehicle->id = vehicleId;
+  vehicle->singleAntennaPlugin = plugin.get();
+  vehicle->dualAntennaPlugin = nullptr;
+  vehicle->plugin = std::move(plugin);
+  addVehicle_(std::move(vehicle));
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::addVehicle(
+  const VehicleId & vehicleId,
+  std::unique_ptr<LocalisationDualAntennaGPSPlugin> plugin)
+{
+  auto vehicle = std::make_unique<Vehicle>();
+  vehicle->id = vehicleId;
+  vehicle->singleAntennaPlugin = nullptr;
+  vehicle->dualAntennaPlugin = plugin.get();
+  vehicle->plugin = std::move(plugin);
+  addVehicle_(std::move(vehicle));
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::addVehicle_(std::unique_ptr<Vehicle> vehicle)
+{
+  vehicle->isScheduled = false;
+
+  std::unique_lock<std::shared_mutex> lock(vehiclesMutex_);
+  if (!vehicles_.emplace(vehicle->id, nullptr).second) {
+    throw std::invalid_argument(
+            "Vehicle " + std::to_string(vehicle->id) + " is already in the fleet");
+  }
+  vehicles_[vehicle->id] = std::move(vehicle);
+}
+
+//-----------------------------------------------------------------------------
+LocalisationGPSPluginBase * LocalisationGPSFleet::getPlugin(const VehicleId & vehicleId)
+{
+  Vehicle * vehicle = findVehicle_(vehicleId);
+  return vehicle != nullptr ? vehicle->plugin.get() : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::setPositionCallback(const PositionCallback & callback)
+{
+  positionCallback_ = callback;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::setCourseCallback(const CourseCallback & callback)
+{
+  courseCallback_ = callback;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSFleet::postSentence(
+  const VehicleId & vehicleId,
+  const Duration & stamp,
+  const std::string & sentence)
+{
+  Vehicle * vehicle = findVehicle_(vehicleId);
+  if (vehicle != nullptr) {
+    switch (classifyNMEASentence(sentence)) {
+      case NMEASentenceType::GGA:
+      case NMEASentenceType::GST:
+      case NMEASentenceType::GSV:
+        return post_(vehicle, {InputType::SENTENCE, stamp, sentence, 0.});
+      case NMEASentenceType::RMC:
+        if (vehicle->singleAntennaPlugin) {
+          return post_(vehicle, {InputType::SENTENCE, stamp, sentence, 0.});
+        }
+        break;
+      case NMEASentenceType::HDT:
+        if (vehicle->dualAntennaPlugin) {
+          return post_(vehicle, {InputType::SENTENCE, stamp, sentence, 0.});
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  rejectedInputs_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSFleet::postLinearSpeed(
+  const VehicleId & vehicleId,
+  const Duration & stamp,
+  const double & linearSpeed)
+{
+  Vehicle * vehicle = findVehicle_(vehicleId);
+  if (vehicle != nullptr && vehicle->singleAntennaPlugin) {
+    return post_(vehicle, {InputType::LINEAR_SPEED, stamp, std::string(), linearSpeed});
+  }
+
+  rejectedInputs_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::waitUntilIdle()
+{
+  std::unique_lock<std::mutex> lock(idleMutex_);
+  idleCondition_.wait(lock, [this] {return pendingInputs_.load() == 0;});
+}
+
+//-----------------------------------------------------------------------------
+LocalisationGPSFleetMetrics LocalisationGPSFleet::getMetrics() const
+{
+  LocalisationGPSFleetMetrics metrics;
+  {
+    std::shared_lock<std::shared_mutex> lock(vehiclesMutex_);
+    metrics.numberOfVehicles = vehicles_.size();
+  }
+  metrics.postedInputs = postedInputs_.load(std::memory_order_relaxed);
+  metrics.processedInputs = processedInputs_.load(std::memory_order_relaxed);
+  metrics.rejectedInputs = rejectedInputs_.load(std::memory_order_relaxed);
+  metrics.failedInputs = failedInputs_.load(std::memory_order_relaxed);
+  metrics.positionObservations = positionObservations_.load(std::memory_order_relaxed);
+  metrics.courseObservations = courseObservations_.load(std::memory_order_relaxed);
+  metrics.pendingInputs = pendingInputs_.load(std::memory_order_relaxed);
+  metrics.maximalVehicleQueueLength = maximalVehicleQueueLength_.load(std::memory_order_relaxed);
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime_;
+  metrics.throughput = elapsed.count() > 0 ? metrics.processedInputs / elapsed.count() : 0.;
+  metrics.pool = pool_.getMetrics();
+  return metrics;
+}
+
+//-----------------------------------------------------------------------------
+LocalisationGPSFleet::Vehicle * LocalisationGPSFleet::findVehicle_(
+  const VehicleId & vehicleId) const
+{
+  std::shared_lock<std::shared_mutex> lock(vehiclesMutex_);
+  auto it = vehicles_.find(vehicleId);
+  return it != vehicles_.end() ? it->second.get() : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSFleet::post_(Vehicle * vehicle, Input && input)
+{
+  bool mustBeScheduled = false;
+  {
+    std::lock_guard<std::mutex> lock(vehicle->mutex);
+    if (vehicle->inputs.size() >= vehicleQueueCapacity_) {
+      rejectedInputs_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    pendingInputs_.fetch_add(1);
+    postedInputs_.fetch_add(1, std::memory_order_relaxed);
+    vehicle->inputs.push_back(std::move(input));
+    updateMaximum(maximalVehicleQueueLength_, vehicle->inputs.size());
+    mustBeScheduled = !vehicle->isScheduled;
+    vehicle->isScheduled = true;
+  }
+
+  // a vehicle is owned by at most one task, which keeps its inputs ordered
+  if (mustBeScheduled) {
+    pool_.submit([this, vehicle] {processVehicle_(vehicle);});
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::processVehicle_(Vehicle * vehicle)
+{
+  for (size_t n = 0; n < maximalBatchSize_; ++n) {
+    Input input;
+    {
+      std::lock_guard<std::mutex> lock(vehicle->mutex);
+      if (vehicle->inputs.empty()) {
+        vehicle->isScheduled = false;
+        return;
+      }
+      input = std::move(vehicle->inputs.front());
+      vehicle->inputs.pop_front();
+    }
+
+    try {
+      processInput_(*vehicle, input);
+    } catch (const std::exception &) {
+      failedInputs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    processedInputs_.fetch_add(1, std::memory_order_relaxed);
+    if (pendingInputs_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(idleMutex_);
+      idleCondition_.notify_all();
+    }
+  }
+
+  // yields to other vehicles, the vehicle is still scheduled
+  pool_.yield([this, vehicle] {processVehicle_(vehicle);});
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSFleet::processInput_(Vehicle & vehicle, const Input & input)
+{
+  switch (input.type) {
+    case InputType::SENTENCE:
+      {
+        // dispatched by the plugin, which counts received sentences
+        NMEASentenceType sentenceType;
+        bool isObservationValid = vehicle.singleAntennaPlugin != nullptr ?
+          vehicle.singleAntennaPlugin->processNMEA(
+          input.stamp, input.sentence, sentenceType, vehicle.positionObs, vehicle.courseObs) :
+          vehicle.dualAntennaPlugin->processNMEA(
+          input.stamp, input.sentence, sentenceType, vehicle.positionObs, vehicle.courseObs);
+
+        if (!isObservationValid) {
+          break;
+        } else if (sentenceType == NMEASentenceType::GGA) {
+          positionObservations_.fetch_add(1, std::memory_order_relaxed);
+          if (positionCallback_) {
+            positionCallback_(vehicle.id, input.stamp, vehicle.positionObs);
+          }
+        } else {
+          courseObservations_.fetch_add(1, std::memory_order_relaxed);
+          if (courseCallback_) {
+            courseCallback_(vehicle.id, input.stamp, vehicle.courseObs);
+          }
+        }
+      }
+      break;
+    case InputType::LINEAR_SPEED:
+      vehicle.singleAntennaPlugin->processLinearSpeed(input.stamp, input.linearSpeed);
+      break;
+  }
+}
+
+}  // namespace core
+}  // namespace romea
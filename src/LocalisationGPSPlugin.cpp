@@ -14,20 +14,23 @@
 
 
 // std
-#include <iostream>
-#include <utility>
-#include <string>
+#include <cmath>
+#include <exception>
 #include <limits>
 #include <memory>
+#include <string>
+#include <utility>
 
 // local
 #include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/GPSObservations.hpp"
+#include "romea_core_localisation_gps/NMEAFieldScanner.hpp"
 
 
 namespace
 {
-const double DEFAULT_COURSE_ANGLE_STD = 20 / 180. * M_PI;
-}
+const double GGA_RATE = 1.0;
+}  // namespace
 
 
 namespace romea
@@ -35,6 +38,10 @@ namespace romea
 namespace core
 {
 
+static_assert(
+  alignof(LocalisationSingleAntennaGPSPlugin) == CACHE_LINE_SIZE &&
+  alignof(LocalisationDualAntennaGPSPlugin) == CACHE_LINE_SIZE,
+  "plugin state must be laid out on separate cache lines per writing thread");
 
 //-----------------------------------------------------------------------------
 LocalisationGPSPluginBase::LocalisationGPSPluginBase(
@@ -42,8 +49,24 @@ LocalisationGPSPluginBase::LocalisationGPSPluginBase(
   const FixQuality & minimalFixQuality)
 : gps_(std::move(gps)),
   enuConverter_(),
-  ggaRateDiagnostic_("gga", 1.0, 0.1),
-  ggaFixDiagnostic_(minimalFixQuality)
+  publisher_(),
+  observationQueue_(),
+  observationSourceId_(0),
+  ggaRateDiagnostic_(GPSCheckup::GGA_RATE, "gga", GGA_RATE),
+  ggaFixDiagnostic_(minimalFixQuality),
+  positionAggregator_(),
+  positionJumpGate_(),
+  externalPositionJumpGate_(nullptr),
+  gstCovarianceCache_(),
+  geofenceDiagnostic_(),
+  positionStd_(std::numeric_limits<double>::quiet_NaN()),
+  odometryLinearSpeed_(nullptr),
+  gsvCycleCache_(),
+  notifier_(),
+  positionWaitList_("position_waiters"),
+  courseWaitList_("course_waiters"),
+  journalMutex_("diagnostic_report_journal"),
+  journal_()
 {
 }
 
@@ -51,6 +74,24 @@ LocalisationGPSPluginBase::LocalisationGPSPluginBase(
 void LocalisationGPSPluginBase::setAnchor(const GeodeticCoordinates & wgs84_anchor)
 {
   enuConverter_.setAnchor(wgs84_anchor);
+  positionJumpGate_.reset();
+  positionAggregator_.reset();
+  std::atomic_store(&geofenceDiagnostic_, std::shared_ptr<CheckupGeofence>());
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::setPositionAggregation(
+  const size_t & numberOfFixes,
+  const Duration & window)
+{
+  positionAggregator_ = PositionAggregator(numberOfFixes, window);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::setExternalPositionJumpGate(
+  const PositionJumpGate * positionJumpGate)
+{
+  externalPositionJumpGate_ = positionJumpGate;
 }
 
 //-----------------------------------------------------------------------------
@@ -60,172 +101,307 @@ const ENUConverter & LocalisationGPSPluginBase::getENUConverter()const
 }
 
 //-----------------------------------------------------------------------------
-bool LocalisationGPSPluginBase::processGGA(
-  const Duration & stamp,
-  const std::string & ggaSentence,
-  ObservationPosition & positionObs)
+void LocalisationGPSPluginBase::registerStatusTransitionCallback(
+  const StatusTransitionCallback & callback)
 {
-  GGAFrame ggaFrame(ggaSentence);
-  if (ggaRateDiagnostic_.evaluate(stamp) == DiagnosticStatus::OK &&
-    ggaFixDiagnostic_.evaluate(ggaFrame) == DiagnosticStatus::OK)
-  {
-    auto geodeticCoordinates = makeGeodeticCoordinates(
-      (*ggaFrame.latitude).toDouble(),
-      (*ggaFrame.longitude).toDouble(),
-      (*ggaFrame.altitudeAboveGeoid +
-      *ggaFrame.geoidHeight));
-
-    Eigen::Vector3d position = enuConverter_.toENU(geodeticCoordinates);
-    double fixStd = *ggaFrame.horizontalDilutionOfPrecision * gps_->getUERE(*ggaFrame.fixQuality);
-    positionObs.Y(ObservationPosition::POSITION_X) = position.x();
-    positionObs.Y(ObservationPosition::POSITION_Y) = position.y();
-    positionObs.R() = Eigen::Matrix2d::Identity() * fixStd * fixStd;
-    positionObs.levelArm = gps_->getAntennaBodyPosition();
-    return true;
-  }
+  notifier_.registerCallback(callback);
+}
 
-  return false;
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::setSharedObservationPublisher(
+  std::shared_ptr<SharedObservationPublisher> publisher)
+{
+  publisher_ = publisher;
+  notifier_.registerCallback(
+    [publisher](const StatusTransition & transition) {
+      publisher->publish(transition);
+    });
 }
 
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::setObservationQueue(
+  std::shared_ptr<ObservationQueue> queue,
+  const uint32_t & sourceId)
+{
+  observationQueue_ = queue;
+  observationSourceId_ = sourceId;
+}
 
 //-----------------------------------------------------------------------------
-void LocalisationGPSPluginBase::processGSV(const std::string & gsvSentence)
+void LocalisationGPSPluginBase::setGeofence(std::shared_ptr<const Geofence> geofence)
 {
-  if (gps_->updateSatellitesViews(gsvSentence)) {
-    //    diagnostics_.updateConstellationReliability(gps_->getReliability());
-  }
+  std::atomic_store(&geofenceDiagnostic_, std::make_shared<CheckupGeofence>(std::move(geofence)));
 }
 
+//-----------------------------------------------------------------------------
+ObservationWaitList<ObservationPosition> & LocalisationGPSPluginBase::getPositionWaitList()
+{
+  return positionWaitList_;
+}
 
 //-----------------------------------------------------------------------------
-DiagnosticReport LocalisationGPSPluginBase::makeDiagnosticReport(const Duration & stamp)
+ObservationWaitList<ObservationCourse> & LocalisationGPSPluginBase::getCourseWaitList()
 {
-  checkHearBeats_(stamp);
-  return makeDiagnosticReport_();
+  return courseWaitList_;
 }
 
+//-----------------------------------------------------------------------------
+const GPSReceiver & LocalisationGPSPluginBase::getGPSReceiver()const
+{
+  return *gps_;
+}
 
 //-----------------------------------------------------------------------------
-LocalisationSingleAntennaGPSPlugin::LocalisationSingleAntennaGPSPlugin(
-  std::unique_ptr<GPSReceiver> gps,
-  const FixQuality & minimalFixQuality,
-  const double & minimalSpeedOverGround)
-: LocalisationGPSPluginBase(std::move(gps), minimalFixQuality),
-  linearSpeed_(std::numeric_limits<double>::quiet_NaN()),
-  linearSpeedRateDiagnostic_("linear_speed", 10.0, 0.1),
-  rmcRateDiagnostic_("rmc", 1.0, 0.1),
-  rmcTrackAngleDiagnostic_(minimalSpeedOverGround)
+bool LocalisationGPSPluginBase::processGGA(
+  const Duration & stamp,
+  const std::string & ggaSentence,
+  ObservationPosition & positionObs)
 {
+  GGAFrame ggaFrame;
+  try {
+    TraceScope trace("parseGGA", stamp);
+    ggaFrame = GGAFrame(ggaSentence);
+  } catch (const std::exception &) {
+    // numeric fields too long to be parsed, the frame is left empty
+  }
+  return processGGA(stamp, ggaFrame, positionObs);
 }
 
 //-----------------------------------------------------------------------------
-void LocalisationSingleAntennaGPSPlugin::processLinearSpeed(
+bool LocalisationGPSPluginBase::processGGA(
   const Duration & stamp,
-  const double & linearSpeed)
+  const GGAFrame & ggaFrame,
+  ObservationPosition & positionObs)
 {
-  linearSpeed_.store(linearSpeed);
-  linearSpeedRateDiagnostic_.evaluate(stamp);
+  TraceScope trace("processGGA", stamp);
+  bool isPositionValid = processGGA_(stamp, ggaFrame, positionObs);
+  trace.setOutcome(isPositionValid);
+  if (isPositionValid) {
+    positionWaitList_.notify(stamp, positionObs);
+  }
+  return isPositionValid;
 }
 
+//-----------------------------------------------------------------------------
+bool LocalisationGPSPluginBase::processGGA_(
+  const Duration & stamp,
+  const GGAFrame & ggaFrame,
+  ObservationPosition & positionObs)
+{
+  bool isFixValid = false;
+  if (ggaRateDiagnostic_.evaluate(stamp, notifier_) == DiagnosticStatus::OK) {
+    DiagnosticStatus status = ggaFixDiagnostic_.evaluate(ggaFrame, stamp);
+    notifier_.update(GPSCheckup::GGA_FIX, stamp, status, ggaFrame.fixQuality);
+    isFixValid = status == DiagnosticStatus::OK;
+  }
+  notifier_.dispatch();
+
+  if (!isFixValid) {
+    // only consecutive valid fixes are averaged
+    positionAggregator_.reset();
+    return false;
+  }
+
+  // aggregated positions keep an isotropic covariance, GST error ellipses
+  // then only weight their fixes
+  double fixStd = computeFixStd(ggaFrame, *gps_);
+  makePositionObservation(ggaFrame, enuConverter_, *gps_, positionObs);
+  const Eigen::Matrix2d * gstCovariance = gstCovarianceCache_.find(stamp);
+  if (gstCovariance != nullptr) {
+    fixStd = std::sqrt(gstCovariance->trace() / 2.);
+    positionObs.R() = *gstCovariance;
+  }
+
+  // each fix is gated before being aggregated, so that a jump can neither
+  // be hidden in nor drag the aggregated position
+  if (externalPositionJumpGate_ == nullptr) {
+    double observationVariance = positionObs.R()(0, 0);
+    double linearSpeed = odometryLinearSpeed_ != nullptr ?
+      odometryLinearSpeed_->load() : std::numeric_limits<double>::quiet_NaN();
+
+    switch (positionJumpGate_.evaluate(stamp, linearSpeed, positionObs)) {
+      case PositionJumpGate::Decision::REJECTED:
+        return false;
+      case PositionJumpGate::Decision::INFLATED:
+        fixStd *= std::sqrt(positionObs.R()(0, 0) / observationVariance);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (positionAggregator_.isEnabled()) {
+    if (!positionAggregator_.add(stamp, positionObs, fixStd)) {
+      positionStd_.store(fixStd);
+      return false;
+    }
+    fixStd = positionAggregator_.makePositionObservation(positionObs);
+  }
+
+  positionStd_.store(fixStd);
+  if (publisher_) {
+    publisher_->publish(stamp, positionObs);
+  }
+  if (observationQueue_) {
+    observationQueue_->publish(observationSourceId_, stamp, positionObs);
+  }
+  if (auto geofenceDiagnostic = std::atomic_load(&geofenceDiagnostic_)) {
+    DiagnosticStatus status = geofenceDiagnostic->evaluate(positionObs.Y());
+    notifier_.update(GPSCheckup::GEOFENCE, stamp, status);
+    notifier_.dispatch();
+  }
+  return true;
+}
 
 //-----------------------------------------------------------------------------
-bool LocalisationSingleAntennaGPSPlugin::processRMC(
+bool LocalisationGPSPluginBase::processGST(
   const Duration & stamp,
-  const std::string & rmcSentence,
-  ObservationCourse & courseObs)
+  const std::string & gstSentence)
 {
-  RMCFrame rmcFrame(rmcSentence);
-  if (rmcRateDiagnostic_.evaluate(stamp) == DiagnosticStatus::OK &&
-    rmcTrackAngleDiagnostic_.evaluate(rmcFrame) == DiagnosticStatus::OK &&
-    std::isfinite(linearSpeed_))
+  GSTFrame gstFrame;
   {
-    courseObs.Y() = trackAngleToCourseAngle(*rmcFrame.trackAngleTrue, linearSpeed_);
-    courseObs.R() = DEFAULT_COURSE_ANGLE_STD * DEFAULT_COURSE_ANGLE_STD;
-    return true;
+    TraceScope trace("parseGST", stamp);
+    scanGSTFrame(gstSentence, gstFrame);
   }
+  return processGST(stamp, gstFrame);
+}
 
-  return false;
+//-----------------------------------------------------------------------------
+bool LocalisationGPSPluginBase::processGST(
+  const Duration & stamp,
+  const GSTFrame & gstFrame)
+{
+  TraceScope trace("processGST", stamp);
+  return gstCovarianceCache_.update(stamp, gstFrame);
 }
 
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::setGSTMaximalAge(const Duration & maximalAge)
+{
+  gstCovarianceCache_.setMaximalAge(maximalAge);
+}
 
 //-----------------------------------------------------------------------------
-void LocalisationSingleAntennaGPSPlugin::checkHearBeats_(const Duration & stamp)
+void LocalisationGPSPluginBase::publishCourse_(
+  const bool & isCourseValid,
+  const Duration & stamp,
+  const ObservationCourse & courseObs)
 {
-  if (!linearSpeedRateDiagnostic_.heartBeatCallback(stamp)) {
-    linearSpeed_ = std::numeric_limits<double>::quiet_NaN();
+  if (isCourseValid && publisher_) {
+    publisher_->publish(stamp, courseObs);
+  }
+  if (isCourseValid && observationQueue_) {
+    observationQueue_->publish(observationSourceId_, stamp, courseObs);
   }
+  if (isCourseValid) {
+    courseWaitList_.notify(stamp, courseObs);
+  }
+}
 
-  if (!ggaRateDiagnostic_.heartBeatCallback(stamp)) {
-    ggaFixDiagnostic_.reset();
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::processGSV(const std::string & gsvSentence)
+{
+  // GSV sentences are not stamped
+  TraceScope trace("processGSV", Duration::zero());
+  if (gps_->updateSatellitesViews(gsvSentence)) {
+    //    diagnostics_.updateConstellationReliability(gps_->getReliability());
+    gsvCycleCache_.update(gsvSentence);
   }
+}
 
-  if (!rmcRateDiagnostic_.heartBeatCallback(stamp)) {
-    rmcTrackAngleDiagnostic_.reset();
+//-----------------------------------------------------------------------------
+void LocalisationGPSPluginBase::checkGGAHeartBeat_(const Duration & stamp)
+{
+  if (!ggaRateDiagnostic_.checkHeartBeat(stamp, notifier_)) {
+    ggaFixDiagnostic_.reset();
+    positionStd_ = std::numeric_limits<double>::quiet_NaN();
+    notifier_.update(GPSCheckup::GGA_FIX, stamp, std::nullopt);
+    if (auto geofenceDiagnostic = std::atomic_load(&geofenceDiagnostic_)) {
+      geofenceDiagnostic->reset();
+      notifier_.update(GPSCheckup::GEOFENCE, stamp, std::nullopt);
+    }
   }
 }
 
 //-----------------------------------------------------------------------------
-DiagnosticReport LocalisationSingleAntennaGPSPlugin::makeDiagnosticReport_()
+void LocalisationGPSPluginBase::appendGGAReport_(DiagnosticReport & report) const
 {
-  DiagnosticReport report;
-  report += linearSpeedRateDiagnostic_.getReport();
   report += ggaRateDiagnostic_.getReport();
   report += ggaFixDiagnostic_.getReport();
-  report += rmcRateDiagnostic_.getReport();
-  report += rmcTrackAngleDiagnostic_.getReport();
-  return report;
+  if (externalPositionJumpGate_ != nullptr) {
+    report += externalPositionJumpGate_->getReport();
+  } else {
+    report += positionJumpGate_.getReport();
+  }
+  if (auto geofenceDiagnostic = std::atomic_load(&geofenceDiagnostic_)) {
+    report += geofenceDiagnostic->getReport();
+  }
 }
 
 //-----------------------------------------------------------------------------
-LocalisationDualAntennaGPSPlugin::LocalisationDualAntennaGPSPlugin(
-  std::unique_ptr<GPSReceiver> gps,
-  const FixQuality & minimalFixQuality)
-: LocalisationGPSPluginBase(std::move(gps), minimalFixQuality),
-  hdtRateDiagnostic_("hdt", 1.0, 0.1),
-  hdtTrackAngleDiagnostic_()
+void LocalisationGPSPluginBase::dumpGGAHistory_(std::ostream & os) const
 {
+  ggaRateDiagnostic_.getHistory().dump(os);
+  ggaFixDiagnostic_.getHistory().dump(os);
 }
 
 //-----------------------------------------------------------------------------
-bool LocalisationDualAntennaGPSPlugin::processHDT(
-  const Duration & stamp,
-  const std::string & hdtSentence,
-  ObservationCourse & courseObs)
+DiagnosticReportDelta LocalisationGPSPluginBase::makeDiagnosticReportDelta_(
+  const DiagnosticReport & report,
+  const uint64_t & sinceSequence)
 {
-  HDTFrame hdtFrame(hdtSentence);
-  if (hdtRateDiagnostic_.evaluate(stamp) == DiagnosticStatus::OK &&
-    hdtTrackAngleDiagnostic_.evaluate(hdtFrame) == DiagnosticStatus::OK)
-  {
-    courseObs.Y() = headingToCourseAngle(*hdtFrame.heading);
-    courseObs.R() = DEFAULT_COURSE_ANGLE_STD * DEFAULT_COURSE_ANGLE_STD;
-    return true;
-  }
-
-  return false;
+  std::lock_guard<ProfiledMutex> lock(journalMutex_);
+  journal_.update(report);
+  return journal_.makeDelta(sinceSequence);
 }
 
-
 //-----------------------------------------------------------------------------
-void LocalisationDualAntennaGPSPlugin::checkHearBeats_(const Duration & stamp)
+PluginSnapshot LocalisationGPSPluginBase::makeSnapshot_(const Duration & stamp) const
 {
-  if (!ggaRateDiagnostic_.heartBeatCallback(stamp)) {
-    ggaFixDiagnostic_.reset();
-  }
+  PluginSnapshot snapshot = makeEmptyPluginSnapshot(stamp);
+  snapshot.anchor = enuConverter_.getAnchor();
+  snapshot.ggaStamps = ggaRateDiagnostic_.getLastStamps(PluginSnapshot::NUMBER_OF_RATE_STAMPS);
 
-  if (!hdtRateDiagnostic_.heartBeatCallback(stamp)) {
-    hdtTrackAngleDiagnostic_.reset();
+  GGAFrame ggaFrame;
+  if (ggaFixDiagnostic_.getLastFrame(ggaFrame, snapshot.lastGGAStamp)) {
+    snapshot.lastGGASentence = ggaFrame.toNMEA();
   }
+
+  snapshot.gsvSentences = gsvCycleCache_.getSentences();
+  return snapshot;
 }
 
 //-----------------------------------------------------------------------------
-DiagnosticReport LocalisationDualAntennaGPSPlugin::makeDiagnosticReport_()
+bool LocalisationGPSPluginBase::restoreSnapshot_(
+  const PluginSnapshot & snapshot,
+  const Duration & stamp,
+  const Duration & maximalAge)
 {
-  DiagnosticReport report;
-  report += ggaRateDiagnostic_.getReport();
-  report += ggaFixDiagnostic_.getReport();
-  report += hdtRateDiagnostic_.getReport();
-  report += hdtTrackAngleDiagnostic_.getReport();
-  return report;
+  setAnchor(snapshot.anchor);
+
+  Duration age = stamp - snapshot.stamp;
+  if (age < Duration::zero() || age > maximalAge) {
+    return false;
+  }
+
+  ggaRateDiagnostic_.replay(snapshot.ggaStamps, age, notifier_);
+
+  GGAFrame ggaFrame;
+  if (scanGGAFrame(snapshot.lastGGASentence, ggaFrame)) {
+    Duration ggaStamp = snapshot.lastGGAStamp + age;
+    DiagnosticStatus status = ggaFixDiagnostic_.replay(ggaFrame, ggaStamp);
+    notifier_.update(GPSCheckup::GGA_FIX, ggaStamp, status, ggaFrame.fixQuality);
+    if (status == DiagnosticStatus::OK) {
+      positionStd_.store(computeFixStd(ggaFrame, *gps_));
+    }
+  }
+
+  for (const auto & gsvSentence : snapshot.gsvSentences) {
+    processGSV(gsvSentence);
+  }
+
+  notifier_.dispatch();
+  return true;
 }
 
 }  // namespace core
@@ -0,0 +1,327 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// local
+#include "romea_core_localisation_gps/LocalisationGPSRedundancy.hpp"
+
+namespace
+{
+// antennas closer than this distance are considered as the same antenna
+const double LEVEL_ARM_TOLERANCE = 0.001;
+
+//-----------------------------------------------------------------------------
+double fixStd(const romea::core::GGAFrame & ggaFrame, const romea::core::GPSReceiver & gps)
+{
+  if (!ggaFrame.fixQuality || !ggaFrame.horizontalDilutionOfPrecision) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return gps.getUERE(*ggaFrame.fixQuality) * *ggaFrame.horizontalDilutionOfPrecision;
+}
+
+//-----------------------------------------------------------------------------
+bool haveSameLevelArm(
+  const romea::core::ObservationPosition & observation1,
+  const romea::core::ObservationPosition & observation2)
+{
+  return (observation1.levelArm - observation2.levelArm).norm() < LEVEL_ARM_TOLERANCE;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+LocalisationGPSRedundancy::LocalisationGPSRedundancy(
+  const Mode & mode,
+  const Duration & epochTolerance,
+  const double & consistencyThreshold)
+: mode_(mode),
+  epochTolerance_(epochTolerance),
+  consistencyThreshold_(consistencyThreshold),
+  mutex_(),
+  receivers_(),
+  isEpochOpen_(false),
+  epochStamp_()
+{
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationGPSRedundancy::addReceiver(std::shared_ptr<LocalisationGPSPluginBase> plugin)
+{
+  if (plugin == nullptr) {
+    throw std::invalid_argument("Redundant GPS receiver plugin is null");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Receiver receiver;
+  receiver.plugin = std::move(plugin);
+  receiver.candidate = Candidate{
+    false, false, Duration::zero(), ObservationPosition(), std::numeric_limits<double>::infinity()};
+  receiver.status = RedundantGPSReceiverStatus{0, 0, 0, 0, false};
+  receivers_.push_back(std::move(receiver));
+  return receivers_.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationGPSRedundancy::getNumberOfReceivers() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return receivers_.size();
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSRedundancy::setAnchor(const GeodeticCoordinates & wgs84_anchor)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto & receiver : receivers_) {
+    receiver.plugin->setAnchor(wgs84_anchor);
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSRedundancy::processGGA(
+  const size_t & receiverIndex,
+  const Duration & stamp,
+  const std::string & ggaSentence,
+  RedundantPositionObservation & positionObs)
+{
+  GGAFrame ggaFrame;
+  try {
+    ggaFrame = GGAFrame(ggaSentence);
+  } catch (const std::exception &) {
+    // numeric fields too long to be parsed, the frame is left empty
+  }
+  return processGGA(receiverIndex, stamp, ggaFrame, positionObs);
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSRedundancy::processGGA(
+  const size_t & receiverIndex,
+  const Duration & stamp,
+  const GGAFrame & ggaFrame,
+  RedundantPositionObservation & positionObs)
+{
+  Receiver & receiver = receivers_.at(receiverIndex);
+
+  // plugins are processed outside of the lock, each one by its own thread
+  Candidate candidate;
+  candidate.hasContributed = true;
+  candidate.stamp = stamp;
+  candidate.isValid = receiver.plugin->processGGA(stamp, ggaFrame, candidate.observation);
+  candidate.fixStd = fixStd(ggaFrame, receiver.plugin->getGPSReceiver());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  bool isClosed = false;
+  if (isEpochOpen_ &&
+    (receiver.candidate.hasContributed ||
+    stamp - epochStamp_ > epochTolerance_ ||
+    epochStamp_ - stamp > epochTolerance_))
+  {
+    isClosed = closeEpoch_(positionObs);
+  }
+
+  if (!isEpochOpen_) {
+    isEpochOpen_ = true;
+    epochStamp_ = stamp;
+  }
+
+  receiver.candidate = candidate;
+  receiver.status.numberOfValidFixes += candidate.isValid;
+
+  if (!isClosed && isEpochComplete_()) {
+    isClosed = closeEpoch_(positionObs);
+  }
+
+  return isClosed;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSRedundancy::flush(
+  const Duration & stamp,
+  RedundantPositionObservation & positionObs)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (isEpochOpen_ && stamp - epochStamp_ > epochTolerance_) {
+    return closeEpoch_(positionObs);
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+RedundantGPSReceiverStatus LocalisationGPSRedundancy::getReceiverStatus(
+  const size_t & receiverIndex) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return receivers_.at(receiverIndex).status;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport LocalisationGPSRedundancy::makeDiagnosticReport() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  DiagnosticReport report;
+  for (size_t index = 0; index < receivers_.size(); ++index) {
+    const RedundantGPSReceiverStatus & status = receivers_[index].status;
+    std::string name = "gps_receiver_" + std::to_string(index);
+    if (status.isDisagreeing) {
+      report.diagnostics.push_back(
+        {DiagnosticStatus::WARN, name + " disagrees with the other receivers."});
+    } else {
+      report.diagnostics.push_back(
+        {DiagnosticStatus::OK, name + " agrees with the other receivers."});
+    }
+    setReportInfo(report, name + "_selections", status.numberOfSelections);
+    setReportInfo(report, name + "_disagreements", status.numberOfDisagreements);
+  }
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSRedundancy::isEpochComplete_() const
+{
+  return std::all_of(
+    receivers_.begin(), receivers_.end(),
+    [](const Receiver & receiver) {return receiver.candidate.hasContributed;});
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSRedundancy::closeEpoch_(RedundantPositionObservation & positionObs)
+{
+  isEpochOpen_ = false;
+
+  std::vector<size_t> validReceivers;
+  for (size_t index = 0; index < receivers_.size(); ++index) {
+    receivers_[index].status.numberOfEpochs++;
+    if (receivers_[index].candidate.hasContributed && receivers_[index].candidate.isValid) {
+      validReceivers.push_back(index);
+    }
+  }
+
+  // the reference fix is consistent with most other fixes and is the most
+  // accurate one among them, a lone inconsistent fix cannot outvote others
+  size_t reference = 0;
+  size_t referenceAgreements = 0;
+  for (size_t n = 0; n < validReceivers.size(); ++n) {
+    const Candidate & candidate = receivers_[validReceivers[n]].candidate;
+    size_t agreements = std::count_if(
+      validReceivers.begin(), validReceivers.end(), [&](const size_t & other) {
+        return areConsistent_(candidate, receivers_[other].candidate);
+      });
+
+    if (n == 0 || agreements > referenceAgreements ||
+      (agreements == referenceAgreements &&
+      candidate.fixStd < receivers_[reference].candidate.fixStd))
+    {
+      reference = validReceivers[n];
+      referenceAgreements = agreements;
+    }
+  }
+
+  bool hasObservation = !validReceivers.empty();
+  if (hasObservation) {
+    const Candidate & referenceCandidate = receivers_[reference].candidate;
+
+    std::vector<size_t> mergedReceivers;
+    for (const size_t & index : validReceivers) {
+      Receiver & receiver = receivers_[index];
+      receiver.status.isDisagreeing = !areConsistent_(receiver.candidate, referenceCandidate);
+      receiver.status.numberOfDisagreements += receiver.status.isDisagreeing;
+
+      if (mode_ == Mode::MERGE && !receiver.status.isDisagreeing &&
+        haveSameLevelArm(receiver.candidate.observation, referenceCandidate.observation))
+      {
+        mergedReceivers.push_back(index);
+      }
+    }
+
+    receivers_[reference].status.numberOfSelections++;
+    positionObs.stamp = referenceCandidate.stamp;
+    positionObs.referenceReceiver = reference;
+    if (mergedReceivers.size() > 1) {
+      merge_(mergedReceivers, positionObs);
+    } else {
+      positionObs.observation = referenceCandidate.observation;
+      positionObs.numberOfMergedReceivers = 1;
+    }
+  }
+
+  for (auto & receiver : receivers_) {
+    receiver.candidate.hasContributed = false;
+    receiver.candidate.isValid = false;
+  }
+
+  return hasObservation;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationGPSRedundancy::areConsistent_(
+  const Candidate & candidate1,
+  const Candidate & candidate2) const
+{
+  const ObservationPosition & observation1 = candidate1.observation;
+  const ObservationPosition & observation2 = candidate2.observation;
+
+  // the heading is unknown, positions of antennas mounted at different
+  // places may differ by up to the horizontal distance between antennas
+  double antennasDistance = (observation1.levelArm - observation2.levelArm).head<2>().norm();
+  double distance = std::max(0., (observation1.Y() - observation2.Y()).norm() - antennasDistance);
+
+  // per axis variance of the position difference
+  double variance = (observation1.R().trace() + observation2.R().trace()) / 2.;
+  return distance <= consistencyThreshold_ * std::sqrt(variance);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationGPSRedundancy::merge_(
+  const std::vector<size_t> & receiverIndexes,
+  RedundantPositionObservation & positionObs) const
+{
+  // receivers share most of their error sources (satellites, atmosphere),
+  // the merged covariance is a weighted mean instead of an information sum
+  // in order not to be overconfident
+  double sumOfWeights = 0;
+  for (const size_t & index : receiverIndexes) {
+    sumOfWeights += 1 / receivers_[index].candidate.observation.R().trace();
+  }
+
+  ObservationPosition & merged = positionObs.observation;
+  merged = receivers_[receiverIndexes.front()].candidate.observation;
+  merged.Y().setZero();
+  merged.R().setZero();
+  for (const size_t & index : receiverIndexes) {
+    const ObservationPosition & observation = receivers_[index].candidate.observation;
+    double weight = 1 / observation.R().trace() / sumOfWeights;
+    merged.Y() += weight * observation.Y();
+    merged.R() += weight * observation.R();
+  }
+  positionObs.numberOfMergedReceivers = receiverIndexes.size();
+}
+
+}  // namespace core
+}  // namespace romea
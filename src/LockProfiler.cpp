@@ -0,0 +1,182 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// local
+#include "romea_core_localisation_gps/LockProfiler.hpp"
+
+namespace
+{
+
+std::atomic<bool> lockProfilingEnabled(false);
+
+std::mutex & registryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, std::unique_ptr<romea::core::LockProfiler::Counters>> & registry()
+{
+  static std::map<std::string, std::unique_ptr<romea::core::LockProfiler::Counters>> counters;
+  return counters;
+}
+
+void updateMaximum(std::atomic<int64_t> & maximum, const int64_t & value)
+{
+  int64_t current = maximum.load(std::memory_order_relaxed);
+  while (value > current &&
+    !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+void record(
+  std::atomic<int64_t> & total,
+  std::atomic<int64_t> & maximum,
+  const std::chrono::steady_clock::duration & duration)
+{
+  int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  total.fetch_add(nanoseconds, std::memory_order_relaxed);
+  updateMaximum(maximum, nanoseconds);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+void LockProfiler::enable(const bool & enabled)
+{
+  lockProfilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+bool LockProfiler::isEnabled()
+{
+  return lockProfilingEnabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+LockProfiler::Counters & LockProfiler::getCounters(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  auto & counters = registry()[name];
+  if (!counters) {
+    counters = std::make_unique<Counters>();
+  }
+  return *counters;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<LockProfile> LockProfiler::getProfiles()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::vector<LockProfile> profiles;
+  for (const auto & [name, counters] : registry()) {
+    profiles.push_back({name,
+        counters->numberOfLocks.load(std::memory_order_relaxed),
+        counters->numberOfContentions.load(std::memory_order_relaxed),
+        std::chrono::nanoseconds(counters->totalWaitTime.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(counters->maximalWaitTime.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(counters->totalHoldTime.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(counters->maximalHoldTime.load(std::memory_order_relaxed))});
+  }
+  return profiles;
+}
+
+//-----------------------------------------------------------------------------
+void LockProfiler::reset()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  for (auto & [name, counters] : registry()) {
+    counters->numberOfLocks = 0;
+    counters->numberOfContentions = 0;
+    counters->totalWaitTime = 0;
+    counters->maximalWaitTime = 0;
+    counters->totalHoldTime = 0;
+    counters->maximalHoldTime = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+ProfiledMutex::ProfiledMutex(const char * name)
+: mutex_(),
+  counters_(LockProfiler::getCounters(name)),
+  lockTime_(),
+  isProfiled_(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+void ProfiledMutex::lock()
+{
+  if (!LockProfiler::isEnabled()) {
+    mutex_.lock();
+    isProfiled_ = false;
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  if (!mutex_.try_lock()) {
+    counters_.numberOfContentions.fetch_add(1, std::memory_order_relaxed);
+    mutex_.lock();
+  }
+  lockTime_ = std::chrono::steady_clock::now();
+  isProfiled_ = true;
+
+  counters_.numberOfLocks.fetch_add(1, std::memory_order_relaxed);
+  record(counters_.totalWaitTime, counters_.maximalWaitTime, lockTime_ - start);
+}
+
+//-----------------------------------------------------------------------------
+bool ProfiledMutex::try_lock()
+{
+  if (!mutex_.try_lock()) {
+    if (LockProfiler::isEnabled()) {
+      counters_.numberOfContentions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+  }
+
+  isProfiled_ = LockProfiler::isEnabled();
+  if (isProfiled_) {
+    lockTime_ = std::chrono::steady_clock::now();
+    counters_.numberOfLocks.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void ProfiledMutex::unlock()
+{
+  if (isProfiled_) {
+    record(
+      counters_.totalHoldTime, counters_.maximalHoldTime,
+      std::chrono::steady_clock::now() - lockTime_);
+  }
+  mutex_.unlock();
+}
+
+}  // namespace core
+}  // namespace romea
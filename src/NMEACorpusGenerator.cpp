@@ -0,0 +1,345 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+// romea
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_gps/nmea/HDTFrame.hpp"
+#include "romea_core_gps/nmea/RMCFrame.hpp"
+
+// local
+#include "romea_core_localisation_gps/NMEACorpusGenerator.hpp"
+
+namespace
+{
+
+// WGS84 ellipsoid
+const double SEMI_MAJOR_AXIS = 6378137.;
+const double SQUARED_ECCENTRICITY = 6.69437999014e-3;
+
+const double GEOID_HEIGHT = 48.3;
+const unsigned short NUMBER_OF_SATELLITES = 12;
+const size_t NUMBER_OF_SATELLITES_PER_GSV = 4;
+const char * const GSV_BURST_TALKERS[] = {"GP", "GL", "GA", "GB"};
+
+//-----------------------------------------------------------------------------
+// longitude and latitude variations of an east and north displacement of one meter
+Eigen::Vector2d radiansPerMeter(const double & latitude)
+{
+  double w = 1 - SQUARED_ECCENTRICITY * std::sin(latitude) * std::sin(latitude);
+  double meridianRadius = SEMI_MAJOR_AXIS * (1 - SQUARED_ECCENTRICITY) / (w * std::sqrt(w));
+  double normalRadius = SEMI_MAJOR_AXIS / std::sqrt(w);
+  return {1 / (normalRadius * std::cos(latitude)), 1 / meridianRadius};
+}
+
+//-----------------------------------------------------------------------------
+std::string finishSentence(std::string body)
+{
+  unsigned char checksum = 0;
+  for (size_t n = 1; n < body.size(); ++n) {
+    checksum ^= static_cast<unsigned char>(body[n]);
+  }
+  char suffix[8];
+  std::snprintf(suffix, sizeof(suffix), "*%02X\r\n", checksum);
+  return body + suffix;
+}
+
+//-----------------------------------------------------------------------------
+std::string makeGSVSentence(
+  const char * talker,
+  const size_t & numberOfSentences,
+  const size_t & index,
+  const double & time)
+{
+  char buffer[128];
+  std::snprintf(
+    buffer, sizeof(buffer), "$%sGSV,%zu,%zu,%02u", talker, numberOfSentences, index + 1,
+    NUMBER_OF_SATELLITES);
+  std::string body = buffer;
+
+  size_t first = index * NUMBER_OF_SATELLITES_PER_GSV;
+  size_t last = std::min<size_t>(first + NUMBER_OF_SATELLITES_PER_GSV, NUMBER_OF_SATELLITES);
+  for (size_t satellite = first; satellite < last; ++satellite) {
+    // satellites slowly move along the sky, a quarter turn per hour
+    double azimuth = std::fmod(satellite * 30. + time / 40., 360.);
+    int elevation = 10 + static_cast<int>(satellite * 7) % 80;
+    int snr = 30 + static_cast<int>(satellite * 5) % 20;
+    std::snprintf(
+      buffer, sizeof(buffer), ",%02zu,%02d,%03d,%02d", satellite + 1, elevation,
+      static_cast<int>(azimuth), snr);
+    body += buffer;
+  }
+  return finishSentence(body);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+const char * toString(const NMEAFault & fault)
+{
+  switch (fault) {
+    case NMEAFault::NONE:
+      return "none";
+    case NMEAFault::RTK_DROPOUT:
+      return "rtk_dropout";
+    case NMEAFault::MULTIPATH:
+      return "multipath";
+    case NMEAFault::HDOP_SPIKE:
+      return "hdop_spike";
+    case NMEAFault::GSV_BURST:
+      return "gsv_burst";
+    case NMEAFault::CORRUPT_CHECKSUM:
+      return "corrupt_checksum";
+    case NMEAFault::TRUNCATED:
+      return "truncated";
+    default:
+      return "unknown";
+  }
+}
+
+//-----------------------------------------------------------------------------
+NMEACorpusGenerator::NMEACorpusGenerator(const NMEACorpusOptions & options)
+: options_(options),
+  enuConverter_(),
+  engine_(options.seed),
+  epoch_(0),
+  stamp_(Duration::zero()),
+  latitude_(options.anchorLatitude),
+  longitude_(options.anchorLongitude),
+  course_(0.),
+  linearSpeed_(options.linearSpeed),
+  yawRate_(0.),
+  rtkDropoutEnd_(Duration::zero()),
+  pendingRecords_()
+{
+  enuConverter_.setAnchor(
+    makeGeodeticCoordinates(
+      options.anchorLatitude,
+      options.anchorLongitude,
+      options.anchorAltitude));
+  course_ = (2 * uniform_() - 1) * M_PI;
+}
+
+//-----------------------------------------------------------------------------
+bool NMEACorpusGenerator::next(NMEACorpusRecord & record)
+{
+  while (pendingRecords_.empty()) {
+    stamp_ = durationFromSecond(epoch_ / options_.gnssRate);
+    if (options_.duration != Duration::zero() && stamp_ >= options_.duration) {
+      return false;
+    }
+    simulateEpoch_();
+    epoch_++;
+  }
+
+  record = std::move(pendingRecords_.front());
+  pendingRecords_.pop_front();
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void NMEACorpusGenerator::simulateEpoch_()
+{
+  if (epoch_ != 0) {
+    double dt = 1 / options_.gnssRate;
+
+    // yaw rate and speed follow mean reverting random walks
+    yawRate_ += -yawRate_ * dt + 0.2 * options_.maximalYawRate * std::sqrt(dt) * normal_();
+    yawRate_ = std::clamp(yawRate_, -options_.maximalYawRate, options_.maximalYawRate);
+    linearSpeed_ += 0.5 * (options_.linearSpeed - linearSpeed_) * dt + 0.1 * std::sqrt(dt) * normal_();
+    linearSpeed_ = std::max(linearSpeed_, 0.);
+    course_ = std::remainder(course_ + yawRate_ * dt, 2 * M_PI);
+
+    Eigen::Vector2d displacement = linearSpeed_ * dt *
+      Eigen::Vector2d(std::cos(course_), std::sin(course_));
+    Eigen::Vector2d variation = radiansPerMeter(latitude_).cwiseProduct(displacement);
+    longitude_ += variation.x();
+    latitude_ += variation.y();
+  }
+
+  // truth is expressed with the converter used by plugins rather than with
+  // the integration above
+  Eigen::Vector3d position = enuConverter_.toENU(
+    makeGeodeticCoordinates(latitude_, longitude_, options_.anchorAltitude));
+  NMEAGroundTruth truth{position.head<2>(), course_, linearSpeed_};
+
+  emitGGA_(truth);
+  emitRMC_(truth);
+  if (options_.emitsHDT) {
+    emitHDT_(truth);
+  }
+
+  uint64_t epochsPerSecond = std::max<uint64_t>(std::llround(options_.gnssRate), 1);
+  if (epoch_ % epochsPerSecond == 0) {
+    emitGSV_(truth);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void NMEACorpusGenerator::emitGGA_(const NMEAGroundTruth & truth)
+{
+  if (stamp_ >= rtkDropoutEnd_ && draw_(options_.rtkDropoutRate / options_.gnssRate)) {
+    rtkDropoutEnd_ = stamp_ + options_.rtkDropoutDuration;
+  }
+
+  NMEAFault fault = NMEAFault::NONE;
+  GGAFrame frame;
+  frame.talkerId = TalkerId::GN;
+  frame.fixQuality = FixQuality::RTK_FIX;
+  frame.numberSatellitesUsedToComputeFix = NUMBER_OF_SATELLITES;
+  frame.horizontalDilutionOfPrecision = 0.8 + 0.2 * uniform_();
+  frame.dgpsCorrectionAgeInSecond = 1.;
+  frame.dgpsStationIdNumber = 1;
+
+  double positionStd = options_.rtkPositionStd;
+  if (stamp_ < rtkDropoutEnd_) {
+    fault = NMEAFault::RTK_DROPOUT;
+    frame.fixQuality = FixQuality::FLOAT_RTK_FIX;
+    frame.dgpsCorrectionAgeInSecond.reset();
+    frame.dgpsStationIdNumber.reset();
+    positionStd = options_.floatPositionStd;
+  }
+
+  Eigen::Vector2d error(positionStd * normal_(), positionStd * normal_());
+  if (draw_(options_.multipathProbability)) {
+    fault = NMEAFault::MULTIPATH;
+    double angle = 2 * M_PI * uniform_();
+    error += options_.multipathAmplitude * Eigen::Vector2d(std::cos(angle), std::sin(angle));
+  } else if (draw_(options_.hdopSpikeProbability)) {
+    fault = NMEAFault::HDOP_SPIKE;
+    frame.horizontalDilutionOfPrecision = 6. + 10. * uniform_();
+    frame.numberSatellitesUsedToComputeFix = 4;
+  }
+
+  Eigen::Vector2d variation = radiansPerMeter(latitude_).cwiseProduct(error);
+  frame.longitude = Longitude(longitude_ + variation.x());
+  frame.latitude = Latitude(latitude_ + variation.y());
+  frame.geoidHeight = GEOID_HEIGHT;
+  frame.altitudeAboveGeoid = options_.anchorAltitude - GEOID_HEIGHT;
+
+  emit_(frame.toNMEA(), fault, truth);
+}
+
+//-----------------------------------------------------------------------------
+void NMEACorpusGenerator::emitRMC_(const NMEAGroundTruth & truth)
+{
+  RMCFrame frame;
+  frame.talkerId = TalkerId::GP;
+  frame.speedOverGroundInMeterPerSecond = std::max(truth.linearSpeed + 0.02 * normal_(), 0.);
+  double trackAngle = M_PI / 2 - truth.course + options_.courseStd * normal_();
+  frame.trackAngleTrue = trackAngle - 2 * M_PI * std::floor(trackAngle / (2 * M_PI));
+  frame.magneticDeviation = 0.0378;
+  emit_(frame.toNMEA(), NMEAFault::NONE, truth);
+}
+
+//-----------------------------------------------------------------------------
+void NMEACorpusGenerator::emitHDT_(const NMEAGroundTruth & truth)
+{
+  HDTFrame frame;
+  frame.talkerId = TalkerId::GN;
+  double heading = M_PI / 2 - truth.course + options_.courseStd * normal_();
+  frame.heading = heading - 2 * M_PI * std::floor(heading / (2 * M_PI));
+  emit_(frame.toNMEA(), NMEAFault::NONE, truth);
+}
+
+//-----------------------------------------------------------------------------
+void NMEACorpusGenerator::emitGSV_(const NMEAGroundTruth & truth)
+{
+  // a burst repeats satellites views of every constellation
+  bool isBurst = draw_(options_.gsvBurstProbability);
+  size_t numberOfTalkers = isBurst ? std::size(GSV_BURST_TALKERS) : 1;
+  size_t numberOfSentences =
+    (NUMBER_OF_SATELLITES + NUMBER_OF_SATELLITES_PER_GSV - 1) / NUMBER_OF_SATELLITES_PER_GSV;
+
+  double time = durationToSecond(stamp_);
+  for (size_t talker = 0; talker < numberOfTalkers; ++talker) {
+    for (size_t index = 0; index < numberOfSentences; ++index) {
+      emit_(
+        makeGSVSentence(GSV_BURST_TALKERS[talker], numberOfSentences, index, time),
+        isBurst ? NMEAFault::GSV_BURST : NMEAFault::NONE, truth);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void NMEACorpusGenerator::emit_(
+  std::string sentence,
+  const NMEAFault & fault,
+  const NMEAGroundTruth & truth)
+{
+  NMEACorpusRecord record{stamp_, std::move(sentence), fault, truth};
+
+  if (draw_(options_.corruptChecksumProbability)) {
+    size_t star = record.sentence.rfind('*');
+    if (star != std::string::npos && star + 2 < record.sentence.size()) {
+      char & digit = record.sentence[star + 2];
+      digit = digit == '0' ? '1' : '0';
+      record.fault = NMEAFault::CORRUPT_CHECKSUM;
+    }
+  } else if (draw_(options_.truncationProbability)) {
+    size_t length = 1 + static_cast<size_t>(uniform_() * (record.sentence.size() - 1));
+    record.sentence.resize(length);
+    record.fault = NMEAFault::TRUNCATED;
+  }
+
+  pendingRecords_.push_back(std::move(record));
+}
+
+//-----------------------------------------------------------------------------
+double NMEACorpusGenerator::uniform_()
+{
+  // 53 random bits in [0, 1)
+  return (engine_() >> 11) * 0x1.0p-53;
+}
+
+//-----------------------------------------------------------------------------
+double NMEACorpusGenerator::normal_()
+{
+  // Box-Muller, the second value is dropped to keep the generator stateless
+  double u = 1 - uniform_();
+  return std::sqrt(-2 * std::log(u)) * std::cos(2 * M_PI * uniform_());
+}
+
+//-----------------------------------------------------------------------------
+bool NMEACorpusGenerator::draw_(const double & probability)
+{
+  return uniform_() < probability;
+}
+
+//-----------------------------------------------------------------------------
+const NMEACorpusOptions & NMEACorpusGenerator::getOptions() const
+{
+  return options_;
+}
+
+//-----------------------------------------------------------------------------
+const ENUConverter & NMEACorpusGenerator::getENUConverter() const
+{
+  return enuConverter_;
+}
+
+}  // namespace core
+}  // namespace romea
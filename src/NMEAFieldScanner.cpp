@@ -0,0 +1,339 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// local
+#include "romea_core_localisation_gps/NMEAFieldScanner.hpp"
+
+namespace
+{
+const size_t ADDRESS_LENGTH = 5;
+const double KNOT_TO_METER_PER_SECOND = 1852. / 3600.;
+const double DEGREE_TO_RADIAN = M_PI / 180.;
+
+uint8_t hexadecimalDigit(const char & c)
+{
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return 0xFF;
+}
+
+template<size_t N>
+size_t scanFields(
+  romea::core::NMEAFieldScanner & scanner,
+  std::array<std::string_view, N> & fields)
+{
+  size_t n = 0;
+  while (n < N && scanner.next(fields[n])) {
+    ++n;
+  }
+  return n;
+}
+
+template<typename T>
+void assign(std::optional<T> & value, const std::optional<double> & number)
+{
+  // out of range integers are dropped, casting them is undefined
+  bool isInRange = !std::is_integral_v<T> || (number &&
+    *number >= std::numeric_limits<T>::min() && *number <= std::numeric_limits<T>::max());
+  if (number && isInRange) {
+    value = static_cast<T>(*number);
+  } else {
+    value.reset();
+  }
+}
+
+// NMEA angles are written as (d)ddmm.mmmm followed by their hemisphere
+std::optional<double> parseNMEAAngle(
+  const std::string_view & field,
+  const std::string_view & hemisphere,
+  const char & negativeHemisphere)
+{
+  std::optional<double> value = romea::core::parseNMEANumber(field);
+  if (!value || hemisphere.size() != 1) {
+    return std::nullopt;
+  }
+
+  double degrees = std::floor(*value / 100.);
+  double minutes = *value - degrees * 100.;
+  double angle = (degrees + minutes / 60.) * DEGREE_TO_RADIAN;
+  return hemisphere[0] == negativeHemisphere ? -angle : angle;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+NMEAFieldScanner::NMEAFieldScanner(std::string_view sentence)
+: address_(),
+  fields_(),
+  position_(0),
+  isValid_(false)
+{
+  while (!sentence.empty() && (sentence.back() == '\n' || sentence.back() == '\r')) {
+    sentence.remove_suffix(1);
+  }
+
+  if (sentence.size() < ADDRESS_LENGTH + 1 || sentence[0] != '$') {
+    return;
+  }
+
+  size_t end = sentence.find('*');
+  uint8_t checksum = 0;
+  for (size_t n = 1; n < std::min(end, sentence.size()); ++n) {
+    checksum ^= static_cast<uint8_t>(sentence[n]);
+  }
+
+  if (end != std::string_view::npos) {
+    if (sentence.size() != end + 3 ||
+      hexadecimalDigit(sentence[end + 1]) > 15 ||
+      hexadecimalDigit(sentence[end + 2]) > 15 ||
+      ((hexadecimalDigit(sentence[end + 1]) << 4) | hexadecimalDigit(sentence[end + 2])) !=
+      checksum)
+    {
+      return;
+    }
+    sentence = sentence.substr(0, end);
+  }
+
+  address_ = sentence.substr(1, ADDRESS_LENGTH);
+  if (sentence.size() > ADDRESS_LENGTH + 1) {
+    if (sentence[ADDRESS_LENGTH + 1] != ',') {
+      return;
+    }
+    fields_ = sentence.substr(ADDRESS_LENGTH + 2);
+  }
+  position_ = sentence.size() > ADDRESS_LENGTH + 1 ? 0 : std::string_view::npos;
+  isValid_ = true;
+}
+
+//-----------------------------------------------------------------------------
+bool NMEAFieldScanner::isValid() const
+{
+  return isValid_;
+}
+
+//-----------------------------------------------------------------------------
+std::string_view NMEAFieldScanner::getTalker() const
+{
+  return address_.substr(0, 2);
+}
+
+//-----------------------------------------------------------------------------
+std::string_view NMEAFieldScanner::getSentenceId() const
+{
+  return address_.substr(std::min<size_t>(2, address_.size()));
+}
+
+//-----------------------------------------------------------------------------
+bool NMEAFieldScanner::next(std::string_view & field)
+{
+  if (!isValid_ || position_ == std::string_view::npos) {
+    return false;
+  }
+
+  size_t end = fields_.find(',', position_);
+  if (end == std::string_view::npos) {
+    field = fields_.substr(position_);
+    position_ = std::string_view::npos;
+  } else {
+    field = fields_.substr(position_, end - position_);
+    position_ = end + 1;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool NMEAFieldScanner::skip(const size_t & numberOfFields)
+{
+  std::string_view field;
+  for (size_t n = 0; n < numberOfFields; ++n) {
+    if (!next(field)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<double> parseNMEANumber(const std::string_view & field)
+{
+  double value;
+  const char * end = field.data() + field.size();
+  auto result = std::from_chars(field.data(), end, value);
+  // from_chars also accepts inf and nan, which NMEA does not
+  if (field.empty() || result.ec != std::errc() || result.ptr != end || !std::isfinite(value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+//-----------------------------------------------------------------------------
+TalkerId parseNMEATalker(const std::string_view & talker)
+{
+  if (talker == "GP") {
+    return TalkerId::GP;
+  } else if (talker == "GL") {
+    return TalkerId::GL;
+  } else if (talker == "GA") {
+    return TalkerId::GA;
+  } else if (talker == "GB") {
+    return TalkerId::GB;
+  } else if (talker == "GN") {
+    return TalkerId::GN;
+  }
+  return TalkerId::UNSUPPORTED;
+}
+
+//-----------------------------------------------------------------------------
+bool scanGGAFrame(const std::string_view & sentence, GGAFrame & ggaFrame)
+{
+  ggaFrame = GGAFrame();
+
+  NMEAFieldScanner scanner(sentence);
+  std::array<std::string_view, 14> fields;
+  if (!scanner.isValid() ||
+    scanner.getSentenceId() != "GGA" ||
+    scanFields(scanner, fields) != fields.size())
+  {
+    return false;
+  }
+
+  ggaFrame.talkerId = parseNMEATalker(scanner.getTalker());
+
+  if (auto latitude = parseNMEAAngle(fields[1], fields[2], 'S')) {
+    ggaFrame.latitude = Latitude(*latitude);
+  }
+
+  if (auto longitude = parseNMEAAngle(fields[3], fields[4], 'W')) {
+    ggaFrame.longitude = Longitude(*longitude);
+  }
+
+  auto fixQuality = parseNMEANumber(fields[5]);
+  if (fixQuality && *fixQuality >= static_cast<int>(FixQuality::INVALID_FIX) &&
+    *fixQuality <= static_cast<int>(FixQuality::SIMULATION_FIX))
+  {
+    ggaFrame.fixQuality = static_cast<FixQuality>(static_cast<int>(*fixQuality));
+  }
+
+  assign(ggaFrame.numberSatellitesUsedToComputeFix, parseNMEANumber(fields[6]));
+  assign(ggaFrame.horizontalDilutionOfPrecision, parseNMEANumber(fields[7]));
+  assign(ggaFrame.altitudeAboveGeoid, parseNMEANumber(fields[8]));
+  assign(ggaFrame.geoidHeight, parseNMEANumber(fields[10]));
+  assign(ggaFrame.dgpsCorrectionAgeInSecond, parseNMEANumber(fields[12]));
+  assign(ggaFrame.dgpsStationIdNumber, parseNMEANumber(fields[13]));
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool scanRMCFrame(const std::string_view & sentence, RMCFrame & rmcFrame)
+{
+  rmcFrame = RMCFrame();
+
+  NMEAFieldScanner scanner(sentence);
+  std::array<std::string_view, 11> fields;
+  if (!scanner.isValid() ||
+    scanner.getSentenceId() != "RMC" ||
+    scanFields(scanner, fields) != fields.size())
+  {
+    return false;
+  }
+
+  rmcFrame.talkerId = parseNMEATalker(scanner.getTalker());
+
+  if (auto speedOverGround = parseNMEANumber(fields[6])) {
+    rmcFrame.speedOverGroundInMeterPerSecond = *speedOverGround * KNOT_TO_METER_PER_SECOND;
+  }
+
+  if (auto trackAngle = parseNMEANumber(fields[7])) {
+    rmcFrame.trackAngleTrue = *trackAngle * DEGREE_TO_RADIAN;
+  }
+
+  if (auto magneticDeviation = parseNMEANumber(fields[9])) {
+    double sign = fields[10] == "W" ? -1 : 1;
+    rmcFrame.magneticDeviation = sign * *magneticDeviation * DEGREE_TO_RADIAN;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool scanHDTFrame(const std::string_view & sentence, HDTFrame & hdtFrame)
+{
+  hdtFrame = HDTFrame();
+
+  NMEAFieldScanner scanner(sentence);
+  std::array<std::string_view, 2> fields;
+  if (!scanner.isValid() ||
+    scanner.getSentenceId() != "HDT" ||
+    scanFields(scanner, fields) != fields.size())
+  {
+    return false;
+  }
+
+  hdtFrame.talkerId = parseNMEATalker(scanner.getTalker());
+
+  if (auto heading = parseNMEANumber(fields[0])) {
+    hdtFrame.heading = *heading * DEGREE_TO_RADIAN;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool scanGSTFrame(const std::string_view & sentence, GSTFrame & gstFrame)
+{
+  gstFrame = GSTFrame();
+
+  NMEAFieldScanner scanner(sentence);
+  std::array<std::string_view, 8> fields;
+  if (!scanner.isValid() ||
+    scanner.getSentenceId() != "GST" ||
+    scanFields(scanner, fields) != fields.size())
+  {
+    return false;
+  }
+
+  gstFrame.talkerId = parseNMEATalker(scanner.getTalker());
+
+  assign(gstFrame.rangeRMS, parseNMEANumber(fields[1]));
+  assign(gstFrame.semiMajorAxisStd, parseNMEANumber(fields[2]));
+  assign(gstFrame.semiMinorAxisStd, parseNMEANumber(fields[3]));
+  if (auto orientation = parseNMEANumber(fields[4])) {
+    gstFrame.semiMajorAxisOrientation = *orientation * DEGREE_TO_RADIAN;
+  }
+  assign(gstFrame.latitudeStd, parseNMEANumber(fields[5]));
+  assign(gstFrame.longitudeStd, parseNMEANumber(fields[6]));
+  assign(gstFrame.altitudeStd, parseNMEANumber(fields[7]));
+  return true;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,155 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <array>
+
+// local
+#include "romea_core_localisation_gps/NMEASentenceClassifier.hpp"
+
+namespace
+{
+
+using romea::core::NMEASentenceType;
+
+struct SentenceIdSlot
+{
+  char id[3];
+  NMEASentenceType type;
+};
+
+constexpr SentenceIdSlot SENTENCE_IDS[] = {
+  {{'G', 'G', 'A'}, NMEASentenceType::GGA},
+  {{'R', 'M', 'C'}, NMEASentenceType::RMC},
+  {{'H', 'D', 'T'}, NMEASentenceType::HDT},
+  {{'G', 'S', 'V'}, NMEASentenceType::GSV},
+  {{'G', 'S', 'A'}, NMEASentenceType::GSA},
+  {{'V', 'T', 'G'}, NMEASentenceType::VTG},
+  {{'Z', 'D', 'A'}, NMEASentenceType::ZDA},
+  {{'G', 'S', 'T'}, NMEASentenceType::GST}};
+
+constexpr size_t NUMBER_OF_SLOTS = 16;
+
+//-----------------------------------------------------------------------------
+// collision free for the ids above, checked by the static_assert below
+constexpr size_t hashSentenceId(const char & c0, const char & c1, const char & c2)
+{
+  return (static_cast<unsigned char>(c0) ^
+         (static_cast<unsigned char>(c1) << 1) ^
+         static_cast<unsigned char>(c2)) & (NUMBER_OF_SLOTS - 1);
+}
+
+//-----------------------------------------------------------------------------
+constexpr std::array<SentenceIdSlot, NUMBER_OF_SLOTS> makeSlots()
+{
+  // empty slots hold a null id which no sentence matches
+  std::array<SentenceIdSlot, NUMBER_OF_SLOTS> slots{};
+  for (auto & slot : slots) {
+    slot.type = NMEASentenceType::UNSUPPORTED;
+  }
+  for (const auto & sentenceId : SENTENCE_IDS) {
+    slots[hashSentenceId(sentenceId.id[0], sentenceId.id[1], sentenceId.id[2])] = sentenceId;
+  }
+  return slots;
+}
+
+constexpr std::array<SentenceIdSlot, NUMBER_OF_SLOTS> SLOTS = makeSlots();
+
+//-----------------------------------------------------------------------------
+constexpr bool isHashPerfect()
+{
+  for (const auto & sentenceId : SENTENCE_IDS) {
+    const auto & slot = SLOTS[hashSentenceId(sentenceId.id[0], sentenceId.id[1], sentenceId.id[2])];
+    if (slot.type != sentenceId.type) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(isHashPerfect(), "sentence id hash has collisions");
+
+//-----------------------------------------------------------------------------
+constexpr bool isUpper(const char & c)
+{
+  return c >= 'A' && c <= 'Z';
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+const char * toString(const NMEASentenceType & type)
+{
+  switch (type) {
+    case NMEASentenceType::GGA:
+      return "gga";
+    case NMEASentenceType::RMC:
+      return "rmc";
+    case NMEASentenceType::HDT:
+      return "hdt";
+    case NMEASentenceType::GSV:
+      return "gsv";
+    case NMEASentenceType::GSA:
+      return "gsa";
+    case NMEASentenceType::VTG:
+      return "vtg";
+    case NMEASentenceType::ZDA:
+      return "zda";
+    case NMEASentenceType::GST:
+      return "gst";
+    case NMEASentenceType::PROPRIETARY:
+      return "proprietary";
+    case NMEASentenceType::UNSUPPORTED:
+      return "unsupported";
+    case NMEASentenceType::MALFORMED:
+      return "malformed";
+    default:
+      return "unknown";
+  }
+}
+
+//-----------------------------------------------------------------------------
+NMEASentenceType classifyNMEASentence(const std::string_view & sentence)
+{
+  if (sentence.size() < 3 || sentence[0] != '$') {
+    return NMEASentenceType::MALFORMED;
+  }
+
+  if (sentence[1] == 'P') {
+    return isUpper(sentence[2]) ? NMEASentenceType::PROPRIETARY : NMEASentenceType::MALFORMED;
+  }
+
+  // the address must be made of five upper case characters
+  if (sentence.size() < 6 ||
+    (sentence.size() > 6 && sentence[6] != ',' && sentence[6] != '*') ||
+    !isUpper(sentence[1]) || !isUpper(sentence[2]))
+  {
+    return NMEASentenceType::MALFORMED;
+  }
+
+  const SentenceIdSlot & slot = SLOTS[hashSentenceId(sentence[3], sentence[4], sentence[5])];
+  if (slot.id[0] == sentence[3] && slot.id[1] == sentence[4] && slot.id[2] == sentence[5]) {
+    return slot.type;
+  }
+  return NMEASentenceType::UNSUPPORTED;
+}
+
+}  // namespace core
+}  // namespace romea
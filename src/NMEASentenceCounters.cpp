@@ -0,0 +1,69 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <string>
+
+// local
+#include "romea_core_localisation_gps/NMEASentenceCounters.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+NMEASentenceCounters::NMEASentenceCounters()
+: counts_()
+{
+  reset();
+}
+
+//-----------------------------------------------------------------------------
+void NMEASentenceCounters::count(const NMEASentenceType & type)
+{
+  counts_[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t NMEASentenceCounters::getCount(const NMEASentenceType & type) const
+{
+  return counts_[static_cast<size_t>(type)].load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport NMEASentenceCounters::getReport() const
+{
+  DiagnosticReport report;
+  for (size_t n = 0; n < counts_.size(); ++n) {
+    uint64_t count = counts_[n].load(std::memory_order_relaxed);
+    if (count != 0) {
+      auto type = static_cast<NMEASentenceType>(n);
+      setReportInfo(report, std::string("nmea_") + toString(type) + "_sentences", count);
+    }
+  }
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+void NMEASentenceCounters::reset()
+{
+  for (auto & count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace core
+}  // namespace romea
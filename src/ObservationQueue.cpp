@@ -0,0 +1,183 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <chrono>
+
+// local
+#include "romea_core_localisation_gps/ObservationQueue.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void updateMaximum(std::atomic<T> & maximum, const T & value)
+{
+  T current = maximum.load(std::memory_order_relaxed);
+  while (value > current &&
+    !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+ObservationQueue::ObservationQueue(const size_t & capacity)
+: queue_(capacity),
+  numberOfPublishedObservations_(0),
+  numberOfDroppedObservations_(0),
+  maximalDepth_(0),
+  numberOfDrainedObservations_(0),
+  latencySum_(0),
+  maximalLatency_(0),
+  numberOfReportedDrops_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Fill>
+bool ObservationQueue::publish_(Fill && fill)
+{
+  if (!queue_.tryEmplace(fill)) {
+    numberOfDroppedObservations_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  numberOfPublishedObservations_.fetch_add(1, std::memory_order_relaxed);
+  updateMaximum(maximalDepth_, queue_.size());
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool ObservationQueue::publish(
+  const uint32_t & sourceId,
+  const Duration & stamp,
+  const ObservationPosition & positionObs)
+{
+  return publish_(
+    [&](QueuedObservation & observation) {
+      observation.type = QueuedObservationType::POSITION;
+      observation.sourceId = sourceId;
+      observation.stamp = stamp;
+      observation.publicationTime = std::chrono::steady_clock::now();
+      observation.positionObs = positionObs;
+    });
+}
+
+//-----------------------------------------------------------------------------
+bool ObservationQueue::publish(
+  const uint32_t & sourceId,
+  const Duration & stamp,
+  const ObservationCourse & courseObs)
+{
+  return publish_(
+    [&](QueuedObservation & observation) {
+      observation.type = QueuedObservationType::COURSE;
+      observation.sourceId = sourceId;
+      observation.stamp = stamp;
+      observation.publicationTime = std::chrono::steady_clock::now();
+      observation.courseObs = courseObs;
+    });
+}
+
+//-----------------------------------------------------------------------------
+void ObservationQueue::updateLatency_(
+  const size_t & numberOfObservations,
+  const Duration & latencySum,
+  const Duration & maximalLatency)
+{
+  numberOfDrainedObservations_.fetch_add(numberOfObservations, std::memory_order_relaxed);
+  latencySum_.fetch_add(latencySum.count(), std::memory_order_relaxed);
+  updateMaximum(maximalLatency_, static_cast<int64_t>(maximalLatency.count()));
+}
+
+//-----------------------------------------------------------------------------
+size_t ObservationQueue::getCapacity() const
+{
+  return queue_.capacity();
+}
+
+//-----------------------------------------------------------------------------
+size_t ObservationQueue::getDepth() const
+{
+  return queue_.size();
+}
+
+//-----------------------------------------------------------------------------
+size_t ObservationQueue::getMaximalDepth() const
+{
+  return maximalDepth_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t ObservationQueue::getNumberOfPublishedObservations() const
+{
+  return numberOfPublishedObservations_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t ObservationQueue::getNumberOfDroppedObservations() const
+{
+  return numberOfDroppedObservations_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+Duration ObservationQueue::getMeanLatency() const
+{
+  uint64_t numberOfDrainedObservations =
+    numberOfDrainedObservations_.load(std::memory_order_relaxed);
+  if (numberOfDrainedObservations == 0) {
+    return Duration::zero();
+  }
+  return Duration(
+    latencySum_.load(std::memory_order_relaxed) /
+    static_cast<int64_t>(numberOfDrainedObservations));
+}
+
+//-----------------------------------------------------------------------------
+Duration ObservationQueue::getMaximalLatency() const
+{
+  return Duration(maximalLatency_.load(std::memory_order_relaxed));
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport ObservationQueue::getReport() const
+{
+  DiagnosticReport report;
+  uint64_t numberOfDrops = getNumberOfDroppedObservations();
+  if (numberOfReportedDrops_.exchange(numberOfDrops, std::memory_order_relaxed) != numberOfDrops) {
+    report.diagnostics.push_back(
+      {DiagnosticStatus::WARN, "Observation queue is full, observations are dropped."});
+  }
+
+  setReportInfo(report, "observation_queue_depth", getDepth());
+  setReportInfo(report, "observation_queue_maximal_depth", getMaximalDepth());
+  setReportInfo(report, "observation_queue_drops", numberOfDrops);
+  setReportInfo(report, "observation_queue_mean_latency", durationToSecond(getMeanLatency()));
+  setReportInfo(
+    report, "observation_queue_maximal_latency", durationToSecond(getMaximalLatency()));
+  return report;
+}
+
+}  // namespace core
+}  // namespace romea
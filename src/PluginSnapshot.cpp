@@ -0,0 +1,253 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// local
+#include "romea_core_localisation_gps/PluginSnapshot.hpp"
+
+namespace
+{
+
+const uint8_t SNAPSHOT_ENCODING_VERSION = 1;
+
+// maximal number of items of a snapshot list, guards decoding of corrupted
+// buffers against huge allocations
+const uint64_t MAXIMAL_LIST_SIZE = 1024;
+
+//-----------------------------------------------------------------------------
+uint64_t zigzag(const int64_t & value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+//-----------------------------------------------------------------------------
+int64_t unzigzag(const uint64_t & value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+//-----------------------------------------------------------------------------
+void writeVarint(std::vector<uint8_t> & buffer, uint64_t value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+//-----------------------------------------------------------------------------
+void writeDouble(std::vector<uint8_t> & buffer, const double & value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (size_t n = 0; n < sizeof(bits); ++n) {
+    buffer.push_back(static_cast<uint8_t>(bits >> (8 * n)));
+  }
+}
+
+//-----------------------------------------------------------------------------
+void writeString(std::vector<uint8_t> & buffer, const std::string & value)
+{
+  writeVarint(buffer, value.size());
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+//-----------------------------------------------------------------------------
+void writeStamp(std::vector<uint8_t> & buffer, const romea::core::Duration & stamp)
+{
+  writeVarint(buffer, zigzag(stamp.count()));
+}
+
+//-----------------------------------------------------------------------------
+// stamps are stored as differences with the snapshot stamp
+void writeStamps(
+  std::vector<uint8_t> & buffer,
+  const std::vector<romea::core::Duration> & stamps,
+  const romea::core::Duration & reference)
+{
+  writeVarint(buffer, stamps.size());
+  for (const auto & stamp : stamps) {
+    writeStamp(buffer, reference - stamp);
+  }
+}
+
+//-----------------------------------------------------------------------------
+class Reader
+{
+public:
+  explicit Reader(const std::vector<uint8_t> & buffer)
+  : buffer_(buffer),
+    position_(0)
+  {
+  }
+
+  uint8_t readByte()
+  {
+    if (position_ >= buffer_.size()) {
+      throw std::runtime_error("Plugin snapshot is truncated.");
+    }
+    return buffer_[position_++];
+  }
+
+  uint64_t readVarint()
+  {
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = readByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    throw std::runtime_error("Plugin snapshot contains an invalid varint.");
+  }
+
+  double readDouble()
+  {
+    uint64_t bits = 0;
+    for (size_t n = 0; n < sizeof(bits); ++n) {
+      bits |= static_cast<uint64_t>(readByte()) << (8 * n);
+    }
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  size_t readSize()
+  {
+    uint64_t size = readVarint();
+    if (size > buffer_.size() - position_ || size > MAXIMAL_LIST_SIZE) {
+      throw std::runtime_error("Plugin snapshot is truncated.");
+    }
+    return static_cast<size_t>(size);
+  }
+
+  std::string readString()
+  {
+    size_t size = readSize();
+    std::string value(buffer_.begin() + position_, buffer_.begin() + position_ + size);
+    position_ += size;
+    return value;
+  }
+
+  romea::core::Duration readStamp()
+  {
+    return romea::core::Duration(unzigzag(readVarint()));
+  }
+
+  std::vector<romea::core::Duration> readStamps(const romea::core::Duration & reference)
+  {
+    std::vector<romea::core::Duration> stamps(readSize());
+    for (auto & stamp : stamps) {
+      stamp = reference - readStamp();
+    }
+    return stamps;
+  }
+
+  bool isAtEnd() const
+  {
+    return position_ == buffer_.size();
+  }
+
+private:
+  const std::vector<uint8_t> & buffer_;
+  size_t position_;
+};
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PluginSnapshot makeEmptyPluginSnapshot(const Duration & stamp)
+{
+  PluginSnapshot snapshot;
+  snapshot.stamp = stamp;
+  snapshot.lastGGAStamp = Duration::zero();
+  snapshot.linearSpeed = std::numeric_limits<double>::quiet_NaN();
+  return snapshot;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<uint8_t> encode(const PluginSnapshot & snapshot)
+{
+  std::vector<uint8_t> buffer;
+  buffer.push_back(SNAPSHOT_ENCODING_VERSION);
+  writeStamp(buffer, snapshot.stamp);
+  writeDouble(buffer, snapshot.anchor.getLatitude());
+  writeDouble(buffer, snapshot.anchor.getLongitude());
+  writeDouble(buffer, snapshot.anchor.getAltitude());
+
+  writeStamps(buffer, snapshot.ggaStamps, snapshot.stamp);
+  writeStamp(buffer, snapshot.stamp - snapshot.lastGGAStamp);
+  writeString(buffer, snapshot.lastGGASentence);
+  writeVarint(buffer, snapshot.gsvSentences.size());
+  for (const auto & sentence : snapshot.gsvSentences) {
+    writeString(buffer, sentence);
+  }
+
+  writeDouble(buffer, snapshot.linearSpeed);
+  writeStamps(buffer, snapshot.linearSpeedStamps, snapshot.stamp);
+  writeStamps(buffer, snapshot.rmcStamps, snapshot.stamp);
+  writeStamps(buffer, snapshot.hdtStamps, snapshot.stamp);
+  return buffer;
+}
+
+//-----------------------------------------------------------------------------
+PluginSnapshot decodePluginSnapshot(const std::vector<uint8_t> & buffer)
+{
+  Reader reader(buffer);
+  if (reader.readByte() != SNAPSHOT_ENCODING_VERSION) {
+    throw std::runtime_error("Plugin snapshot encoding version is not supported.");
+  }
+
+  PluginSnapshot snapshot = makeEmptyPluginSnapshot(reader.readStamp());
+  double latitude = reader.readDouble();
+  double longitude = reader.readDouble();
+  double altitude = reader.readDouble();
+  snapshot.anchor = makeGeodeticCoordinates(latitude, longitude, altitude);
+
+  snapshot.ggaStamps = reader.readStamps(snapshot.stamp);
+  snapshot.lastGGAStamp = snapshot.stamp - reader.readStamp();
+  snapshot.lastGGASentence = reader.readString();
+  size_t numberOfGSVSentences = reader.readSize();
+  for (size_t n = 0; n < numberOfGSVSentences; ++n) {
+    snapshot.gsvSentences.push_back(reader.readString());
+  }
+
+  snapshot.linearSpeed = reader.readDouble();
+  snapshot.linearSpeedStamps = reader.readStamps(snapshot.stamp);
+  snapshot.rmcStamps = reader.readStamps(snapshot.stamp);
+  snapshot.hdtStamps = reader.readStamps(snapshot.stamp);
+
+  if (!reader.isAtEnd()) {
+    throw std::runtime_error("Plugin snapshot has trailing bytes.");
+  }
+
+  return snapshot;
+}
+
+}  // namespace core
+}  // namespace romea
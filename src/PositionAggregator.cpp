@@ -0,0 +1,126 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_gps/PositionAggregator.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PositionAggregator::PositionAggregator(
+  const size_t & numberOfFixes,
+  const Duration & window)
+: numberOfFixes_(numberOfFixes),
+  window_(window),
+  firstStamp_(Duration::zero()),
+  lastTime_(0),
+  numberOfAccumulatedFixes_(0),
+  firstPosition_(Eigen::Vector2d::Zero()),
+  weightSum_(0),
+  timeSum_(0),
+  squaredTimeSum_(0),
+  positionSum_(Eigen::Vector2d::Zero()),
+  timePositionSum_(Eigen::Vector2d::Zero())
+{
+}
+
+//-----------------------------------------------------------------------------
+bool PositionAggregator::isEnabled() const
+{
+  return numberOfFixes_ != 1 || window_ != Duration::zero();
+}
+
+//-----------------------------------------------------------------------------
+bool PositionAggregator::add(
+  const Duration & stamp,
+  const ObservationPosition & positionObs,
+  const double & fixStd)
+{
+  if (numberOfAccumulatedFixes_ != 0 && stamp < firstStamp_) {
+    reset();
+  }
+
+  if (numberOfAccumulatedFixes_ == 0) {
+    firstStamp_ = stamp;
+    firstPosition_ = positionObs.Y();
+  }
+
+  double weight = 1. / (fixStd * fixStd);
+  double time = durationToSecond(stamp - firstStamp_);
+  Eigen::Vector2d position = positionObs.Y() - firstPosition_;
+
+  weightSum_ += weight;
+  timeSum_ += weight * time;
+  squaredTimeSum_ += weight * time * time;
+  positionSum_ += weight * position;
+  timePositionSum_ += weight * time * position;
+  lastTime_ = time;
+  numberOfAccumulatedFixes_++;
+
+  return (numberOfFixes_ != 0 && numberOfAccumulatedFixes_ >= numberOfFixes_) ||
+         (window_ != Duration::zero() && stamp - firstStamp_ >= window_);
+}
+
+//-----------------------------------------------------------------------------
+double PositionAggregator::makePositionObservation(ObservationPosition & positionObs)
+{
+  double meanTime = timeSum_ / weightSum_;
+  Eigen::Vector2d meanPosition = positionSum_ / weightSum_;
+
+  // weighted least squares velocity, left null when all the fixes share
+  // the same stamp
+  Eigen::Vector2d velocity = Eigen::Vector2d::Zero();
+  double timeVariance = squaredTimeSum_ - weightSum_ * meanTime * meanTime;
+  if (timeVariance > std::numeric_limits<double>::epsilon() * squaredTimeSum_) {
+    velocity = (timePositionSum_ - weightSum_ * meanTime * meanPosition) / timeVariance;
+  }
+
+  // the weighted mean of the fix variances is numberOfFixes / weightSum,
+  // the leverage of the last fix in the regression being at most one
+  double positionVariance = numberOfAccumulatedFixes_ / weightSum_;
+  positionObs.Y() = firstPosition_ + meanPosition + velocity * (lastTime_ - meanTime);
+  positionObs.R() = Eigen::Matrix2d::Identity() * positionVariance;
+
+  reset();
+  return std::sqrt(positionVariance);
+}
+
+//-----------------------------------------------------------------------------
+void PositionAggregator::reset()
+{
+  numberOfAccumulatedFixes_ = 0;
+  lastTime_ = 0;
+  weightSum_ = 0;
+  timeSum_ = 0;
+  squaredTimeSum_ = 0;
+  positionSum_.setZero();
+  timePositionSum_.setZero();
+}
+
+//-----------------------------------------------------------------------------
+size_t PositionAggregator::getNumberOfAccumulatedFixes() const
+{
+  return numberOfAccumulatedFixes_;
+}
+
+}  // namespace core
+}  // namespace romea
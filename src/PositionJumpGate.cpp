@@ -0,0 +1,214 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_gps/PositionJumpGate.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+double positionStd(const romea::core::ObservationPosition & positionObs)
+{
+  return std::sqrt(positionObs.R().trace() / 2.);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PositionJumpGate::PositionJumpGate(
+  const double & maximalAcceleration,
+  const double & gateThreshold,
+  const double & rejectionThreshold,
+  const Duration & maximalGap,
+  const size_t & maximalConsecutiveRejections)
+: maximalAcceleration_(maximalAcceleration),
+  gateThreshold_(gateThreshold),
+  rejectionThreshold_(rejectionThreshold),
+  maximalGap_(maximalGap),
+  maximalConsecutiveRejections_(maximalConsecutiveRejections),
+  window_(),
+  windowBegin_(0),
+  windowSize_(0),
+  windowLength_(0),
+  windowDuration_(0),
+  consecutiveRejections_(0),
+  lastDecision_(Decision::ACCEPTED),
+  lastExcess_(0),
+  numberOfRejections_(0),
+  numberOfInflations_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+PositionJumpGate::Decision PositionJumpGate::evaluate(
+  const Duration & stamp,
+  const double & linearSpeed,
+  ObservationPosition & positionObs)
+{
+  if (windowSize_ != 0) {
+    const Sample & last = window_[(windowBegin_ + windowSize_ - 1) % WINDOW_SIZE];
+    Duration elapsedTime = stamp - last.stamp;
+    if (elapsedTime <= Duration::zero() || elapsedTime > maximalGap_ ||
+      consecutiveRejections_ >= maximalConsecutiveRejections_)
+    {
+      restart_();
+    }
+  }
+
+  Decision decision = Decision::ACCEPTED;
+  double excess = 0;
+
+  if (windowSize_ != 0) {
+    const Sample & last = window_[(windowBegin_ + windowSize_ - 1) % WINDOW_SIZE];
+    double dt = durationToSecond(stamp - last.stamp);
+
+    double speed = std::abs(linearSpeed);
+    if (!std::isfinite(speed)) {
+      speed = windowDuration_ > 0 ? windowLength_ / windowDuration_ :
+        std::numeric_limits<double>::infinity();
+    }
+
+    double displacement = std::hypot(
+      positionObs.Y(ObservationPosition::POSITION_X) - last.x,
+      positionObs.Y(ObservationPosition::POSITION_Y) - last.y);
+    double predictedDisplacement = speed * dt + maximalAcceleration_ * dt * dt / 2.;
+    double combinedStd = std::hypot(positionStd(positionObs), last.std);
+
+    if (std::isfinite(predictedDisplacement) && combinedStd > 0) {
+      excess = (displacement - predictedDisplacement) / combinedStd;
+      if (excess > rejectionThreshold_) {
+        decision = Decision::REJECTED;
+      } else if (excess > gateThreshold_) {
+        decision = Decision::INFLATED;
+        positionObs.R() *= (excess / gateThreshold_) * (excess / gateThreshold_);
+      }
+    }
+  }
+
+  if (decision == Decision::REJECTED) {
+    ++consecutiveRejections_;
+    numberOfRejections_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    accept_(stamp, positionObs);
+    if (decision == Decision::INFLATED) {
+      numberOfInflations_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  lastExcess_.store(excess, std::memory_order_relaxed);
+  lastDecision_.store(decision, std::memory_order_relaxed);
+  return decision;
+}
+
+//-----------------------------------------------------------------------------
+void PositionJumpGate::reset()
+{
+  restart_();
+  lastExcess_.store(0, std::memory_order_relaxed);
+  lastDecision_.store(Decision::ACCEPTED, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void PositionJumpGate::restart_()
+{
+  windowBegin_ = 0;
+  windowSize_ = 0;
+  windowLength_ = 0;
+  windowDuration_ = 0;
+  consecutiveRejections_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+void PositionJumpGate::accept_(
+  const Duration & stamp,
+  const ObservationPosition & positionObs)
+{
+  Sample sample;
+  sample.stamp = stamp;
+  sample.x = positionObs.Y(ObservationPosition::POSITION_X);
+  sample.y = positionObs.Y(ObservationPosition::POSITION_Y);
+  sample.std = positionStd(positionObs);
+  sample.stepLength = 0;
+  sample.stepDuration = 0;
+
+  if (windowSize_ != 0) {
+    const Sample & last = window_[(windowBegin_ + windowSize_ - 1) % WINDOW_SIZE];
+    sample.stepLength = std::hypot(sample.x - last.x, sample.y - last.y);
+    sample.stepDuration = durationToSecond(stamp - last.stamp);
+  }
+
+  if (windowSize_ == WINDOW_SIZE) {
+    // the step of the new oldest sample leaves the window
+    windowBegin_ = (windowBegin_ + 1) % WINDOW_SIZE;
+    windowSize_--;
+    windowLength_ -= window_[windowBegin_].stepLength;
+    windowDuration_ -= window_[windowBegin_].stepDuration;
+    window_[windowBegin_].stepLength = 0;
+    window_[windowBegin_].stepDuration = 0;
+  }
+
+  window_[(windowBegin_ + windowSize_) % WINDOW_SIZE] = sample;
+  windowSize_++;
+  windowLength_ += sample.stepLength;
+  windowDuration_ += sample.stepDuration;
+  consecutiveRejections_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t PositionJumpGate::getNumberOfRejections() const
+{
+  return numberOfRejections_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t PositionJumpGate::getNumberOfInflations() const
+{
+  return numberOfInflations_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport PositionJumpGate::getReport() const
+{
+  DiagnosticReport report;
+  Decision decision = lastDecision_.load(std::memory_order_relaxed);
+  if (decision == Decision::REJECTED) {
+    report.diagnostics.push_back({DiagnosticStatus::WARN, "GGA position jump rejected."});
+  } else if (decision == Decision::INFLATED) {
+    report.diagnostics.push_back(
+      {DiagnosticStatus::WARN, "GGA position covariance inflated after a jump."});
+  }
+
+  setReportInfo(report, "position_jumps_rejected", getNumberOfRejections());
+  setReportInfo(report, "position_jumps_inflated", getNumberOfInflations());
+  if (decision != Decision::ACCEPTED) {
+    // normalized excess of displacement, only reported for gated fixes to
+    // keep report deltas quiet while positions are consistent
+    setReportInfo(report, "position_jump_excess", lastExcess_.load(std::memory_order_relaxed));
+  }
+  return report;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,263 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// posix
+#include <unistd.h>
+
+// local
+#include "romea_core_localisation_gps/ProcessingTracer.hpp"
+
+namespace
+{
+
+struct TraceBuffer
+{
+  explicit TraceBuffer(const uint32_t & index, const size_t & capacity)
+  : threadIndex(index),
+    threadName("thread " + std::to_string(index)),
+    events(capacity),
+    size(0),
+    numberOfDroppedEvents(0),
+    isReleased(false)
+  {
+  }
+
+  uint32_t threadIndex;
+  // guarded by the registry mutex
+  std::string threadName;
+  // written by the owning thread only, events before size are published
+  std::vector<romea::core::TraceEvent> events;
+  std::atomic<size_t> size;
+  std::atomic<uint64_t> numberOfDroppedEvents;
+  // set when the owning thread exits, guarded by the registry mutex
+  bool isReleased;
+};
+
+std::atomic<bool> tracingEnabled(false);
+std::atomic<size_t> bufferCapacity(romea::core::ProcessingTracer::DEFAULT_BUFFER_CAPACITY);
+
+std::mutex & registryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// buffers outlive their threads so that their events can still be written,
+// they are freed by the next reset
+std::vector<std::unique_ptr<TraceBuffer>> & registry()
+{
+  static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+  return buffers;
+}
+
+// releases the buffer of the thread when it exits
+struct ThreadBufferHolder
+{
+  ~ThreadBufferHolder()
+  {
+    if (buffer != nullptr) {
+      std::lock_guard<std::mutex> lock(registryMutex());
+      buffer->isReleased = true;
+    }
+  }
+
+  TraceBuffer * buffer = nullptr;
+};
+
+thread_local ThreadBufferHolder threadBuffer;
+
+TraceBuffer & getThreadBuffer()
+{
+  if (threadBuffer.buffer == nullptr) {
+    // indices are never reused, even by threads created after a reset
+    static uint32_t nextThreadIndex = 0;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    auto & buffers = registry();
+    buffers.push_back(
+      std::make_unique<TraceBuffer>(
+        nextThreadIndex++,
+        bufferCapacity.load(std::memory_order_relaxed)));
+    threadBuffer.buffer = buffers.back().get();
+  }
+  return *threadBuffer.buffer;
+}
+
+const char * toString(const romea::core::TraceOutcome & outcome)
+{
+  switch (outcome) {
+    case romea::core::TraceOutcome::OBSERVATION:
+      return "observation";
+    case romea::core::TraceOutcome::NO_OBSERVATION:
+      return "no_observation";
+    default:
+      return "none";
+  }
+}
+
+void writeJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << ' ';
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+double toMicroseconds(const std::chrono::steady_clock::duration & duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+void ProcessingTracer::enable(const bool & enabled)
+{
+  tracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+bool ProcessingTracer::isEnabled()
+{
+  return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void ProcessingTracer::setBufferCapacity(const size_t & capacity)
+{
+  bufferCapacity.store(capacity, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void ProcessingTracer::setThreadName(const std::string & name)
+{
+  TraceBuffer & buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock(registryMutex());
+  buffer.threadName = name;
+}
+
+//-----------------------------------------------------------------------------
+void ProcessingTracer::record(const TraceEvent & event)
+{
+  TraceBuffer & buffer = getThreadBuffer();
+  size_t size = buffer.size.load(std::memory_order_relaxed);
+  if (size == buffer.events.size()) {
+    buffer.numberOfDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  buffer.events[size] = event;
+  buffer.events[size].threadIndex = buffer.threadIndex;
+  buffer.size.store(size + 1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+std::vector<TraceEvent> ProcessingTracer::getEvents()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::vector<TraceEvent> events;
+  for (const auto & buffer : registry()) {
+    size_t size = buffer->size.load(std::memory_order_acquire);
+    events.insert(events.end(), buffer->events.begin(), buffer->events.begin() + size);
+  }
+  return events;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t ProcessingTracer::getNumberOfDroppedEvents()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  uint64_t numberOfDroppedEvents = 0;
+  for (const auto & buffer : registry()) {
+    numberOfDroppedEvents += buffer->numberOfDroppedEvents.load(std::memory_order_relaxed);
+  }
+  return numberOfDroppedEvents;
+}
+
+//-----------------------------------------------------------------------------
+void ProcessingTracer::writeChromeTrace(std::ostream & os)
+{
+  const pid_t pid = ::getpid();
+
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::ios_base::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+  const char * separator = "\n";
+  for (const auto & buffer : registry()) {
+    os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid <<
+      ",\"tid\":" << buffer->threadIndex << ",\"args\":{\"name\":";
+    writeJSONString(os, buffer->threadName);
+    os << "}}";
+    separator = ",\n";
+
+    size_t size = buffer->size.load(std::memory_order_acquire);
+    for (size_t n = 0; n < size; ++n) {
+      const TraceEvent & event = buffer->events[n];
+      os << separator << "{\"name\":\"" << event.name << "\",\"cat\":\"gps\",\"ph\":\"X\"" <<
+        ",\"pid\":" << pid << ",\"tid\":" << event.threadIndex <<
+        std::fixed << std::setprecision(3) <<
+        ",\"ts\":" << toMicroseconds(event.beginTime.time_since_epoch()) <<
+        ",\"dur\":" << toMicroseconds(event.endTime - event.beginTime) <<
+        std::setprecision(9) <<
+        ",\"args\":{\"stamp\":" << durationToSecond(event.stamp) <<
+        ",\"outcome\":\"" << toString(event.outcome) << "\"}}";
+    }
+  }
+
+  os << "\n]}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+//-----------------------------------------------------------------------------
+void ProcessingTracer::reset()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  auto & buffers = registry();
+  buffers.erase(
+    std::remove_if(
+      buffers.begin(), buffers.end(),
+      [](const std::unique_ptr<TraceBuffer> & buffer) {return buffer->isReleased;}),
+    buffers.end());
+  for (auto & buffer : buffers) {
+    buffer->size.store(0, std::memory_order_relaxed);
+    buffer->numberOfDroppedEvents.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace core
+}  // namespace romea
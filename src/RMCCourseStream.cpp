@@ -0,0 +1,144 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_gps/RMCCourseStream.hpp"
+#include "romea_core_localisation_gps/GPSObservations.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+RMCCourseStream::RMCCourseStream(
+  const GPSReceiver & /*gps*/,
+  const Parameters & minimalSpeedOverGround)
+: linearSpeed_(std::numeric_limits<double>::quiet_NaN()),
+  linearSpeedRateDiagnostic_(GPSCheckup::LINEAR_SPEED_RATE, "linear_speed", LINEAR_SPEED_RATE),
+  rmcRateDiagnostic_(GPSCheckup::RMC_RATE, "rmc", RMC_RATE),
+  rmcTrackAngleDiagnostic_(minimalSpeedOverGround)
+{
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::processLinearSpeed(
+  const Duration & stamp,
+  const double & linearSpeed,
+  StatusTransitionNotifier & notifier)
+{
+  linearSpeed_.store(linearSpeed);
+  linearSpeedRateDiagnostic_.evaluate(stamp, notifier);
+}
+
+//-----------------------------------------------------------------------------
+bool RMCCourseStream::processRMC(
+  const Duration & stamp,
+  const RMCFrame & rmcFrame,
+  const double & positionStd,
+  StatusTransitionNotifier & notifier,
+  ObservationCourse & courseObs)
+{
+  if (rmcRateDiagnostic_.evaluate(stamp, notifier) != DiagnosticStatus::OK) {
+    return false;
+  }
+
+  DiagnosticStatus status = rmcTrackAngleDiagnostic_.evaluate(rmcFrame, stamp);
+  notifier.update(GPSCheckup::RMC_TRACK_ANGLE, stamp, status);
+
+  double linearSpeed = linearSpeed_.load();
+  if (status == DiagnosticStatus::OK && std::isfinite(linearSpeed)) {
+    makeRMCCourseObservation(rmcFrame, linearSpeed, positionStd, 1 / RMC_RATE, courseObs);
+    return true;
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::checkHeartBeats(
+  const Duration & stamp,
+  StatusTransitionNotifier & notifier)
+{
+  if (!linearSpeedRateDiagnostic_.checkHeartBeat(stamp, notifier)) {
+    linearSpeed_ = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  if (!rmcRateDiagnostic_.checkHeartBeat(stamp, notifier)) {
+    rmcTrackAngleDiagnostic_.reset();
+    notifier.update(GPSCheckup::RMC_TRACK_ANGLE, stamp, std::nullopt);
+  }
+}
+
+//-----------------------------------------------------------------------------
+const std::atomic<double> & RMCCourseStream::getLinearSpeed() const
+{
+  return linearSpeed_;
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::appendOdometryReport(DiagnosticReport & report) const
+{
+  report += linearSpeedRateDiagnostic_.getReport();
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::appendReport(DiagnosticReport & report) const
+{
+  report += rmcRateDiagnostic_.getReport();
+  report += rmcTrackAngleDiagnostic_.getReport();
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::dumpOdometryHistory(std::ostream & os) const
+{
+  linearSpeedRateDiagnostic_.getHistory().dump(os);
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::dumpHistory(std::ostream & os) const
+{
+  rmcRateDiagnostic_.getHistory().dump(os);
+  rmcTrackAngleDiagnostic_.getHistory().dump(os);
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::saveSnapshot(PluginSnapshot & snapshot) const
+{
+  snapshot.linearSpeed = linearSpeed_.load();
+  snapshot.linearSpeedStamps = linearSpeedRateDiagnostic_.getLastStamps(
+    PluginSnapshot::NUMBER_OF_RATE_STAMPS);
+  snapshot.rmcStamps = rmcRateDiagnostic_.getLastStamps(PluginSnapshot::NUMBER_OF_RATE_STAMPS);
+}
+
+//-----------------------------------------------------------------------------
+void RMCCourseStream::restoreSnapshot(
+  const PluginSnapshot & snapshot,
+  const Duration & shift,
+  StatusTransitionNotifier & notifier)
+{
+  if (!snapshot.linearSpeedStamps.empty()) {
+    linearSpeed_.store(snapshot.linearSpeed);
+    linearSpeedRateDiagnostic_.replay(snapshot.linearSpeedStamps, shift, notifier);
+  }
+  rmcRateDiagnostic_.replay(snapshot.rmcStamps, shift, notifier);
+}
+
+}  // namespace core
+}  // namespace romea
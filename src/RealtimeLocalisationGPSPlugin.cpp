@@ -0,0 +1,365 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+// local
+#include "romea_core_localisation_gps/RealtimeLocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+#include "romea_core_localisation_gps/GPSObservations.hpp"
+#include "romea_core_localisation_gps/NMEAFieldScanner.hpp"
+
+namespace
+{
+const double GGA_RATE = 1.0;
+const double RMC_RATE = 1.0;
+const double HDT_RATE = 1.0;
+const double LINEAR_SPEED_RATE = 10.0;
+const double RATE_EPSILON = 0.1;
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+RealtimeLocalisationGPSPluginBase::RealtimeLocalisationGPSPluginBase(
+  std::shared_ptr<LocalisationGPSPluginBase> plugin,
+  const FixQuality & minimalFixQuality,
+  const size_t & eventQueueCapacity)
+: plugin_(std::move(plugin)),
+  minimalFixQuality_(minimalFixQuality),
+  ggaRate_(GGA_RATE, RATE_EPSILON),
+  positionJumpGate_(),
+  positionStd_(std::numeric_limits<double>::quiet_NaN()),
+  ggaEvents_(eventQueueCapacity),
+  droppedEvents_(0),
+  pendingEventsMutex_(),
+  pendingPositionObs_(),
+  pendingCourseObs_()
+{
+  static_assert(std::atomic<double>::is_always_lock_free);
+  static_assert(std::atomic<uint64_t>::is_always_lock_free);
+  plugin_->setExternalPositionJumpGate(&positionJumpGate_);
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationGPSPluginBase::setAnchor(const GeodeticCoordinates & wgs84_anchor)
+{
+  plugin_->setAnchor(wgs84_anchor);
+  positionJumpGate_.reset();
+}
+
+//-----------------------------------------------------------------------------
+const ENUConverter & RealtimeLocalisationGPSPluginBase::getENUConverter()const
+{
+  return plugin_->getENUConverter();
+}
+
+//-----------------------------------------------------------------------------
+bool RealtimeLocalisationGPSPluginBase::processGGA(
+  const Duration & stamp,
+  const std::string_view & ggaSentence,
+  ObservationPosition & positionObs)
+{
+  GGAEvent event{stamp, GGAFrame()};
+  scanGGAFrame(ggaSentence, event.frame);
+  push_(ggaEvents_, event);
+
+  bool isFixValid = ggaRate_.evaluate(stamp) == DiagnosticStatus::OK &&
+    CheckupGGAFix::check(event.frame, minimalFixQuality_) == DiagnosticStatus::OK;
+
+  if (!isFixValid) {
+    return false;
+  }
+
+  double positionStd = makePositionObservation(
+    event.frame, plugin_->getENUConverter(), plugin_->getGPSReceiver(), positionObs);
+  double observationVariance = positionObs.R()(0, 0);
+
+  switch (positionJumpGate_.evaluate(stamp, getLinearSpeed_(stamp), positionObs)) {
+    case PositionJumpGate::Decision::REJECTED:
+      return false;
+    case PositionJumpGate::Decision::INFLATED:
+      positionStd *= std::sqrt(positionObs.R()(0, 0) / observationVariance);
+      break;
+    default:
+      break;
+  }
+
+  positionStd_.store(positionStd);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationGPSPluginBase::processGSV(const std::string & gsvSentence)
+{
+  std::lock_guard<std::mutex> lock(pendingEventsMutex_);
+  plugin_->processGSV(gsvSentence);
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationGPSPluginBase::processPendingEvents()
+{
+  std::lock_guard<std::mutex> lock(pendingEventsMutex_);
+
+  GGAEvent ggaEvent;
+  while (ggaEvents_.tryPop(ggaEvent)) {
+    plugin_->processGGA(ggaEvent.stamp, ggaEvent.frame, pendingPositionObs_);
+  }
+
+  processPendingEvents_();
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport RealtimeLocalisationGPSPluginBase::makeDiagnosticReport(const Duration & stamp)
+{
+  processPendingEvents();
+  DiagnosticReport report = makePluginDiagnosticReport_(stamp);
+  setReportInfo(report, "realtime_dropped_events", getNumberOfDroppedEvents());
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportDelta RealtimeLocalisationGPSPluginBase::makeDiagnosticReportDelta(
+  const Duration & stamp,
+  const uint64_t & sinceSequence)
+{
+  processPendingEvents();
+  return makePluginDiagnosticReportDelta_(stamp, sinceSequence);
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationGPSPluginBase::dumpDiagnosticHistory(std::ostream & os)
+{
+  processPendingEvents();
+  dumpPluginDiagnosticHistory_(os);
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationGPSPluginBase::registerStatusTransitionCallback(
+  const StatusTransitionCallback & callback)
+{
+  plugin_->registerStatusTransitionCallback(callback);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t RealtimeLocalisationGPSPluginBase::getNumberOfDroppedEvents() const
+{
+  return droppedEvents_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Event>
+void RealtimeLocalisationGPSPluginBase::push_(SPSCQueue<Event> & queue, const Event & event)
+{
+  if (!queue.tryPush(event)) {
+    droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//-----------------------------------------------------------------------------
+double RealtimeLocalisationGPSPluginBase::getPositionStd_(const Duration & stamp) const
+{
+  if (ggaRate_.isAlive(stamp)) {
+    return positionStd_.load();
+  } else {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+//-----------------------------------------------------------------------------
+double RealtimeLocalisationGPSPluginBase::getLinearSpeed_(const Duration &) const
+{
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+//-----------------------------------------------------------------------------
+RealtimeLocalisationSingleAntennaGPSPlugin::RealtimeLocalisationSingleAntennaGPSPlugin(
+  std::unique_ptr<GPSReceiver> gps,
+  const FixQuality & minimalFixQuality,
+  const double & minimalSpeedOverGround,
+  const size_t & eventQueueCapacity)
+: RealtimeLocalisationGPSPluginBase(
+    std::make_unique<LocalisationSingleAntennaGPSPlugin>(
+      std::move(gps), minimalFixQuality, minimalSpeedOverGround),
+    minimalFixQuality,
+    eventQueueCapacity),
+  singleAntennaPlugin_(static_cast<LocalisationSingleAntennaGPSPlugin &>(*plugin_)),
+  minimalSpeedOverGround_(minimalSpeedOverGround),
+  linearSpeedRate_(LINEAR_SPEED_RATE, RATE_EPSILON),
+  linearSpeed_(std::numeric_limits<double>::quiet_NaN()),
+  linearSpeedEvents_(static_cast<size_t>(eventQueueCapacity * LINEAR_SPEED_RATE / RMC_RATE)),
+  rmcRate_(RMC_RATE, RATE_EPSILON),
+  rmcEvents_(eventQueueCapacity)
+{
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationSingleAntennaGPSPlugin::processLinearSpeed(
+  const Duration & stamp,
+  const double & linearSpeed)
+{
+  linearSpeed_.store(linearSpeed);
+  linearSpeedRate_.evaluate(stamp);
+  push_(linearSpeedEvents_, {stamp, linearSpeed});
+}
+
+//-----------------------------------------------------------------------------
+bool RealtimeLocalisationSingleAntennaGPSPlugin::processRMC(
+  const Duration & stamp,
+  const std::string_view & rmcSentence,
+  ObservationCourse & courseObs)
+{
+  RMCEvent event{stamp, RMCFrame()};
+  scanRMCFrame(rmcSentence, event.frame);
+  push_(rmcEvents_, event);
+
+  bool isTrackAngleValid = rmcRate_.evaluate(stamp) == DiagnosticStatus::OK &&
+    CheckupRMCTrackAngle::check(event.frame, minimalSpeedOverGround_) == DiagnosticStatus::OK;
+
+  // the linear speed is lost when its stream is interrupted like in the regular plugin
+  double linearSpeed = linearSpeed_.load();
+  if (isTrackAngleValid && linearSpeedRate_.isAlive(stamp) && std::isfinite(linearSpeed)) {
+    makeRMCCourseObservation(
+      event.frame, linearSpeed, getPositionStd_(stamp), 1 / RMC_RATE, courseObs);
+    return true;
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+double RealtimeLocalisationSingleAntennaGPSPlugin::getLinearSpeed_(const Duration & stamp) const
+{
+  if (linearSpeedRate_.isAlive(stamp)) {
+    return linearSpeed_.load();
+  } else {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationSingleAntennaGPSPlugin::processPendingEvents_()
+{
+  LinearSpeedEvent linearSpeedEvent;
+  while (linearSpeedEvents_.tryPop(linearSpeedEvent)) {
+    singleAntennaPlugin_.processLinearSpeed(
+      linearSpeedEvent.stamp, linearSpeedEvent.linearSpeed);
+  }
+
+  RMCEvent rmcEvent;
+  while (rmcEvents_.tryPop(rmcEvent)) {
+    singleAntennaPlugin_.processRMC(rmcEvent.stamp, rmcEvent.frame, pendingCourseObs_);
+  }
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport RealtimeLocalisationSingleAntennaGPSPlugin::makePluginDiagnosticReport_(const Duration & stamp)
+{
+  return singleAntennaPlugin_.makeDiagnosticReport(stamp);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportDelta RealtimeLocalisationSingleAntennaGPSPlugin::makePluginDiagnosticReportDelta_(
+  const Duration & stamp,
+  const uint64_t & sinceSequence)
+{
+  return singleAntennaPlugin_.makeDiagnosticReportDelta(stamp, sinceSequence);
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationSingleAntennaGPSPlugin::dumpPluginDiagnosticHistory_(std::ostream & os) const
+{
+  singleAntennaPlugin_.dumpDiagnosticHistory(os);
+}
+
+//-----------------------------------------------------------------------------
+RealtimeLocalisationDualAntennaGPSPlugin::RealtimeLocalisationDualAntennaGPSPlugin(
+  std::unique_ptr<GPSReceiver> gps,
+  const FixQuality & minimalFixQuality,
+  const double & antennaBaseline,
+  const size_t & eventQueueCapacity)
+: RealtimeLocalisationGPSPluginBase(
+    std::make_unique<LocalisationDualAntennaGPSPlugin>(
+      std::move(gps), minimalFixQuality, antennaBaseline),
+    minimalFixQuality,
+    eventQueueCapacity),
+  dualAntennaPlugin_(static_cast<LocalisationDualAntennaGPSPlugin &>(*plugin_)),
+  courseAngleStd_(hdtCourseAngleStd(
+      antennaBaseline, plugin_->getGPSReceiver().getUERE(FixQuality::RTK_FIX))),
+  hdtRate_(HDT_RATE, RATE_EPSILON),
+  hdtEvents_(eventQueueCapacity)
+{
+}
+
+//-----------------------------------------------------------------------------
+bool RealtimeLocalisationDualAntennaGPSPlugin::processHDT(
+  const Duration & stamp,
+  const std::string_view & hdtSentence,
+  ObservationCourse & courseObs)
+{
+  HDTEvent event{stamp, HDTFrame()};
+  scanHDTFrame(hdtSentence, event.frame);
+  push_(hdtEvents_, event);
+
+  bool isTrackAngleValid = hdtRate_.evaluate(stamp) == DiagnosticStatus::OK &&
+    CheckupHDTTrackAngle::check(event.frame) == DiagnosticStatus::OK;
+
+  if (isTrackAngleValid) {
+    makeHDTCourseObservation(event.frame, courseAngleStd_, courseObs);
+    return true;
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationDualAntennaGPSPlugin::processPendingEvents_()
+{
+  HDTEvent hdtEvent;
+  while (hdtEvents_.tryPop(hdtEvent)) {
+    dualAntennaPlugin_.processHDT(hdtEvent.stamp, hdtEvent.frame, pendingCourseObs_);
+  }
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport RealtimeLocalisationDualAntennaGPSPlugin::makePluginDiagnosticReport_(const Duration & stamp)
+{
+  return dualAntennaPlugin_.makeDiagnosticReport(stamp);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReportDelta RealtimeLocalisationDualAntennaGPSPlugin::makePluginDiagnosticReportDelta_(
+  const Duration & stamp,
+  const uint64_t & sinceSequence)
+{
+  return dualAntennaPlugin_.makeDiagnosticReportDelta(stamp, sinceSequence);
+}
+
+//-----------------------------------------------------------------------------
+void RealtimeLocalisationDualAntennaGPSPlugin::dumpPluginDiagnosticHistory_(std::ostream & os) const
+{
+  dualAntennaPlugin_.dumpDiagnosticHistory(os);
+}
+
+}  // namespace core
+}  // namespace romea
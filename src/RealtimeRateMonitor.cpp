@@ -0,0 +1,75 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// local
+#include "romea_core_localisation_gps/RealtimeRateMonitor.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+RealtimeRateMonitor::RealtimeRateMonitor(
+  const double & rate,
+  const double & epsilon)
+: maximalWindowDuration_(),
+  timeout_(durationFromSecond(2 / rate * (1 + epsilon))),
+  stamps_(),
+  numberOfStamps_(0),
+  hasStamp_(false),
+  lastStamp_(Duration::zero())
+{
+  static_assert(std::atomic<Duration>::is_always_lock_free);
+
+  // window spanning WINDOW_SIZE - 1 periods received at the minimal rate
+  double minimalRate = rate * (1 - epsilon);
+  maximalWindowDuration_ = durationFromSecond((WINDOW_SIZE - 1) / minimalRate);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus RealtimeRateMonitor::evaluate(const Duration & stamp)
+{
+  if (numberOfStamps_ != 0) {
+    const Duration & lastStamp = stamps_[(numberOfStamps_ - 1) % WINDOW_SIZE];
+    if (stamp < lastStamp || stamp - lastStamp > timeout_) {
+      numberOfStamps_ = 0;
+    }
+  }
+
+  stamps_[numberOfStamps_ % WINDOW_SIZE] = stamp;
+  ++numberOfStamps_;
+
+  lastStamp_.store(stamp, std::memory_order_release);
+  hasStamp_.store(true, std::memory_order_release);
+
+  if (numberOfStamps_ < WINDOW_SIZE) {
+    return DiagnosticStatus::ERROR;
+  }
+
+  const Duration & oldestStamp = stamps_[numberOfStamps_ % WINDOW_SIZE];
+  return stamp - oldestStamp <= maximalWindowDuration_ ?
+         DiagnosticStatus::OK : DiagnosticStatus::ERROR;
+}
+
+//-----------------------------------------------------------------------------
+bool RealtimeRateMonitor::isAlive(const Duration & stamp) const
+{
+  return hasStamp_.load(std::memory_order_acquire) &&
+         stamp - lastStamp_.load(std::memory_order_acquire) <= timeout_;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,205 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// local
+#include "romea_core_localisation_gps/SharedObservationPublisher.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+template<typename T>
+double toValue(const std::optional<T> & value)
+{
+  return value ? static_cast<double>(*value) : -1.;
+}
+
+//-----------------------------------------------------------------------------
+std::runtime_error makeError(const std::string & what, const std::string & name)
+{
+  return std::runtime_error(
+    "Shared observation publisher " + name + ": " + what + " (" + std::strerror(errno) + ").");
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+SharedObservationPublisher::SharedObservationPublisher(
+  const std::string & name,
+  const size_t & capacity)
+: name_(name),
+  device_(0),
+  inode_(0),
+  capacity_(capacity),
+  size_(sharedObservationRingSize(capacity)),
+  header_(nullptr),
+  slots_(nullptr)
+{
+  if (capacity_ == 0) {
+    throw std::invalid_argument("Shared observation ring capacity must be positive.");
+  }
+
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw makeError("cannot create shared memory object", name_);
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw makeError("cannot resize shared memory object", name_);
+  }
+  device_ = status.st_dev;
+  inode_ = status.st_ino;
+
+  void * address = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    shm_unlink(name_.c_str());
+    throw makeError("cannot map shared memory object", name_);
+  }
+
+  // readers opening the object before the magic number is written reject it
+  header_ = new (address) SharedObservationRingHeader;
+  header_->magic.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  header_->version = SharedObservationRingHeader::VERSION;
+  header_->capacity = capacity_;
+  header_->numberOfRecords.store(0, std::memory_order_relaxed);
+
+  slots_ = reinterpret_cast<SharedObservationSlot *>(header_ + 1);
+  for (size_t n = 0; n < capacity_; ++n) {
+    SharedObservationSlot * slot = new (slots_ + n) SharedObservationSlot;
+    slot->sequence.store(0, std::memory_order_relaxed);
+  }
+
+  header_->magic.store(SharedObservationRingHeader::MAGIC, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+SharedObservationPublisher::~SharedObservationPublisher()
+{
+  header_->magic.store(0, std::memory_order_release);
+  munmap(header_, size_);
+
+  // the name may have been unlinked and reused by another publisher
+  int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd >= 0) {
+    struct stat status;
+    bool isOwned = fstat(fd, &status) == 0 &&
+      status.st_dev == device_ && status.st_ino == inode_;
+    close(fd);
+    if (isOwned) {
+      shm_unlink(name_.c_str());
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void SharedObservationPublisher::publish(
+  const Duration & stamp,
+  const ObservationPosition & positionObs)
+{
+  write_<8>(
+    SharedObservationType::POSITION, stamp, {
+      positionObs.Y(ObservationPosition::POSITION_X),
+      positionObs.Y(ObservationPosition::POSITION_Y),
+      positionObs.R()(0, 0),
+      positionObs.R()(0, 1),
+      positionObs.R()(1, 1),
+      positionObs.levelArm.x(),
+      positionObs.levelArm.y(),
+      positionObs.levelArm.z()});
+}
+
+//-----------------------------------------------------------------------------
+void SharedObservationPublisher::publish(
+  const Duration & stamp,
+  const ObservationCourse & courseObs)
+{
+  write_<2>(SharedObservationType::COURSE, stamp, {courseObs.Y(), courseObs.R()});
+}
+
+//-----------------------------------------------------------------------------
+void SharedObservationPublisher::publish(const StatusTransition & transition)
+{
+  write_<5>(
+    SharedObservationType::STATUS, transition.stamp, {
+      static_cast<double>(transition.checkup),
+      toValue(transition.previousStatus),
+      toValue(transition.currentStatus),
+      toValue(transition.previousFixQuality),
+      toValue(transition.currentFixQuality)});
+}
+
+//-----------------------------------------------------------------------------
+template<size_t N>
+void SharedObservationPublisher::write_(
+  const SharedObservationType & type,
+  const Duration & stamp,
+  const std::array<double, N> & values)
+{
+  static_assert(N <= SharedObservationRecord::NUMBER_OF_VALUES, "too many record values");
+
+  uint64_t index = header_->numberOfRecords.fetch_add(1, std::memory_order_relaxed);
+  SharedObservationSlot & slot = slots_[index % capacity_];
+
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.type.store(static_cast<uint8_t>(type), std::memory_order_relaxed);
+  slot.stamp.store(stamp.count(), std::memory_order_relaxed);
+  for (size_t n = 0; n < SharedObservationRecord::NUMBER_OF_VALUES; ++n) {
+    slot.values[n].store(n < N ? values[n] : 0., std::memory_order_relaxed);
+  }
+
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+const std::string & SharedObservationPublisher::getName() const
+{
+  return name_;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t SharedObservationPublisher::getNumberOfRecords() const
+{
+  return header_->numberOfRecords.load(std::memory_order_relaxed);
+}
+
+}  // namespace core
+}  // namespace romea
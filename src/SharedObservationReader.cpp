@@ -0,0 +1,203 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// local
+#include "romea_core_localisation_gps/SharedObservationReader.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+template<typename T>
+std::optional<T> fromValue(const double & value)
+{
+  if (value < 0) {
+    return std::nullopt;
+  }
+  return static_cast<T>(static_cast<int>(value));
+}
+
+//-----------------------------------------------------------------------------
+std::runtime_error makeError(const std::string & what, const std::string & name)
+{
+  return std::runtime_error(
+    "Shared observation reader " + name + ": " + what + " (" + std::strerror(errno) + ").");
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+SharedObservationReader::SharedObservationReader(
+  const std::string & name,
+  const bool & fromOldestRecord)
+: size_(0),
+  header_(nullptr),
+  slots_(nullptr),
+  capacity_(0),
+  nextIndex_(0),
+  numberOfLostRecords_(0)
+{
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw makeError("cannot open shared memory object", name);
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 ||
+    static_cast<size_t>(status.st_size) < sizeof(SharedObservationRingHeader))
+  {
+    close(fd);
+    throw makeError("shared memory object is not a ring", name);
+  }
+
+  size_ = static_cast<size_t>(status.st_size);
+  void * address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    throw makeError("cannot map shared memory object", name);
+  }
+
+  header_ = static_cast<const SharedObservationRingHeader *>(address);
+  if (header_->magic.load(std::memory_order_acquire) != SharedObservationRingHeader::MAGIC ||
+    header_->version != SharedObservationRingHeader::VERSION ||
+    sharedObservationRingSize(header_->capacity) > size_)
+  {
+    munmap(address, size_);
+    throw std::runtime_error(
+            "Shared observation reader " + name + ": ring is not initialized or not supported.");
+  }
+
+  capacity_ = header_->capacity;
+  slots_ = reinterpret_cast<const SharedObservationSlot *>(header_ + 1);
+
+  uint64_t numberOfRecords = header_->numberOfRecords.load(std::memory_order_acquire);
+  nextIndex_ = numberOfRecords;
+  if (fromOldestRecord) {
+    nextIndex_ = numberOfRecords > capacity_ ? numberOfRecords - capacity_ : 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+SharedObservationReader::~SharedObservationReader()
+{
+  munmap(const_cast<SharedObservationRingHeader *>(header_), size_);
+}
+
+//-----------------------------------------------------------------------------
+bool SharedObservationReader::read(SharedObservationRecord & record)
+{
+  while (true) {
+    // the publisher has been destroyed or restarted
+    if (header_->magic.load(std::memory_order_acquire) != SharedObservationRingHeader::MAGIC) {
+      return false;
+    }
+
+    uint64_t numberOfRecords = header_->numberOfRecords.load(std::memory_order_acquire);
+    if (nextIndex_ >= numberOfRecords) {
+      return false;
+    }
+
+    if (numberOfRecords - nextIndex_ > capacity_) {
+      numberOfLostRecords_ += numberOfRecords - capacity_ - nextIndex_;
+      nextIndex_ = numberOfRecords - capacity_;
+    }
+
+    const SharedObservationSlot & slot = slots_[nextIndex_ % capacity_];
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence < 2 * nextIndex_ + 2) {
+      // claimed but not written yet
+      return false;
+    }
+
+    record.index = nextIndex_;
+    record.type = static_cast<SharedObservationType>(slot.type.load(std::memory_order_relaxed));
+    record.stamp = Duration(slot.stamp.load(std::memory_order_relaxed));
+    for (size_t n = 0; n < SharedObservationRecord::NUMBER_OF_VALUES; ++n) {
+      record.values[n] = slot.values[n].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (sequence == 2 * nextIndex_ + 2 &&
+      slot.sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      nextIndex_++;
+      return true;
+    }
+
+    // overwritten by a newer record while being copied
+    numberOfLostRecords_++;
+    nextIndex_++;
+  }
+}
+
+//-----------------------------------------------------------------------------
+uint64_t SharedObservationReader::getNumberOfLostRecords() const
+{
+  return numberOfLostRecords_;
+}
+
+//-----------------------------------------------------------------------------
+ObservationPosition toObservationPosition(const SharedObservationRecord & record)
+{
+  ObservationPosition positionObs;
+  positionObs.Y(ObservationPosition::POSITION_X) = record.values[0];
+  positionObs.Y(ObservationPosition::POSITION_Y) = record.values[1];
+  positionObs.R() << record.values[2], record.values[3], record.values[3], record.values[4];
+  positionObs.levelArm = Eigen::Vector3d(record.values[5], record.values[6], record.values[7]);
+  return positionObs;
+}
+
+//-----------------------------------------------------------------------------
+ObservationCourse toObservationCourse(const SharedObservationRecord & record)
+{
+  ObservationCourse courseObs;
+  courseObs.Y() = record.values[0];
+  courseObs.R() = record.values[1];
+  return courseObs;
+}
+
+//-----------------------------------------------------------------------------
+StatusTransition toStatusTransition(const SharedObservationRecord & record)
+{
+  StatusTransition transition;
+  transition.checkup = static_cast<GPSCheckup>(static_cast<int>(record.values[0]));
+  transition.stamp = record.stamp;
+  transition.previousStatus = fromValue<DiagnosticStatus>(record.values[1]);
+  transition.currentStatus = fromValue<DiagnosticStatus>(record.values[2]);
+  transition.previousFixQuality = fromValue<FixQuality>(record.values[3]);
+  transition.currentFixQuality = fromValue<FixQuality>(record.values[4]);
+  return transition;
+}
+
+}  // namespace core
+}  // namespace romea
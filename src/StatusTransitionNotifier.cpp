@@ -0,0 +1,145 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <thread>
+#include <utility>
+
+// local
+#include "romea_core_localisation_gps/StatusTransitionNotifier.hpp"
+
+namespace
+{
+const size_t PENDING_TRANSITIONS_CAPACITY = 16;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+const char * toString(const GPSCheckup & checkup)
+{
+  switch (checkup) {
+    case GPSCheckup::LINEAR_SPEED_RATE:
+      return "linear_speed_rate";
+    case GPSCheckup::GGA_RATE:
+      return "gga_rate";
+    case GPSCheckup::GGA_FIX:
+      return "gga_fix";
+    case GPSCheckup::RMC_RATE:
+      return "rmc_rate";
+    case GPSCheckup::RMC_TRACK_ANGLE:
+      return "rmc_track_angle";
+    case GPSCheckup::HDT_RATE:
+      return "hdt_rate";
+    case GPSCheckup::HDT_TRACK_ANGLE:
+      return "hdt_track_angle";
+    case GPSCheckup::GEOFENCE:
+      return "geofence";
+    default:
+      return "unknown";
+  }
+}
+
+//-----------------------------------------------------------------------------
+StatusTransitionNotifier::StatusTransitionNotifier()
+: pendingMutex_("status_transition_pending"),
+  states_(),
+  pendingTransitions_(),
+  hasPendingTransitions_(false),
+  dispatchMutex_("status_transition_dispatch"),
+  dispatchedTransitions_(),
+  callbacks_(),
+  hasCallbacks_(false),
+  dispatchingThread_()
+{
+  pendingTransitions_.reserve(PENDING_TRANSITIONS_CAPACITY);
+  dispatchedTransitions_.reserve(PENDING_TRANSITIONS_CAPACITY);
+}
+
+//-----------------------------------------------------------------------------
+void StatusTransitionNotifier::registerCallback(const Callback & callback)
+{
+  // must not be called from a callback
+  std::lock_guard<ProfiledMutex> lock(dispatchMutex_);
+  callbacks_.push_back(callback);
+  hasCallbacks_ = true;
+}
+
+//-----------------------------------------------------------------------------
+void StatusTransitionNotifier::update(
+  const GPSCheckup & checkup,
+  const Duration & stamp,
+  const std::optional<DiagnosticStatus> & status,
+  const std::optional<FixQuality> & fixQuality)
+{
+  std::lock_guard<ProfiledMutex> lock(pendingMutex_);
+  CheckupState & state = states_[static_cast<size_t>(checkup)];
+  if (state.status == status && state.fixQuality == fixQuality) {
+    return;
+  }
+
+  if (hasCallbacks_) {
+    pendingTransitions_.push_back(
+      {checkup, stamp, state.status, status, state.fixQuality, fixQuality});
+    hasPendingTransitions_ = true;
+  }
+
+  state.status = status;
+  state.fixQuality = fixQuality;
+}
+
+//-----------------------------------------------------------------------------
+void StatusTransitionNotifier::dispatch()
+{
+  // transitions queued by a callback are dispatched by the enclosing call
+  if (dispatchingThread_.load() == std::this_thread::get_id()) {
+    return;
+  }
+
+  while (hasPendingTransitions_) {
+    // another thread is dispatching, it will also dispatch our transitions
+    std::unique_lock<ProfiledMutex> dispatchLock(dispatchMutex_, std::try_to_lock);
+    if (!dispatchLock.owns_lock()) {
+      return;
+    }
+
+    dispatchingThread_ = std::this_thread::get_id();
+    while (true) {
+      {
+        std::lock_guard<ProfiledMutex> pendingLock(pendingMutex_);
+        std::swap(pendingTransitions_, dispatchedTransitions_);
+        hasPendingTransitions_ = false;
+      }
+
+      if (dispatchedTransitions_.empty()) {
+        break;
+      }
+
+      for (const auto & transition : dispatchedTransitions_) {
+        for (const auto & callback : callbacks_) {
+          callback(transition);
+        }
+      }
+      dispatchedTransitions_.clear();
+    }
+    dispatchingThread_ = std::thread::id();
+  }
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,115 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <limits>
+#include <vector>
+
+// local
+#include "romea_core_localisation_gps/StreamRateDiagnostic.hpp"
+
+namespace
+{
+const double RATE_EPSILON = 0.1;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+StreamRateDiagnostic::StreamRateDiagnostic(
+  const GPSCheckup & checkup,
+  const std::string & streamName,
+  const double & rate)
+: checkup_(checkup),
+  rateDiagnostic_(streamName, rate, RATE_EPSILON),
+  history_(streamName + "_rate", {"rate"}),
+  previousStamp_(),
+  hasPreviousStamp_(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus StreamRateDiagnostic::evaluate(
+  const Duration & stamp,
+  StatusTransitionNotifier & notifier)
+{
+  DiagnosticStatus status = rateDiagnostic_.evaluate(stamp);
+
+  double rate = std::numeric_limits<double>::quiet_NaN();
+  if (hasPreviousStamp_ && stamp > previousStamp_) {
+    rate = 1. / durationToSecond(stamp - previousStamp_);
+  }
+  previousStamp_ = stamp;
+  hasPreviousStamp_ = true;
+
+  history_.record(stamp, status, rate);
+  notifier.update(checkup_, stamp, status);
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+bool StreamRateDiagnostic::checkHeartBeat(
+  const Duration & stamp,
+  StatusTransitionNotifier & notifier)
+{
+  if (!rateDiagnostic_.heartBeatCallback(stamp)) {
+    notifier.update(checkup_, stamp, DiagnosticStatus::ERROR);
+    return false;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport StreamRateDiagnostic::getReport() const
+{
+  return rateDiagnostic_.getReport();
+}
+
+//-----------------------------------------------------------------------------
+const DiagnosticHistory & StreamRateDiagnostic::getHistory() const
+{
+  return history_;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<Duration> StreamRateDiagnostic::getLastStamps(const size_t & count) const
+{
+  std::vector<DiagnosticRecord> records = history_.getRecords();
+  size_t first = records.size() > count ? records.size() - count : 0;
+
+  std::vector<Duration> stamps;
+  stamps.reserve(records.size() - first);
+  for (size_t n = first; n < records.size(); ++n) {
+    stamps.push_back(records[n].stamp);
+  }
+  return stamps;
+}
+
+//-----------------------------------------------------------------------------
+void StreamRateDiagnostic::replay(
+  const std::vector<Duration> & stamps,
+  const Duration & shift,
+  StatusTransitionNotifier & notifier)
+{
+  for (const auto & stamp : stamps) {
+    evaluate(stamp + shift, notifier);
+  }
+}
+
+}  // namespace core
+}  // namespace romea
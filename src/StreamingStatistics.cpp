@@ -0,0 +1,121 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_gps/StreamingStatistics.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+RunningStatistics::RunningStatistics()
+: count_(0),
+  mean_(0),
+  sumOfSquaredDeviations_(0),
+  minimum_(std::numeric_limits<double>::quiet_NaN()),
+  maximum_(std::numeric_limits<double>::quiet_NaN())
+{
+}
+
+//-----------------------------------------------------------------------------
+void RunningStatistics::update(const double & value)
+{
+  ++count_;
+  double deviation = value - mean_;
+  mean_ += deviation / count_;
+  sumOfSquaredDeviations_ += deviation * (value - mean_);
+
+  if (count_ == 1) {
+    minimum_ = maximum_ = value;
+  } else {
+    minimum_ = std::min(minimum_, value);
+    maximum_ = std::max(maximum_, value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+uint64_t RunningStatistics::getCount() const
+{
+  return count_;
+}
+
+//-----------------------------------------------------------------------------
+double RunningStatistics::getMean() const
+{
+  return count_ != 0 ? mean_ : std::numeric_limits<double>::quiet_NaN();
+}
+
+//-----------------------------------------------------------------------------
+double RunningStatistics::getVariance() const
+{
+  return count_ > 1 ?
+         sumOfSquaredDeviations_ / (count_ - 1) :
+         std::numeric_limits<double>::quiet_NaN();
+}
+
+//-----------------------------------------------------------------------------
+double RunningStatistics::getStandardDeviation() const
+{
+  return std::sqrt(getVariance());
+}
+
+//-----------------------------------------------------------------------------
+double RunningStatistics::getMinimum() const
+{
+  return minimum_;
+}
+
+//-----------------------------------------------------------------------------
+double RunningStatistics::getMaximum() const
+{
+  return maximum_;
+}
+
+//-----------------------------------------------------------------------------
+ExponentialMovingAverage::ExponentialMovingAverage(const Duration & timeConstant)
+: timeConstant_(durationToSecond(timeConstant)),
+  lastStamp_(),
+  value_(std::numeric_limits<double>::quiet_NaN())
+{
+}
+
+//-----------------------------------------------------------------------------
+void ExponentialMovingAverage::update(const Duration & stamp, const double & value)
+{
+  if (!lastStamp_) {
+    value_ = value;
+    lastStamp_ = stamp;
+  } else if (stamp > *lastStamp_) {
+    double alpha = 1 - std::exp(-durationToSecond(stamp - *lastStamp_) / timeConstant_);
+    value_ += alpha * (value - value_);
+    lastStamp_ = stamp;
+  }
+}
+
+//-----------------------------------------------------------------------------
+double ExponentialMovingAverage::getValue() const
+{
+  return value_;
+}
+
+}  // namespace core
+}  // namespace romea
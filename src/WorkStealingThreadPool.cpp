@@ -0,0 +1,186 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <utility>
+
+// local
+#include "romea_core_localisation_gps/WorkStealingThreadPool.hpp"
+
+namespace
+{
+
+// identifies the pool and the worker running on the current thread
+thread_local const void * currentPool = nullptr;
+thread_local size_t currentWorkerIndex = 0;
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+WorkStealingThreadPool::WorkStealingThreadPool(const size_t & numberOfThreads)
+: workers_(),
+  nextWorker_(0),
+  sleepMutex_(),
+  sleepCondition_(),
+  queuedTasks_(0),
+  sleepingWorkers_(0),
+  stop_(false),
+  executedTasks_(0),
+  stolenTasks_(0)
+{
+  size_t n = std::max<size_t>(numberOfThreads, 1);
+  for (size_t i = 0; i < n; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < n; ++i) {
+    workers_[i]->thread = std::thread(&WorkStealingThreadPool::run_, this, i);
+  }
+}
+
+//-----------------------------------------------------------------------------
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    stop_ = true;
+  }
+  sleepCondition_.notify_all();
+
+  for (auto & worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void WorkStealingThreadPool::submit(Task task)
+{
+  push_(std::move(task), false);
+}
+
+//-----------------------------------------------------------------------------
+void WorkStealingThreadPool::yield(Task task)
+{
+  push_(std::move(task), true);
+}
+
+//-----------------------------------------------------------------------------
+void WorkStealingThreadPool::push_(Task && task, const bool & toFront)
+{
+  size_t workerIndex = currentPool == this ?
+    currentWorkerIndex :
+    nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+  // counted before being pushed so that a worker popping or stealing it
+  // cannot decrement the count below zero
+  queuedTasks_.fetch_add(1);
+  {
+    Worker & worker = *workers_[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (toFront) {
+      worker.tasks.push_front(std::move(task));
+    } else {
+      worker.tasks.push_back(std::move(task));
+    }
+  }
+
+  // a worker going to sleep is counted before it checks queued tasks so
+  // either it sees this task or it is seen here, locking the mutex then
+  // ensures that it waits before being notified
+  if (sleepingWorkers_.load() != 0) {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCondition_.notify_one();
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t WorkStealingThreadPool::getNumberOfThreads() const
+{
+  return workers_.size();
+}
+
+//-----------------------------------------------------------------------------
+WorkStealingThreadPoolMetrics WorkStealingThreadPool::getMetrics() const
+{
+  return {workers_.size(),
+    queuedTasks_.load(std::memory_order_relaxed),
+    executedTasks_.load(std::memory_order_relaxed),
+    stolenTasks_.load(std::memory_order_relaxed)};
+}
+
+//-----------------------------------------------------------------------------
+void WorkStealingThreadPool::run_(const size_t & workerIndex)
+{
+  currentPool = this;
+  currentWorkerIndex = workerIndex;
+
+  Task task;
+  while (true) {
+    if (pop_(workerIndex, task) || steal_(workerIndex, task)) {
+      queuedTasks_.fetch_sub(1);
+      task();
+      task = nullptr;
+      executedTasks_.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleepingWorkers_.fetch_add(1);
+    sleepCondition_.wait(lock, [this] {return stop_ || queuedTasks_.load() != 0;});
+    sleepingWorkers_.fetch_sub(1);
+    if (stop_ && queuedTasks_.load() == 0) {
+      return;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool WorkStealingThreadPool::pop_(const size_t & workerIndex, Task & task)
+{
+  Worker & worker = *workers_[workerIndex];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty()) {
+    return false;
+  }
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool WorkStealingThreadPool::steal_(const size_t & workerIndex, Task & task)
+{
+  for (size_t n = 1; n < workers_.size(); ++n) {
+    Worker & victim = *workers_[(workerIndex + n) % workers_.size()];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (lock.owns_lock() && !victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      stolenTasks_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace core
+}  // namespace romea
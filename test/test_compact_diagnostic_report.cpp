@@ -0,0 +1,71 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <optional>
+
+// romea
+#include "romea_core_gps/nmea/GGAFrame.hpp"
+#include "romea_core_localisation_gps/CompactDiagnosticReport.hpp"
+
+using Report = romea::core::CompactDiagnosticReport<3, 2>;
+
+//-----------------------------------------------------------------------------
+TEST(TestCompactDiagnosticReport, checkInfosAreEmptyAtConstruction)
+{
+  Report report;
+  EXPECT_FALSE(report.getInfo<double>(0));
+  EXPECT_FALSE(report.getInfo<int>(1));
+  EXPECT_FALSE(report.hasDiagnostics());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCompactDiagnosticReport, checkInfosRoundTrip)
+{
+  Report report;
+  report.setInfo(0, std::optional<double>(1.25));
+  report.setInfo(1, 12);
+  report.setInfo(2, romea::core::FixQuality::RTK_FIX);
+
+  EXPECT_DOUBLE_EQ(*report.getInfo<std::optional<double>>(0), 1.25);
+  EXPECT_EQ(*report.getInfo<int>(1), 12);
+  EXPECT_EQ(*report.getInfo<romea::core::FixQuality>(2), romea::core::FixQuality::RTK_FIX);
+
+  report.setInfo(0, std::optional<double>());
+  EXPECT_FALSE(report.getInfo<double>(0));
+
+  report.clearInfos();
+  EXPECT_FALSE(report.getInfo<int>(1));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCompactDiagnosticReport, checkDiagnosticsAreBounded)
+{
+  Report report;
+  report.addDiagnostic(romea::core::DiagnosticStatus::OK, 0);
+  report.addDiagnostic(romea::core::DiagnosticStatus::ERROR, 1);
+  report.addDiagnostic(romea::core::DiagnosticStatus::WARN, 2);
+
+  EXPECT_EQ(report.endDiagnostics() - report.beginDiagnostics(), 2);
+  EXPECT_EQ(report.worseStatus(), romea::core::DiagnosticStatus::ERROR);
+
+  report.setDiagnostic(romea::core::DiagnosticStatus::WARN, 2);
+  EXPECT_EQ(report.endDiagnostics() - report.beginDiagnostics(), 1);
+  EXPECT_EQ(report.beginDiagnostics()->message, 2);
+  EXPECT_EQ(report.worseStatus(), romea::core::DiagnosticStatus::WARN);
+}
@@ -0,0 +1,93 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+
+using GGAOnlyGPSPlugin = romea::core::LocalisationGPSPlugin<>;
+
+//-----------------------------------------------------------------------------
+TEST(TestComposedGPSPlugin, checkStreamsComposition)
+{
+  EXPECT_TRUE(romea::core::LocalisationSingleAntennaGPSPlugin::hasStream<
+      romea::core::RMCCourseStream>);
+  EXPECT_FALSE(romea::core::LocalisationSingleAntennaGPSPlugin::hasStream<
+      romea::core::HDTCourseStream>);
+  EXPECT_TRUE(romea::core::LocalisationDualAntennaGPSPlugin::hasStream<
+      romea::core::HDTCourseStream>);
+  EXPECT_FALSE(GGAOnlyGPSPlugin::hasStream<romea::core::RMCCourseStream>);
+  EXPECT_FALSE(GGAOnlyGPSPlugin::hasStream<romea::core::HDTCourseStream>);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestComposedGPSPlugin, checkGGAOnlyPluginCarriesNoCourseState)
+{
+  EXPECT_LT(sizeof(GGAOnlyGPSPlugin), sizeof(romea::core::LocalisationSingleAntennaGPSPlugin));
+  EXPECT_LT(sizeof(GGAOnlyGPSPlugin), sizeof(romea::core::LocalisationDualAntennaGPSPlugin));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestComposedGPSPlugin, checkGGAOnlyPluginDiagnostics)
+{
+  GGAOnlyGPSPlugin plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::ObservationPosition position;
+  for (size_t n = 0; n < 4; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(0.5 + n / 10.);
+    EXPECT_FALSE(plugin.processGGA(stamp, ggaSentence, position));
+  }
+
+  romea::core::Duration stamp = romea::core::durationFromSecond(0.9);
+  EXPECT_TRUE(plugin.processGGA(stamp, ggaSentence, position));
+
+  auto report = plugin.makeDiagnosticReport(stamp);
+  ASSERT_EQ(report.diagnostics.size(), 2u);
+  EXPECT_EQ(report.diagnostics.front().status, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(report.diagnostics.back().status, romea::core::DiagnosticStatus::OK);
+
+  std::ostringstream os;
+  plugin.dumpDiagnosticHistory(os);
+  EXPECT_NE(os.str().find("# gga_rate\n"), std::string::npos);
+  EXPECT_NE(os.str().find("# gga_fix\n"), std::string::npos);
+  EXPECT_EQ(os.str().find("_track_angle"), std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestComposedGPSPlugin, checkGGAOnlyPluginLosesFixWithoutGGA)
+{
+  GGAOnlyGPSPlugin plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::ObservationPosition position;
+  for (size_t n = 0; n < 5; ++n) {
+    plugin.processGGA(romea::core::durationFromSecond(n), ggaSentence, position);
+  }
+
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(10));
+  EXPECT_EQ(report.diagnostics.front().status, romea::core::DiagnosticStatus::ERROR);
+}
@@ -0,0 +1,113 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <limits>
+#include <random>
+
+// romea
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+
+//-----------------------------------------------------------------------------
+double monteCarloCourseAngleStd(const double & distance, const double & positionStd)
+{
+  std::mt19937 generator(42);
+  std::normal_distribution<double> noise(0, positionStd);
+
+  const size_t numberOfSamples = 100000;
+  double sum = 0;
+  double squaredSum = 0;
+  for (size_t n = 0; n < numberOfSamples; ++n) {
+    double dx = distance + noise(generator) - noise(generator);
+    double dy = noise(generator) - noise(generator);
+    double angle = std::atan2(dy, dx);
+    sum += angle;
+    squaredSum += angle * angle;
+  }
+
+  double mean = sum / numberOfSamples;
+  return std::sqrt(squaredSum / numberOfSamples - mean * mean);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCourseAngleCovariance, rmcCourseAngleStdMatchesMonteCarlo)
+{
+  EXPECT_NEAR(
+    romea::core::rmcCourseAngleStd(1.0, 0.02, 1.0),
+    monteCarloCourseAngleStd(1.0, 0.02), 0.002);
+  EXPECT_NEAR(
+    romea::core::rmcCourseAngleStd(3.0, 0.3, 1.0),
+    monteCarloCourseAngleStd(3.0, 0.3), 0.01);
+  EXPECT_NEAR(
+    romea::core::rmcCourseAngleStd(-3.0, 0.3, 1.0),
+    monteCarloCourseAngleStd(3.0, 0.3), 0.01);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCourseAngleCovariance, hdtCourseAngleStdMatchesMonteCarlo)
+{
+  EXPECT_NEAR(
+    romea::core::hdtCourseAngleStd(1.0, 0.02),
+    monteCarloCourseAngleStd(1.0, 0.02), 0.002);
+  EXPECT_NEAR(
+    romea::core::hdtCourseAngleStd(2.5, 0.05),
+    monteCarloCourseAngleStd(2.5, 0.05), 0.002);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCourseAngleCovariance, rmcCourseAngleStdDecreasesWithSpeed)
+{
+  double previousStd = romea::core::rmcCourseAngleStd(0., 0.02, 1.0);
+  for (double speed = 0.1; speed < 10; speed += 0.1) {
+    double currentStd = romea::core::rmcCourseAngleStd(speed, 0.02, 1.0);
+    EXPECT_LE(currentStd, previousStd);
+    previousStd = currentStd;
+  }
+  EXPECT_DOUBLE_EQ(romea::core::rmcCourseAngleStd(0., 0.02, 1.0), M_PI_2);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCourseAngleCovariance, courseAngleStdIsBounded)
+{
+  EXPECT_GT(romea::core::rmcCourseAngleStd(100., 0., 1.0), 0.);
+  EXPECT_GT(romea::core::hdtCourseAngleStd(100., 0.), 0.);
+  EXPECT_LE(romea::core::hdtCourseAngleStd(0.01, 10.), M_PI_2);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestCourseAngleCovariance, fallbackToDefaultCourseAngleStd)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_DOUBLE_EQ(
+    romea::core::rmcCourseAngleStd(3.0, nan, 1.0),
+    romea::core::defaultCourseAngleStd());
+  EXPECT_DOUBLE_EQ(
+    romea::core::hdtCourseAngleStd(nan, 0.02),
+    romea::core::defaultCourseAngleStd());
+  EXPECT_DOUBLE_EQ(
+    romea::core::hdtCourseAngleStd(0., 0.02),
+    romea::core::defaultCourseAngleStd());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
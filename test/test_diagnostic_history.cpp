@@ -0,0 +1,157 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/DiagnosticHistory.hpp"
+#include "romea_core_localisation_gps/CheckupGGAFix.hpp"
+
+std::atomic<size_t> numberOfAllocations(0);
+
+void * operator new(std::size_t size)
+{
+  numberOfAllocations++;
+  if (void * ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticHistory, checkEmptyHistory)
+{
+  romea::core::DiagnosticHistory history("gga_rate", {}, 4);
+  EXPECT_EQ(history.capacity(), 4);
+  EXPECT_TRUE(history.getRecords().empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticHistory, keepLastRecordsInOrder)
+{
+  romea::core::DiagnosticHistory history("gga_rate", {}, 4);
+  for (int n = 0; n < 10; ++n) {
+    history.record(romea::core::Duration(n), romea::core::DiagnosticStatus::OK, n);
+  }
+
+  auto records = history.getRecords();
+  ASSERT_EQ(records.size(), 4);
+  for (int n = 0; n < 4; ++n) {
+    EXPECT_EQ(records[n].stamp.count(), 6 + n);
+    EXPECT_EQ(records[n].values[0], 6 + n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticHistory, recordDoesNotAllocate)
+{
+  romea::core::DiagnosticHistory history("gga_fix", {"fix_quality", "hdop", ""}, 8);
+  size_t numberOfAllocationsBefore = numberOfAllocations;
+  for (int n = 0; n < 100; ++n) {
+    history.record(romea::core::Duration(n), romea::core::DiagnosticStatus::WARN, 4, 1.2);
+  }
+  EXPECT_EQ(numberOfAllocations, numberOfAllocationsBefore);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticHistory, dump)
+{
+  romea::core::DiagnosticHistory history("gga_fix", {"fix_quality", "hdop", ""}, 8);
+  history.record(romea::core::durationFromSecond(1.5), romea::core::DiagnosticStatus::OK, 4, 1.2);
+  history.record(romea::core::durationFromSecond(2.5), romea::core::DiagnosticStatus::WARN, 5, 6);
+
+  std::ostringstream os;
+  history.dump(os);
+  EXPECT_STREQ(
+    os.str().c_str(),
+    "# gga_fix\n"
+    "stamp,status,fix_quality,hdop\n"
+    "1.500000000,OK,4,1.2\n"
+    "2.500000000,WARN,5,6\n");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticHistory, concurrentReadsNeverReturnTornRecords)
+{
+  romea::core::DiagnosticHistory history("gga_fix", {"a", "b", "c"}, 16);
+  std::atomic<bool> stop(false);
+
+  std::thread writer([&]() {
+      for (int64_t n = 0; n < 200000; ++n) {
+        double value = static_cast<double>(n);
+        history.record(romea::core::Duration(n), romea::core::DiagnosticStatus::OK, value, value, value);
+      }
+      stop = true;
+    });
+
+  while (!stop) {
+    for (const auto & record : history.getRecords()) {
+      double value = static_cast<double>(record.stamp.count());
+      EXPECT_EQ(record.values[0], value);
+      EXPECT_EQ(record.values[1], value);
+      EXPECT_EQ(record.values[2], value);
+    }
+  }
+  writer.join();
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticHistory, checkupKeepsHistoryAfterReset)
+{
+  romea::core::CheckupGGAFix diagnostic(romea::core::FixQuality::RTK_FIX);
+  romea::core::GGAFrame frame = minimalGoodGGAFrame();
+
+  diagnostic.evaluate(frame, romea::core::durationFromSecond(1.));
+  frame.numberSatellitesUsedToComputeFix = 5;
+  diagnostic.evaluate(frame, romea::core::durationFromSecond(2.));
+  diagnostic.reset();
+
+  auto records = diagnostic.getHistory().getRecords();
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].status, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(records[0].values[0], static_cast<int>(romea::core::FixQuality::RTK_FIX));
+  EXPECT_EQ(records[0].values[1], 1.2);
+  EXPECT_EQ(records[0].values[2], 12);
+  EXPECT_EQ(records[1].stamp, romea::core::durationFromSecond(2.));
+  EXPECT_EQ(records[1].status, romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(records[1].values[2], 5);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
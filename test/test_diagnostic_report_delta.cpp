@@ -0,0 +1,252 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/DiagnosticReportDelta.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+
+//-----------------------------------------------------------------------------
+romea::core::DiagnosticReport makeReport(const std::string & hdop)
+{
+  romea::core::DiagnosticReport report;
+  report.info["talker"] = "GNSS";
+  report.info["hdop"] = hdop;
+  report.diagnostics.push_back({romea::core::DiagnosticStatus::OK, "gga rate OK."});
+  report.diagnostics.push_back({romea::core::DiagnosticStatus::OK, "GGA fix OK."});
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+void expectEqual(
+  const romea::core::DiagnosticReport & report1,
+  const romea::core::DiagnosticReport & report2)
+{
+  EXPECT_EQ(report1.info, report2.info);
+  ASSERT_EQ(report1.diagnostics.size(), report2.diagnostics.size());
+  auto it2 = report2.diagnostics.begin();
+  for (const auto & diagnostic : report1.diagnostics) {
+    EXPECT_EQ(diagnostic.status, it2->status);
+    EXPECT_EQ(diagnostic.message, it2->message);
+    ++it2;
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, encodeDecode)
+{
+  romea::core::DiagnosticReportDelta delta;
+  delta.journalId = 0x0123456789ABCDEF;
+  delta.baseSequence = 3;
+  delta.sequence = 300;
+  delta.changedInfos["hdop"] = "1.2";
+  delta.removedInfos.push_back("talker");
+  delta.diagnostics.emplace();
+  delta.diagnostics->push_back({romea::core::DiagnosticStatus::WARN, "HDOP is two high."});
+
+  auto decoded = romea::core::decodeDiagnosticReportDelta(romea::core::encode(delta));
+  EXPECT_EQ(decoded.journalId, 0x0123456789ABCDEF);
+  EXPECT_EQ(decoded.baseSequence, 3);
+  EXPECT_EQ(decoded.sequence, 300);
+  EXPECT_EQ(decoded.changedInfos, delta.changedInfos);
+  EXPECT_EQ(decoded.removedInfos, delta.removedInfos);
+  ASSERT_TRUE(decoded.diagnostics);
+  EXPECT_EQ(decoded.diagnostics->front().status, romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(decoded.diagnostics->front().message, "HDOP is two high.");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, decodeMalformedBuffer)
+{
+  romea::core::DiagnosticReportDelta delta;
+  delta.journalId = 1;
+  delta.baseSequence = 0;
+  delta.sequence = 1;
+  delta.changedInfos["hdop"] = "1.2";
+  auto buffer = romea::core::encode(delta);
+
+  for (size_t size = 0; size < buffer.size(); ++size) {
+    std::vector<uint8_t> truncated(buffer.begin(), buffer.begin() + size);
+    EXPECT_THROW(romea::core::decodeDiagnosticReportDelta(truncated), std::runtime_error);
+  }
+
+  buffer.push_back(0);
+  EXPECT_THROW(romea::core::decodeDiagnosticReportDelta(buffer), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, onlyChangesAreSent)
+{
+  romea::core::DiagnosticReportJournal journal;
+  uint64_t sequence1 = journal.update(makeReport("1.2"));
+  EXPECT_EQ(journal.update(makeReport("1.2")), sequence1);
+
+  uint64_t sequence2 = journal.update(makeReport("1.5"));
+  EXPECT_GT(sequence2, sequence1);
+
+  auto delta = journal.makeDelta(sequence1);
+  EXPECT_EQ(delta.baseSequence, sequence1);
+  EXPECT_EQ(delta.sequence, sequence2);
+  ASSERT_EQ(delta.changedInfos.size(), 1);
+  EXPECT_EQ(delta.changedInfos.at("hdop"), "1.5");
+  EXPECT_TRUE(delta.removedInfos.empty());
+  EXPECT_FALSE(delta.diagnostics);
+
+  delta = journal.makeDelta(sequence2);
+  EXPECT_TRUE(delta.changedInfos.empty());
+  EXPECT_FALSE(delta.diagnostics);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, decoderRebuildsFullReport)
+{
+  romea::core::DiagnosticReportJournal journal;
+  romea::core::DiagnosticReportDecoder decoder;
+
+  auto report = makeReport("1.2");
+  journal.update(report);
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal.makeDelta(decoder.getSequence()))));
+  expectEqual(decoder.getReport(), report);
+
+  report = makeReport("2.3");
+  report.info.erase("talker");
+  report.diagnostics.back() = {romea::core::DiagnosticStatus::WARN, "HDOP is two high."};
+  journal.update(report);
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal.makeDelta(decoder.getSequence()))));
+  expectEqual(decoder.getReport(), report);
+  EXPECT_EQ(decoder.getSequence(), journal.getSequence());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, decoderRejectsMissingChanges)
+{
+  romea::core::DiagnosticReportJournal journal;
+  romea::core::DiagnosticReportDecoder decoder;
+
+  uint64_t sequence1 = journal.update(makeReport("1.2"));
+  journal.update(makeReport("1.5"));
+  journal.update(makeReport("1.8"));
+
+  EXPECT_FALSE(decoder.apply(journal.makeDelta(sequence1)));
+  EXPECT_TRUE(decoder.apply(journal.makeDelta(0)));
+  expectEqual(decoder.getReport(), makeReport("1.8"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, decoderFollowsRestartedSender)
+{
+  auto journal = std::make_unique<romea::core::DiagnosticReportJournal>();
+  romea::core::DiagnosticReportDecoder decoder;
+
+  journal->update(makeReport("1.2"));
+  journal->update(makeReport("1.5"));
+  uint64_t sequence = journal->update(makeReport("1.8"));
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal->makeDelta(decoder.getSequence()))));
+  EXPECT_EQ(decoder.getSequence(), sequence);
+
+  // a restarted sender answers a request from ahead of its journal with a
+  // full report
+  journal = std::make_unique<romea::core::DiagnosticReportJournal>();
+  journal->update(makeReport("2.1"));
+  auto delta = journal->makeDelta(decoder.getSequence());
+  EXPECT_TRUE(romea::core::isFull(delta));
+  EXPECT_TRUE(decoder.apply(romea::core::encode(delta)));
+  expectEqual(decoder.getReport(), makeReport("2.1"));
+  EXPECT_EQ(decoder.getSequence(), journal->getSequence());
+
+  journal->update(makeReport("2.4"));
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal->makeDelta(decoder.getSequence()))));
+  expectEqual(decoder.getReport(), makeReport("2.4"));
+
+  // a delta of a restarted sender which goes backward resets the decoder
+  journal = std::make_unique<romea::core::DiagnosticReportJournal>();
+  journal->update(makeReport("3.0"));
+  EXPECT_FALSE(decoder.apply(romea::core::encode(journal->makeDelta(1))));
+  EXPECT_EQ(decoder.getSequence(), 0u);
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal->makeDelta(decoder.getSequence()))));
+  expectEqual(decoder.getReport(), makeReport("3.0"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, decoderDetectsRestartedSenderAheadOfIt)
+{
+  auto journal = std::make_unique<romea::core::DiagnosticReportJournal>();
+  romea::core::DiagnosticReportDecoder decoder;
+
+  auto report = makeReport("1.2");
+  report.info["sender"] = "first";
+  journal->update(report);
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal->makeDelta(decoder.getSequence()))));
+
+  // the restarted sender has passed the sequence of the receiver, its delta
+  // would be applied on top of the infos of its former instance
+  uint64_t formerId = journal->getId();
+  journal = std::make_unique<romea::core::DiagnosticReportJournal>();
+  EXPECT_NE(journal->getId(), formerId);
+  journal->update(makeReport("1.5"));
+  journal->update(makeReport("1.8"));
+  journal->update(makeReport("2.1"));
+  ASSERT_GT(journal->getSequence(), decoder.getSequence());
+
+  auto delta = journal->makeDelta(decoder.getSequence());
+  EXPECT_FALSE(romea::core::isFull(delta));
+  EXPECT_FALSE(decoder.apply(romea::core::encode(delta)));
+  EXPECT_EQ(decoder.getSequence(), 0u);
+
+  EXPECT_TRUE(decoder.apply(romea::core::encode(journal->makeDelta(decoder.getSequence()))));
+  expectEqual(decoder.getReport(), makeReport("2.1"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportDelta, pluginReportDelta)
+{
+  auto gps = std::make_unique<romea::core::GPSReceiver>();
+  romea::core::LocalisationDualAntennaGPSPlugin plugin(
+    std::move(gps), romea::core::FixQuality::RTK_FIX);
+
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::ObservationPosition position;
+  romea::core::DiagnosticReportDecoder decoder;
+
+  auto stamp = romea::core::durationFromSecond(0.5);
+  plugin.processGGA(stamp, ggaSentence, position);
+  auto fullBuffer = romea::core::encode(plugin.makeDiagnosticReportDelta(stamp, 0));
+  EXPECT_TRUE(decoder.apply(fullBuffer));
+  expectEqual(decoder.getReport(), plugin.makeDiagnosticReport(stamp));
+
+  plugin.processGGA(stamp, ggaSentence, position);
+  auto deltaBuffer = romea::core::encode(
+    plugin.makeDiagnosticReportDelta(stamp, decoder.getSequence()));
+  EXPECT_TRUE(decoder.apply(deltaBuffer));
+  expectEqual(decoder.getReport(), plugin.makeDiagnosticReport(stamp));
+  EXPECT_LT(deltaBuffer.size(), fullBuffer.size());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
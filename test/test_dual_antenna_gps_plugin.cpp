@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 // std
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -25,6 +26,7 @@
 // romea
 #include "helper.hpp"
 #include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
 
 bool boolean(const romea::core::DiagnosticStatus & status)
 {
@@ -130,6 +132,86 @@ TEST_F(TestDualAntennaGPSPlugin, testFixErrorTrackAngleOK)
   check(romea::core::DiagnosticStatus::ERROR, romea::core::DiagnosticStatus::OK);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestDualAntennaGPSPlugin, testCourseAngleCovarianceWithoutBaseline)
+{
+  check(romea::core::DiagnosticStatus::OK, romea::core::DiagnosticStatus::OK);
+  EXPECT_DOUBLE_EQ(
+    course.R(), std::pow(romea::core::defaultCourseAngleStd(), 2.0));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDualAntennaGPSPlugin, testCourseAngleCovarianceFromBaseline)
+{
+  auto gps = std::make_unique<romea::core::GPSReceiver>();
+  double uere = gps->getUERE(romea::core::FixQuality::RTK_FIX);
+  gps_plugin = std::make_unique<romea::core::LocalisationDualAntennaGPSPlugin>(
+    std::move(gps), romea::core::FixQuality::RTK_FIX, 1.5);
+
+  check(romea::core::DiagnosticStatus::OK, romea::core::DiagnosticStatus::OK);
+  EXPECT_DOUBLE_EQ(
+    course.R(), std::pow(romea::core::hdtCourseAngleStd(1.5, uere), 2.0));
+  EXPECT_LT(course.R(), std::pow(romea::core::defaultCourseAngleStd(), 2.0));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDualAntennaGPSPlugin, testNoCoursePredictionWithoutHDT)
+{
+  romea::core::Duration stamp = romea::core::durationFromSecond(0.5);
+  EXPECT_FALSE(gps_plugin->processYawRate(stamp, 0.1, course));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDualAntennaGPSPlugin, testCoursePredictionFromYawRate)
+{
+  check(romea::core::DiagnosticStatus::OK, romea::core::DiagnosticStatus::OK);
+  romea::core::ObservationCourse hdtCourse = course;
+
+  // yaw rates older than the last HDT course are ignored
+  EXPECT_FALSE(gps_plugin->processYawRate(romea::core::durationFromSecond(0.48), 0.5, course));
+
+  double driftStd = romea::core::HDTCourseStream::YAW_RATE_BIAS_STD;
+  for (size_t n = 1; n <= 10; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(0.5 + n * 0.02);
+    EXPECT_TRUE(gps_plugin->processYawRate(stamp, 0.5, course));
+    EXPECT_NEAR(course.Y(), hdtCourse.Y() + 0.5 * n * 0.02, 1e-9);
+    EXPECT_NEAR(course.R(), hdtCourse.R() + std::pow(driftStd * n * 0.02, 2.), 1e-12);
+  }
+
+  // prediction snaps back to the next HDT course
+  hdt_frame.heading = *hdt_frame.heading + 0.2;
+  romea::core::Duration stamp = romea::core::durationFromSecond(0.8);
+  ASSERT_TRUE(gps_plugin->processHDT(stamp, hdt_frame.toNMEA(), hdtCourse));
+  EXPECT_TRUE(gps_plugin->processYawRate(romea::core::durationFromSecond(0.82), 0., course));
+  EXPECT_NEAR(course.Y(), hdtCourse.Y(), 1e-9);
+
+  // and stops when HDT courses are too old
+  stamp = romea::core::durationFromSecond(
+    0.8 + romea::core::HDTCourseStream::MAXIMAL_PREDICTION_DURATION + 0.1);
+  EXPECT_FALSE(gps_plugin->processYawRate(stamp, 0., course));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDualAntennaGPSPlugin, testNonFiniteYawRatesAreIgnored)
+{
+  check(romea::core::DiagnosticStatus::OK, romea::core::DiagnosticStatus::OK);
+  romea::core::ObservationCourse hdtCourse = course;
+
+  const double yawRates[] = {
+    std::numeric_limits<double>::quiet_NaN(),
+    std::numeric_limits<double>::infinity(),
+    -std::numeric_limits<double>::infinity()};
+  for (size_t n = 0; n < 3; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(0.52 + n * 0.02);
+    EXPECT_FALSE(gps_plugin->processYawRate(stamp, yawRates[n], course));
+  }
+
+  // prediction goes on from the HDT course as if they had not been fed
+  ASSERT_TRUE(gps_plugin->processYawRate(romea::core::durationFromSecond(0.6), 0.5, course));
+  EXPECT_TRUE(std::isfinite(course.Y()));
+  EXPECT_NEAR(course.Y(), hdtCourse.Y() + 0.5 * 0.1, 1e-9);
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
@@ -0,0 +1,135 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/CheckupGGAFix.hpp"
+#include "romea_core_localisation_gps/FixStatistics.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+romea::core::Duration seconds(const double & value)
+{
+  return romea::core::durationFromSecond(value);
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestFixStatistics, checkRunningStatistics)
+{
+  romea::core::RunningStatistics statistics;
+  EXPECT_TRUE(std::isnan(statistics.getMean()));
+
+  for (double value : {2., 4., 4., 4., 5., 5., 7., 9.}) {
+    statistics.update(value);
+  }
+
+  EXPECT_EQ(statistics.getCount(), 8u);
+  EXPECT_DOUBLE_EQ(statistics.getMean(), 5.);
+  EXPECT_DOUBLE_EQ(statistics.getVariance(), 32. / 7.);
+  EXPECT_DOUBLE_EQ(statistics.getMinimum(), 2.);
+  EXPECT_DOUBLE_EQ(statistics.getMaximum(), 9.);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestFixStatistics, checkExponentialMovingAverage)
+{
+  romea::core::ExponentialMovingAverage average(seconds(10.));
+  average.update(seconds(0.), 1.);
+  EXPECT_DOUBLE_EQ(average.getValue(), 1.);
+
+  average.update(seconds(10.), 2.);
+  EXPECT_NEAR(average.getValue(), 2. - std::exp(-1.), 1e-12);
+
+  // late values are ignored
+  average.update(seconds(5.), 100.);
+  EXPECT_NEAR(average.getValue(), 2. - std::exp(-1.), 1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestFixStatistics, checkTimeInFixQuality)
+{
+  romea::core::FixStatistics statistics;
+  romea::core::GGAFrame frame = minimalGoodGGAFrame();
+
+  for (size_t n = 0; n < 10; ++n) {
+    statistics.update(seconds(n), frame, romea::core::DiagnosticStatus::OK);
+  }
+  frame.fixQuality = romea::core::FixQuality::FLOAT_RTK_FIX;
+  for (size_t n = 10; n < 15; ++n) {
+    statistics.update(seconds(n), frame, romea::core::DiagnosticStatus::WARN);
+  }
+
+  EXPECT_EQ(statistics.getObservedTime(), seconds(14.));
+  EXPECT_EQ(statistics.getTimeIn(romea::core::FixQuality::RTK_FIX), seconds(10.));
+  EXPECT_EQ(statistics.getTimeIn(romea::core::FixQuality::FLOAT_RTK_FIX), seconds(4.));
+  EXPECT_DOUBLE_EQ(statistics.getAvailability(romea::core::FixQuality::RTK_FIX), 10. / 14.);
+  EXPECT_DOUBLE_EQ(statistics.getHDOPStatistics().getMean(), 1.2);
+  EXPECT_DOUBLE_EQ(statistics.getNumberOfSatellitesStatistics().getMinimum(), 12.);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestFixStatistics, checkFixLossEpisodes)
+{
+  romea::core::FixStatistics statistics(seconds(60.), seconds(5.));
+  romea::core::GGAFrame frame = minimalGoodGGAFrame();
+
+  statistics.update(seconds(0.), frame, romea::core::DiagnosticStatus::OK);
+  statistics.update(seconds(1.), frame, romea::core::DiagnosticStatus::ERROR);
+  statistics.update(seconds(2.), frame, romea::core::DiagnosticStatus::ERROR);
+  EXPECT_TRUE(statistics.isFixLost());
+  EXPECT_EQ(statistics.getTotalFixLossDuration(), seconds(1.));
+  statistics.update(seconds(4.), frame, romea::core::DiagnosticStatus::OK);
+  EXPECT_FALSE(statistics.isFixLost());
+
+  // no frame during more than the maximal gap
+  statistics.update(seconds(12.), frame, romea::core::DiagnosticStatus::OK);
+
+  EXPECT_EQ(statistics.getNumberOfFixLosses(), 2u);
+  EXPECT_EQ(statistics.getTotalFixLossDuration(), seconds(11.));
+  EXPECT_EQ(statistics.getMaximalFixLossDuration(), seconds(8.));
+  EXPECT_EQ(statistics.getTimeWithoutFix(), seconds(3.));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestFixStatistics, checkStatisticsAreReportedByGGAFixCheckup)
+{
+  romea::core::CheckupGGAFix checkup(romea::core::FixQuality::RTK_FIX);
+  romea::core::GGAFrame frame = minimalGoodGGAFrame();
+  for (size_t n = 0; n < 4; ++n) {
+    checkup.evaluate(frame, seconds(n));
+  }
+  checkup.reset();
+
+  EXPECT_EQ(checkup.getStatistics().getTimeIn(romea::core::FixQuality::RTK_FIX), seconds(3.));
+
+  auto report = checkup.getReport();
+  EXPECT_EQ(report.info.at("time_in_rtk_fix"), "3");
+  EXPECT_EQ(report.info.at("rtk_fix_availability"), "1");
+  EXPECT_EQ(report.info.at("hdop_mean"), "1.2");
+  EXPECT_EQ(report.info.at("fix_losses"), "0");
+
+  checkup.resetStatistics();
+  EXPECT_EQ(checkup.getStatistics().getObservedTime(), seconds(0.));
+}
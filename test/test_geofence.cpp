@@ -0,0 +1,260 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/CheckupGeofence.hpp"
+#include "romea_core_localisation_gps/Geofence.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+
+namespace
+{
+
+using Zone = romea::core::GeofenceZone;
+
+//-----------------------------------------------------------------------------
+std::vector<Eigen::Vector2d> square(const double & x, const double & y, const double & halfSize)
+{
+  return {
+    {x - halfSize, y - halfSize},
+    {x + halfSize, y - halfSize},
+    {x + halfSize, y + halfSize},
+    {x - halfSize, y + halfSize}};
+}
+
+//-----------------------------------------------------------------------------
+// star shaped polygon with a random radius per vertex
+std::vector<Eigen::Vector2d> star(
+  const Eigen::Vector2d & center,
+  const size_t & numberOfVertices,
+  std::mt19937 & generator)
+{
+  std::uniform_real_distribution<double> radius(20., 100.);
+  std::vector<Eigen::Vector2d> polygon;
+  for (size_t n = 0; n < numberOfVertices; ++n) {
+    double angle = 2 * M_PI * n / numberOfVertices;
+    polygon.push_back(center + radius(generator) * Eigen::Vector2d(std::cos(angle), std::sin(angle)));
+  }
+  return polygon;
+}
+
+//-----------------------------------------------------------------------------
+bool bruteForceIsInside(const std::vector<Eigen::Vector2d> & polygon, const Eigen::Vector2d & p)
+{
+  bool isInside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const auto & a = polygon[i];
+    const auto & b = polygon[j];
+    if ((a.y() > p.y()) != (b.y() > p.y()) &&
+      p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())
+    {
+      isInside = !isInside;
+    }
+  }
+  return isInside;
+}
+
+//-----------------------------------------------------------------------------
+double bruteForceDistance(const std::vector<Eigen::Vector2d> & polygon, const Eigen::Vector2d & p)
+{
+  double distance = std::numeric_limits<double>::infinity();
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    Eigen::Vector2d ab = polygon[i] - polygon[j];
+    double t = std::clamp((p - polygon[j]).dot(ab) / ab.squaredNorm(), 0., 1.);
+    distance = std::min(distance, (polygon[j] + t * ab - p).norm());
+  }
+  return distance;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkFieldBoundaryAndExclusionZone)
+{
+  romea::core::Geofence geofence({
+      {"field", Zone::Type::FIELD_BOUNDARY, square(0., 0., 100.)},
+      {"pond", Zone::Type::EXCLUSION_ZONE, square(50., 50., 10.)}});
+
+  auto status = geofence.locate({0., 0.});
+  EXPECT_TRUE(status.isInsideFieldBoundary);
+  EXPECT_FALSE(status.exclusionZone);
+  EXPECT_EQ(status.nearestZone, 1u);
+  EXPECT_NEAR(status.nearestZoneDistance, std::hypot(40., 40.), 1e-9);
+
+  status = geofence.locate({52., 47.});
+  EXPECT_TRUE(status.isInsideFieldBoundary);
+  EXPECT_EQ(status.exclusionZone, 1u);
+  EXPECT_NEAR(status.nearestZoneDistance, 7., 1e-9);
+
+  status = geofence.locate({-130., 0.});
+  EXPECT_FALSE(status.isInsideFieldBoundary);
+  EXPECT_FALSE(status.exclusionZone);
+  EXPECT_EQ(status.nearestZone, 0u);
+  EXPECT_NEAR(status.nearestZoneDistance, 30., 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkWithoutFieldBoundary)
+{
+  romea::core::Geofence geofence({{"pond", Zone::Type::EXCLUSION_ZONE, square(0., 0., 10.)}});
+  EXPECT_TRUE(geofence.locate({20., 0.}).isInsideFieldBoundary);
+  EXPECT_EQ(geofence.locate({1., 0.}).exclusionZone, 0u);
+
+  auto status = romea::core::Geofence({}).locate({0., 0.});
+  EXPECT_TRUE(status.isInsideFieldBoundary);
+  EXPECT_FALSE(status.nearestZone);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkInvalidZones)
+{
+  EXPECT_THROW(
+    romea::core::Geofence({{"line", Zone::Type::FIELD_BOUNDARY, {{0., 0.}, {1., 1.}}}}),
+    std::invalid_argument);
+  EXPECT_THROW(
+    romea::core::Geofence({{"field", Zone::Type::FIELD_BOUNDARY, square(0., 0., 1000.)}}, 0.01),
+    std::invalid_argument);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkAgainstBruteForce)
+{
+  std::mt19937 generator(42);
+  std::vector<Zone> zones = {
+    {"field", Zone::Type::FIELD_BOUNDARY, star({0., 0.}, 200, generator)},
+    {"hedge", Zone::Type::EXCLUSION_ZONE, star({150., 30.}, 50, generator)},
+    {"barn", Zone::Type::EXCLUSION_ZONE, square(-20., 10., 5.)}};
+
+  for (double cellSize : {0., 3., 40.}) {
+    romea::core::Geofence geofence(zones, cellSize);
+
+    std::uniform_real_distribution<double> coordinate(-300., 300.);
+    for (size_t n = 0; n < 500; ++n) {
+      Eigen::Vector2d position(coordinate(generator), coordinate(generator));
+      auto status = geofence.locate(position);
+
+      EXPECT_EQ(status.isInsideFieldBoundary, bruteForceIsInside(zones[0].polygon, position));
+      std::optional<size_t> exclusionZone;
+      double nearestZoneDistance = std::numeric_limits<double>::infinity();
+      for (size_t z = 0; z < zones.size(); ++z) {
+        if (!exclusionZone && z > 0 && bruteForceIsInside(zones[z].polygon, position)) {
+          exclusionZone = z;
+        }
+        nearestZoneDistance = std::min(
+          nearestZoneDistance, bruteForceDistance(zones[z].polygon, position));
+      }
+      EXPECT_EQ(status.exclusionZone, exclusionZone);
+      EXPECT_NEAR(status.nearestZoneDistance, nearestZoneDistance, 1e-9);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkReport)
+{
+  auto geofence = std::make_shared<romea::core::Geofence>(
+    std::vector<Zone>{
+    {"field", Zone::Type::FIELD_BOUNDARY, square(0., 0., 100.)},
+    {"pond", Zone::Type::EXCLUSION_ZONE, square(50., 50., 10.)}});
+  romea::core::CheckupGeofence checkup(geofence);
+  EXPECT_TRUE(checkup.getReport().diagnostics.empty());
+
+  EXPECT_EQ(checkup.evaluate({0., 90.}), romea::core::DiagnosticStatus::OK);
+  auto report = checkup.getReport();
+  ASSERT_EQ(report.diagnostics.size(), 1u);
+  EXPECT_EQ(report.diagnostics.front().message, "Position is inside field boundaries.");
+  EXPECT_EQ(report.info.at("nearest_zone"), "field");
+  EXPECT_EQ(report.info.at("nearest_zone_distance"), "10");
+
+  EXPECT_EQ(checkup.evaluate({0., 110.}), romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(
+    checkup.getReport().diagnostics.front().message, "Position is outside field boundaries.");
+
+  EXPECT_EQ(checkup.evaluate({50., 50.}), romea::core::DiagnosticStatus::ERROR);
+  EXPECT_EQ(
+    checkup.getReport().diagnostics.front().message, "Position is inside exclusion zone pond.");
+
+  checkup.reset();
+  EXPECT_TRUE(checkup.getReport().diagnostics.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkPluginReportsGeofence)
+{
+  romea::core::LocalisationGPSPlugin<> plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  plugin.setGeofence(
+    std::make_shared<romea::core::Geofence>(
+      std::vector<Zone>{{"barn", Zone::Type::EXCLUSION_ZONE, square(0., 0., 10.)}}));
+
+  std::vector<romea::core::StatusTransition> transitions;
+  plugin.registerStatusTransitionCallback(
+    [&transitions](const romea::core::StatusTransition & transition) {
+      if (transition.checkup == romea::core::GPSCheckup::GEOFENCE) {
+        transitions.push_back(transition);
+      }
+    });
+
+  romea::core::ObservationPosition position;
+  auto frame = minimalGoodGGAFrame();
+  bool isPositionPublished = false;
+  for (size_t n = 0; n < 8; ++n) {
+    isPositionPublished = plugin.processGGA(romea::core::durationFromSecond(n), frame, position);
+  }
+  ASSERT_TRUE(isPositionPublished);
+
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(7.));
+  EXPECT_EQ(report.diagnostics.back().status, romea::core::DiagnosticStatus::ERROR);
+  EXPECT_EQ(report.diagnostics.back().message, "Position is inside exclusion zone barn.");
+  EXPECT_EQ(report.info.at("nearest_zone"), "barn");
+
+  ASSERT_EQ(transitions.size(), 1u);
+  EXPECT_EQ(transitions.front().currentStatus, romea::core::DiagnosticStatus::ERROR);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGeofence, checkPluginGeofenceIsDroppedWhenAnchorChanges)
+{
+  romea::core::LocalisationGPSPlugin<> plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  plugin.setGeofence(
+    std::make_shared<romea::core::Geofence>(
+      std::vector<Zone>{{"barn", Zone::Type::EXCLUSION_ZONE, square(0., 0., 10.)}}));
+
+  romea::core::ObservationPosition position;
+  auto frame = minimalGoodGGAFrame();
+  for (size_t n = 0; n < 8; ++n) {
+    plugin.processGGA(romea::core::durationFromSecond(n), frame, position);
+  }
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(7.));
+  EXPECT_EQ(report.info.count("nearest_zone"), 1u);
+
+  plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7855, 0.03, 454.1));
+  plugin.processGGA(romea::core::durationFromSecond(8), frame, position);
+  report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(8.));
+  EXPECT_EQ(report.info.count("nearest_zone"), 0u);
+}
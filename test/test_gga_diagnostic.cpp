@@ -202,6 +202,19 @@ TEST_F(TestGGAFixDiagnostic, severalUnreliableData)
     "Fix quality is too low.");
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestGGAFixDiagnostic, replayedFrameIsNotCountedInStatistics)
+{
+  EXPECT_EQ(
+    diagnostic.replay(frame, romea::core::durationFromSecond(1.)),
+    romea::core::DiagnosticStatus::OK);
+  EXPECT_STREQ(diagnostic.getReport().diagnostics.front().message.c_str(), "GGA fix OK.");
+  EXPECT_EQ(diagnostic.getStatistics().getHDOPStatistics().getCount(), 0u);
+
+  diagnostic.evaluate(frame, romea::core::durationFromSecond(2.));
+  EXPECT_EQ(diagnostic.getStatistics().getHDOPStatistics().getCount(), 1u);
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
@@ -0,0 +1,108 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+
+// romea
+#include "romea_core_localisation_gps/GSTCovarianceCache.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+romea::core::GSTFrame makeGSTFrame(
+  const double & semiMajorAxisStd,
+  const double & semiMinorAxisStd,
+  const double & orientation)
+{
+  romea::core::GSTFrame frame;
+  frame.talkerId = romea::core::TalkerId::GN;
+  frame.semiMajorAxisStd = semiMajorAxisStd;
+  frame.semiMinorAxisStd = semiMinorAxisStd;
+  frame.semiMajorAxisOrientation = orientation;
+  frame.latitudeStd = 0.5;
+  frame.longitudeStd = 0.7;
+  return frame;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestGSTCovarianceCache, checkErrorEllipseIsRotatedIntoENU)
+{
+  romea::core::GSTCovarianceCache cache;
+  romea::core::Duration stamp = romea::core::durationFromSecond(1.);
+
+  // semi-major axis pointing to the east
+  ASSERT_TRUE(cache.update(stamp, makeGSTFrame(0.3, 0.1, M_PI / 2.)));
+  ASSERT_NE(cache.find(stamp), nullptr);
+  Eigen::Matrix2d covariance = *cache.find(stamp);
+  EXPECT_NEAR(covariance(0, 0), 0.09, 1e-12);
+  EXPECT_NEAR(covariance(1, 1), 0.01, 1e-12);
+  EXPECT_NEAR(covariance(0, 1), 0., 1e-12);
+
+  // semi-major axis pointing to the north east
+  ASSERT_TRUE(cache.update(stamp, makeGSTFrame(0.3, 0.1, M_PI / 4.)));
+  covariance = *cache.find(stamp);
+  EXPECT_NEAR(covariance(0, 0), 0.05, 1e-12);
+  EXPECT_NEAR(covariance(1, 1), 0.05, 1e-12);
+  EXPECT_NEAR(covariance(0, 1), 0.04, 1e-12);
+  EXPECT_NEAR(covariance(1, 0), 0.04, 1e-12);
+
+  Eigen::Vector2d northEast(std::sqrt(0.5), std::sqrt(0.5));
+  EXPECT_NEAR(northEast.dot(covariance * northEast), 0.09, 1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGSTCovarianceCache, checkLatitudeAndLongitudeStdsAreUsedWithoutEllipse)
+{
+  romea::core::GSTCovarianceCache cache;
+  romea::core::Duration stamp = romea::core::durationFromSecond(1.);
+
+  auto frame = makeGSTFrame(0.3, 0.1, M_PI / 2.);
+  frame.semiMajorAxisOrientation.reset();
+  ASSERT_TRUE(cache.update(stamp, frame));
+  Eigen::Matrix2d covariance = *cache.find(stamp);
+  EXPECT_DOUBLE_EQ(covariance(0, 0), 0.49);
+  EXPECT_DOUBLE_EQ(covariance(1, 1), 0.25);
+  EXPECT_DOUBLE_EQ(covariance(0, 1), 0.);
+
+  frame.latitudeStd = 0.;
+  EXPECT_FALSE(cache.update(stamp, frame));
+  EXPECT_EQ(cache.find(stamp), nullptr);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGSTCovarianceCache, checkStaleCovarianceIsNotFound)
+{
+  romea::core::GSTCovarianceCache cache(romea::core::durationFromSecond(0.2));
+  romea::core::Duration stamp = romea::core::durationFromSecond(1.);
+  EXPECT_EQ(cache.find(stamp), nullptr);
+
+  ASSERT_TRUE(cache.update(stamp, makeGSTFrame(0.3, 0.1, 0.)));
+  EXPECT_NE(cache.find(romea::core::durationFromSecond(1.2)), nullptr);
+  EXPECT_EQ(cache.find(romea::core::durationFromSecond(1.3)), nullptr);
+  EXPECT_EQ(cache.find(romea::core::durationFromSecond(0.7)), nullptr);
+
+  cache.setMaximalAge(romea::core::durationFromSecond(1.));
+  EXPECT_NE(cache.find(romea::core::durationFromSecond(1.3)), nullptr);
+
+  cache.reset();
+  EXPECT_EQ(cache.find(stamp), nullptr);
+}
@@ -0,0 +1,173 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_gps/GSVCycleCache.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+std::string makeGSVSentence(
+  const std::string & talker,
+  const size_t & total,
+  const size_t & number,
+  const size_t & cycle = 0)
+{
+  std::string sentence = "$" + talker + "GSV," + std::to_string(total) + "," +
+    std::to_string(number) + ",12," + std::to_string(cycle % 100) + ",40,083,46";
+
+  unsigned char checksum = 0;
+  for (size_t n = 1; n < sentence.size(); ++n) {
+    checksum ^= sentence[n];
+  }
+  char suffix[4];
+  std::snprintf(suffix, sizeof(suffix), "*%02X", checksum);
+  return sentence + suffix;
+}
+
+//-----------------------------------------------------------------------------
+void updateCycle(
+  romea::core::GSVCycleCache & cache,
+  const std::string & talker,
+  const size_t & total,
+  const size_t & cycle = 0)
+{
+  for (size_t number = 1; number <= total; ++number) {
+    EXPECT_TRUE(cache.update(makeGSVSentence(talker, total, number, cycle)));
+  }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestGSVCycleCache, checkLastCycleOfEachTalkerIsKept)
+{
+  romea::core::GSVCycleCache cache;
+  EXPECT_TRUE(cache.getSentences().empty());
+
+  // GPS, GLONASS, Galileo and BeiDou cycles of 3 to 5 sentences
+  updateCycle(cache, "GP", 4, 0);
+  updateCycle(cache, "GL", 3, 0);
+  updateCycle(cache, "GA", 5, 0);
+  updateCycle(cache, "GB", 3, 0);
+  updateCycle(cache, "GP", 3, 1);
+
+  std::vector<std::string> expected;
+  for (size_t number = 1; number <= 3; ++number) {
+    expected.push_back(makeGSVSentence("GP", 3, number, 1));
+  }
+  for (size_t number = 1; number <= 3; ++number) {
+    expected.push_back(makeGSVSentence("GL", 3, number, 0));
+  }
+  for (size_t number = 1; number <= 5; ++number) {
+    expected.push_back(makeGSVSentence("GA", 5, number, 0));
+  }
+  for (size_t number = 1; number <= 3; ++number) {
+    expected.push_back(makeGSVSentence("GB", 3, number, 0));
+  }
+  EXPECT_EQ(cache.getSentences(), expected);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGSVCycleCache, checkIncompleteCyclesAreDropped)
+{
+  romea::core::GSVCycleCache cache;
+  updateCycle(cache, "GP", 2, 0);
+  std::vector<std::string> previous = cache.getSentences();
+
+  // a cycle is only published once its last sentence is received
+  EXPECT_TRUE(cache.update(makeGSVSentence("GP", 3, 1, 1)));
+  EXPECT_TRUE(cache.update(makeGSVSentence("GP", 3, 2, 1)));
+  EXPECT_EQ(cache.getSentences(), previous);
+
+  // a missing sentence drops the cycle
+  EXPECT_TRUE(cache.update(makeGSVSentence("GP", 3, 1, 2)));
+  EXPECT_FALSE(cache.update(makeGSVSentence("GP", 3, 3, 2)));
+  EXPECT_FALSE(cache.update(makeGSVSentence("GP", 3, 2, 2)));
+  EXPECT_EQ(cache.getSentences(), previous);
+
+  updateCycle(cache, "GP", 1, 3);
+  EXPECT_EQ(cache.getSentences(), std::vector<std::string>{makeGSVSentence("GP", 1, 1, 3)});
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGSVCycleCache, checkInvalidSentencesAreDropped)
+{
+  romea::core::GSVCycleCache cache;
+  EXPECT_FALSE(cache.update("$GPGGA,1,1,12"));
+  EXPECT_FALSE(cache.update("$GPGSV,"));
+  EXPECT_FALSE(cache.update("$GPGSV,0,1,12,05,40,083,46"));
+  EXPECT_FALSE(cache.update("$GPGSV,2,3,12,05,40,083,46"));
+  EXPECT_FALSE(cache.update("$GPGSV,12,1,12,05,40,083,46"));
+  EXPECT_FALSE(cache.update(makeGSVSentence("GP", 1, 1) +
+    std::string(romea::core::GSVCycleCache::MAXIMAL_SENTENCE_LENGTH, ',')));
+  EXPECT_TRUE(cache.getSentences().empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGSVCycleCache, checkNumberOfTalkersIsBounded)
+{
+  romea::core::GSVCycleCache cache;
+  const char * talkers[] = {"GP", "GL", "GA", "GB", "BD", "GQ", "GI", "GN"};
+  for (const char * talker : talkers) {
+    updateCycle(cache, talker, 1);
+  }
+  EXPECT_FALSE(cache.update(makeGSVSentence("QZ", 1, 1)));
+  EXPECT_EQ(cache.getSentences().size(), romea::core::GSVCycleCache::MAXIMAL_NUMBER_OF_TALKERS);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestGSVCycleCache, checkConcurrentReadersSeeWholeCycles)
+{
+  romea::core::GSVCycleCache cache;
+  std::atomic<bool> stop(false);
+
+  std::thread writer([&] {
+      for (size_t cycle = 0; cycle < 5000; ++cycle) {
+        updateCycle(cache, "GP", 4, cycle);
+        updateCycle(cache, "GL", 3, cycle);
+      }
+      stop = true;
+    });
+
+  // all the sentences of a talker come from the same cycle
+  while (!stop) {
+    std::map<std::string, std::set<std::string>> cycles;
+    std::map<std::string, size_t> numberOfSentences;
+    for (const auto & sentence : cache.getSentences()) {
+      std::string talker = sentence.substr(1, 2);
+      cycles[talker].insert(sentence.substr(14, sentence.find(',', 14) - 14));
+      numberOfSentences[talker]++;
+    }
+    for (const auto & [talker, talkerCycles] : cycles) {
+      EXPECT_EQ(talkerCycles.size(), 1u);
+      EXPECT_EQ(numberOfSentences[talker], talker == "GP" ? 4u : 3u);
+    }
+  }
+  writer.join();
+}
@@ -0,0 +1,184 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSAwaitables.hpp"
+
+namespace
+{
+
+// coroutine starting eagerly and kept suspended at its end until destroyed
+struct Task
+{
+  struct promise_type
+  {
+    Task get_return_object()
+    {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_never initial_suspend() noexcept {return {};}
+    std::suspend_always final_suspend() noexcept {return {};}
+    void return_void() {}
+    void unhandled_exception() {std::terminate();}
+  };
+
+  explicit Task(std::coroutine_handle<promise_type> coroutine)
+  : handle(coroutine)
+  {
+  }
+
+  Task(Task && other)
+  : handle(std::exchange(other.handle, nullptr))
+  {
+  }
+
+  ~Task()
+  {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  bool done() const
+  {
+    return handle.done();
+  }
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+//-----------------------------------------------------------------------------
+Task collectPositions(
+  romea::core::LocalisationGPSPluginBase & plugin,
+  // taken by value, references to temporaries would dangle once suspended
+  size_t numberOfPositions,
+  std::vector<romea::core::Duration> & stamps,
+  std::vector<std::thread::id> & threads)
+{
+  for (size_t n = 0; n < numberOfPositions; ++n) {
+    auto position = co_await romea::core::nextPosition(plugin);
+    stamps.push_back(position.stamp);
+    threads.push_back(std::this_thread::get_id());
+  }
+}
+
+//-----------------------------------------------------------------------------
+Task collectCourse(
+  romea::core::LocalisationGPSPluginBase & plugin,
+  romea::core::StampedObservation<romea::core::ObservationCourse> & course)
+{
+  course = co_await romea::core::nextCourse(plugin);
+}
+
+}  // namespace
+
+class TestLocalisationGPSAwaitables : public ::testing::Test
+{
+public:
+  TestLocalisationGPSAwaitables()
+  : gga_sentence(minimalGoodGGAFrame().toNMEA()),
+    rmc_sentence(minimalGoodRMCFrame().toNMEA()),
+    plugin(std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.)
+  {
+  }
+
+  bool feed(const double & time)
+  {
+    romea::core::Duration stamp = romea::core::durationFromSecond(time);
+    plugin.processLinearSpeed(stamp, 2.);
+    plugin.processRMC(stamp, rmc_sentence, course);
+    return plugin.processGGA(stamp, gga_sentence, position);
+  }
+
+  std::string gga_sentence;
+  std::string rmc_sentence;
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+  romea::core::LocalisationSingleAntennaGPSPlugin plugin;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSAwaitables, checkCoroutineIsResumedOnValidPositions)
+{
+  std::vector<romea::core::Duration> stamps;
+  std::vector<std::thread::id> threads;
+  std::vector<romea::core::Duration> validStamps;
+
+  // the coroutine is started and resumed by another thread than the feeding one
+  std::unique_ptr<Task> task;
+  std::thread([&]() {
+      task = std::make_unique<Task>(collectPositions(plugin, 3, stamps, threads));
+    }).join();
+  EXPECT_FALSE(task->done());
+
+  for (size_t n = 0; n <= 30 && !task->done(); ++n) {
+    if (feed(n / 20.)) {
+      validStamps.push_back(romea::core::durationFromSecond(n / 20.));
+    }
+  }
+
+  ASSERT_TRUE(task->done());
+  ASSERT_EQ(validStamps.size(), 3u);
+  EXPECT_EQ(stamps, validStamps);
+  EXPECT_EQ(threads, std::vector<std::thread::id>(3, std::this_thread::get_id()));
+  EXPECT_TRUE(plugin.getPositionWaitList().empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSAwaitables, checkCoroutineIsResumedOnValidCourse)
+{
+  romea::core::StampedObservation<romea::core::ObservationCourse> awaitedCourse{};
+  Task task = collectCourse(plugin, awaitedCourse);
+
+  double time = 0.;
+  while (!task.done() && time < 2.) {
+    feed(time);
+    time += 0.05;
+  }
+
+  ASSERT_TRUE(task.done());
+  EXPECT_DOUBLE_EQ(awaitedCourse.observation.Y(), course.Y());
+  EXPECT_DOUBLE_EQ(awaitedCourse.observation.R(), course.R());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSAwaitables, checkDestroyingSuspendedCoroutineCancelsWait)
+{
+  std::vector<romea::core::Duration> stamps;
+  std::vector<std::thread::id> threads;
+  {
+    Task task = collectPositions(plugin, 1, stamps, threads);
+    EXPECT_FALSE(plugin.getPositionWaitList().empty());
+  }
+  EXPECT_TRUE(plugin.getPositionWaitList().empty());
+
+  for (size_t n = 0; n <= 30; ++n) {
+    feed(n / 20.);
+  }
+  EXPECT_TRUE(stamps.empty());
+}
@@ -0,0 +1,312 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSFleet.hpp"
+
+class TestLocalisationGPSFleet : public ::testing::Test
+{
+public:
+  TestLocalisationGPSFleet()
+  : fleet(4, 4),
+    gga_sentence(minimalGoodGGAFrame().toNMEA()),
+    rmc_sentence(minimalGoodRMCFrame().toNMEA()),
+    hdt_sentence(minimalGoodHDTFrame().toNMEA()),
+    mutex(),
+    position_stamps(),
+    course_stamps()
+  {
+  }
+
+  void SetUp() override
+  {
+    fleet.setPositionCallback(
+      [this](const romea::core::VehicleId & id, const romea::core::Duration & stamp,
+      const romea::core::ObservationPosition &) {
+        std::lock_guard<std::mutex> lock(mutex);
+        position_stamps[id].push_back(stamp);
+      });
+
+    fleet.setCourseCallback(
+      [this](const romea::core::VehicleId & id, const romea::core::Duration & stamp,
+      const romea::core::ObservationCourse &) {
+        std::lock_guard<std::mutex> lock(mutex);
+        course_stamps[id].push_back(stamp);
+      });
+  }
+
+  void addSingleAntennaVehicle(const romea::core::VehicleId & id)
+  {
+    fleet.addVehicle(
+      id, std::make_unique<romea::core::LocalisationSingleAntennaGPSPlugin>(
+        std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.));
+  }
+
+  void addDualAntennaVehicle(const romea::core::VehicleId & id)
+  {
+    fleet.addVehicle(
+      id, std::make_unique<romea::core::LocalisationDualAntennaGPSPlugin>(
+        std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX));
+  }
+
+  romea::core::LocalisationGPSFleet fleet;
+  std::string gga_sentence;
+  std::string rmc_sentence;
+  std::string hdt_sentence;
+
+  std::mutex mutex;
+  std::map<romea::core::VehicleId, std::vector<romea::core::Duration>> position_stamps;
+  std::map<romea::core::VehicleId, std::vector<romea::core::Duration>> course_stamps;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSFleet, checkVehicleInputsAreProcessedInOrder)
+{
+  const size_t number_of_vehicles = 64;
+  const size_t number_of_steps = 50;
+
+  for (size_t id = 0; id < number_of_vehicles; ++id) {
+    if (id % 2) {
+      addSingleAntennaVehicle(id);
+    } else {
+      addDualAntennaVehicle(id);
+    }
+  }
+
+  for (size_t n = 0; n < number_of_steps; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n);
+    for (size_t id = 0; id < number_of_vehicles; ++id) {
+      EXPECT_TRUE(fleet.postSentence(id, stamp, gga_sentence));
+      if (id % 2) {
+        EXPECT_TRUE(fleet.postLinearSpeed(id, stamp, 2.0));
+        EXPECT_TRUE(fleet.postSentence(id, stamp, rmc_sentence));
+      } else {
+        EXPECT_TRUE(fleet.postSentence(id, stamp, hdt_sentence));
+      }
+    }
+  }
+  fleet.waitUntilIdle();
+
+  auto metrics = fleet.getMetrics();
+  EXPECT_EQ(metrics.numberOfVehicles, number_of_vehicles);
+  EXPECT_EQ(metrics.postedInputs, number_of_steps * number_of_vehicles * 5 / 2);
+  EXPECT_EQ(metrics.processedInputs, metrics.postedInputs);
+  EXPECT_EQ(metrics.pendingInputs, 0u);
+  EXPECT_EQ(metrics.rejectedInputs, 0u);
+  EXPECT_EQ(metrics.failedInputs, 0u);
+  EXPECT_GT(metrics.maximalVehicleQueueLength, 0u);
+  EXPECT_GT(metrics.throughput, 0.);
+  EXPECT_EQ(metrics.pool.numberOfThreads, 4u);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(position_stamps.size(), number_of_vehicles);
+  ASSERT_EQ(course_stamps.size(), number_of_vehicles);
+  for (size_t id = 0; id < number_of_vehicles; ++id) {
+    EXPECT_FALSE(position_stamps[id].empty());
+    EXPECT_TRUE(std::is_sorted(position_stamps[id].begin(), position_stamps[id].end()));
+    EXPECT_TRUE(std::is_sorted(course_stamps[id].begin(), course_stamps[id].end()));
+  }
+  EXPECT_EQ(metrics.positionObservations, metrics.courseObservations);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSFleet, checkVehiclePluginsCountSentences)
+{
+  addSingleAntennaVehicle(1);
+  addDualAntennaVehicle(2);
+
+  for (size_t n = 0; n < 3; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n);
+    fleet.postSentence(1, stamp, gga_sentence);
+    fleet.postSentence(1, stamp, rmc_sentence);
+    fleet.postSentence(2, stamp, hdt_sentence);
+  }
+  fleet.waitUntilIdle();
+
+  romea::core::Duration stamp = romea::core::durationFromSecond(3.);
+  auto single_antenna_report = static_cast<romea::core::LocalisationSingleAntennaGPSPlugin *>(
+    fleet.getPlugin(1))->makeDiagnosticReport(stamp);
+  EXPECT_EQ(single_antenna_report.info.at("nmea_gga_sentences"), "3");
+  EXPECT_EQ(single_antenna_report.info.at("nmea_rmc_sentences"), "3");
+
+  auto dual_antenna_report = static_cast<romea::core::LocalisationDualAntennaGPSPlugin *>(
+    fleet.getPlugin(2))->makeDiagnosticReport(stamp);
+  EXPECT_EQ(dual_antenna_report.info.at("nmea_hdt_sentences"), "3");
+  EXPECT_EQ(dual_antenna_report.info.count("nmea_gga_sentences"), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSFleet, checkGSTErrorEllipseGivesPositionCovariance)
+{
+  romea::core::ObservationPosition last_position;
+  fleet.setPositionCallback(
+    [&](const romea::core::VehicleId &, const romea::core::Duration &,
+    const romea::core::ObservationPosition & position) {
+      std::lock_guard<std::mutex> lock(mutex);
+      last_position = position;
+    });
+
+  addDualAntennaVehicle(1);
+  std::string gst_sentence = "$GNGST,120000.00,1.8,0.03,0.01,90.0,0.011,0.029,0.05";
+  for (size_t n = 0; n <= 20; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / 20.);
+    EXPECT_TRUE(fleet.postSentence(1, stamp, gga_sentence));
+    EXPECT_TRUE(fleet.postSentence(1, stamp, gst_sentence));
+  }
+  fleet.waitUntilIdle();
+
+  // the GGA which follows a GST gets an east-west elongated covariance
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(fleet.getMetrics().rejectedInputs, 0u);
+  EXPECT_NEAR(last_position.R()(0, 0), 0.0009, 1e-12);
+  EXPECT_NEAR(last_position.R()(1, 1), 0.0001, 1e-12);
+  EXPECT_NEAR(last_position.R()(0, 1), 0., 1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSFleet, checkUnsupportedInputsAreRejected)
+{
+  addSingleAntennaVehicle(1);
+  addDualAntennaVehicle(2);
+
+  romea::core::Duration stamp = romea::core::durationFromSecond(1.);
+  EXPECT_FALSE(fleet.postSentence(3, stamp, gga_sentence));
+  EXPECT_FALSE(fleet.postSentence(1, stamp, hdt_sentence));
+  EXPECT_FALSE(fleet.postSentence(2, stamp, rmc_sentence));
+  EXPECT_FALSE(fleet.postSentence(2, stamp, "garbage"));
+  EXPECT_FALSE(fleet.postLinearSpeed(2, stamp, 1.0));
+  fleet.waitUntilIdle();
+
+  auto metrics = fleet.getMetrics();
+  EXPECT_EQ(metrics.rejectedInputs, 5u);
+  EXPECT_EQ(metrics.postedInputs, 0u);
+  EXPECT_EQ(fleet.getPlugin(3), nullptr);
+  EXPECT_NE(fleet.getPlugin(1), nullptr);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSFleet, checkVehicleIdsAreUnique)
+{
+  addSingleAntennaVehicle(1);
+  EXPECT_THROW(addDualAntennaVehicle(1), std::invalid_argument);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLocalisationGPSFleetScheduling, checkFloodedVehicleDoesNotStarveOthers)
+{
+  const size_t maximal_batch_size = 4;
+  romea::core::LocalisationGPSFleet fleet(1, maximal_batch_size);
+  for (romea::core::VehicleId id = 1; id <= 2; ++id) {
+    fleet.addVehicle(
+      id, std::make_unique<romea::core::LocalisationDualAntennaGPSPlugin>(
+        std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX));
+  }
+
+  // the single worker is held by the first observation of vehicle 1 until
+  // the inputs of vehicle 2 are queued behind its flood
+  std::promise<void> blocked;
+  std::promise<void> posted;
+  std::shared_future<void> isPosted = posted.get_future().share();
+  std::mutex mutex;
+  std::vector<romea::core::VehicleId> ids;
+  fleet.setPositionCallback(
+    [&](const romea::core::VehicleId & id, const romea::core::Duration &,
+    const romea::core::ObservationPosition &) {
+      if (id == 1 && ids.empty()) {
+        blocked.set_value();
+        isPosted.wait();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      ids.push_back(id);
+    });
+
+  std::string gga_sentence = minimalGoodGGAFrame().toNMEA();
+  for (size_t n = 0; n < 200; ++n) {
+    EXPECT_TRUE(fleet.postSentence(1, romea::core::durationFromSecond(n * 0.1), gga_sentence));
+  }
+  blocked.get_future().wait();
+  for (size_t n = 0; n < 10; ++n) {
+    EXPECT_TRUE(fleet.postSentence(2, romea::core::durationFromSecond(n * 0.1), gga_sentence));
+  }
+  posted.set_value();
+  fleet.waitUntilIdle();
+
+  // vehicles alternate batch by batch once both are queued
+  std::lock_guard<std::mutex> lock(mutex);
+  auto last_vehicle2_observation = std::find(ids.rbegin(), ids.rend(), 2u);
+  ASSERT_NE(last_vehicle2_observation, ids.rend());
+  size_t vehicle1_observations = std::count(last_vehicle2_observation, ids.rend(), 1u);
+  EXPECT_LE(vehicle1_observations, 4 * maximal_batch_size);
+  EXPECT_GT(std::count(ids.begin(), ids.end(), 1u), 100);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLocalisationGPSFleetScheduling, checkFullVehicleQueueRejectsInputs)
+{
+  const size_t vehicle_queue_capacity = 16;
+  romea::core::LocalisationGPSFleet fleet(1, 4, vehicle_queue_capacity);
+  fleet.addVehicle(
+    1, std::make_unique<romea::core::LocalisationDualAntennaGPSPlugin>(
+      std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX));
+
+  // the single worker is held by the first observation while the queue fills
+  std::promise<void> blocked;
+  std::future<void> isBlocked = blocked.get_future();
+  std::promise<void> filled;
+  std::shared_future<void> isFilled = filled.get_future().share();
+  bool is_first_observation = true;
+  fleet.setPositionCallback(
+    [&](const romea::core::VehicleId &, const romea::core::Duration &,
+    const romea::core::ObservationPosition &) {
+      if (is_first_observation) {
+        is_first_observation = false;
+        blocked.set_value();
+        isFilled.wait();
+      }
+    });
+
+  std::string gga_sentence = minimalGoodGGAFrame().toNMEA();
+  size_t n = 0;
+  while (isBlocked.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+    ASSERT_TRUE(fleet.postSentence(1, romea::core::durationFromSecond(n++), gga_sentence));
+  }
+  while (fleet.postSentence(1, romea::core::durationFromSecond(n), gga_sentence)) {
+    ++n;
+  }
+  filled.set_value();
+  fleet.waitUntilIdle();
+
+  auto metrics = fleet.getMetrics();
+  EXPECT_EQ(metrics.rejectedInputs, 1u);
+  EXPECT_EQ(metrics.postedInputs, n);
+  EXPECT_EQ(metrics.processedInputs, n);
+  EXPECT_EQ(metrics.maximalVehicleQueueLength, vehicle_queue_capacity);
+}
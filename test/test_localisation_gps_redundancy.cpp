@@ -0,0 +1,140 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSRedundancy.hpp"
+
+class TestLocalisationGPSRedundancy : public ::testing::Test
+{
+public:
+  using Mode = romea::core::LocalisationGPSRedundancy::Mode;
+
+  void init(const Mode & mode, const size_t & numberOfReceivers)
+  {
+    redundancy = std::make_unique<romea::core::LocalisationGPSRedundancy>(
+      mode, romea::core::durationFromSecond(0.2));
+
+    frames.assign(numberOfReceivers, minimalGoodGGAFrame());
+    for (size_t n = 0; n < numberOfReceivers; ++n) {
+      redundancy->addReceiver(
+        std::make_shared<romea::core::LocalisationGPSPlugin<>>(
+          std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX));
+    }
+  }
+
+  // feeds one epoch, receivers in order, returns the number of observations
+  size_t feedEpoch(const size_t & epoch, const std::vector<size_t> & receivers)
+  {
+    size_t numberOfObservations = 0;
+    for (const size_t & receiver : receivers) {
+      romea::core::Duration stamp = romea::core::durationFromSecond(epoch + receiver * 0.01);
+      numberOfObservations += redundancy->processGGA(receiver, stamp, frames[receiver], output);
+    }
+    return numberOfObservations;
+  }
+
+  // the GGA rate checkup requires a few fixes before fixes are valid
+  void warmUp(const std::vector<size_t> & receivers)
+  {
+    for (size_t epoch = 0; epoch < 4; ++epoch) {
+      EXPECT_EQ(feedEpoch(epoch, receivers), 0u);
+    }
+  }
+
+  std::unique_ptr<romea::core::LocalisationGPSRedundancy> redundancy;
+  std::vector<romea::core::GGAFrame> frames;
+  romea::core::RedundantPositionObservation output;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSRedundancy, checkMostAccurateFixIsSelected)
+{
+  init(Mode::BEST, 2);
+  frames[0].horizontalDilutionOfPrecision = 1.4;
+  frames[1].horizontalDilutionOfPrecision = 0.9;
+  warmUp({0, 1});
+
+  EXPECT_EQ(feedEpoch(4, {0, 1}), 1u);
+  EXPECT_EQ(output.referenceReceiver, 1u);
+  EXPECT_EQ(output.numberOfMergedReceivers, 1u);
+  EXPECT_EQ(output.stamp, romea::core::durationFromSecond(4.01));
+  EXPECT_EQ(redundancy->getReceiverStatus(1).numberOfSelections, 1u);
+  EXPECT_FALSE(redundancy->getReceiverStatus(0).isDisagreeing);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSRedundancy, checkConsistentFixesAreMerged)
+{
+  init(Mode::MERGE, 2);
+  frames[0].horizontalDilutionOfPrecision = 1.0;
+  frames[1].horizontalDilutionOfPrecision = 2.0;
+  frames[1].latitude = romea::core::Latitude(0.7854 + 1e-8);
+  redundancy->setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 400.8));
+  warmUp({0, 1});
+
+  EXPECT_EQ(feedEpoch(4, {0, 1}), 1u);
+  EXPECT_EQ(output.referenceReceiver, 0u);
+  EXPECT_EQ(output.numberOfMergedReceivers, 2u);
+
+  // weights are inversely proportional to the covariances (hdop ratio of 2)
+  double northing = output.observation.Y(romea::core::ObservationPosition::POSITION_Y);
+  EXPECT_NEAR(northing, 1e-8 * 6378137. / 5., 1e-6);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSRedundancy, checkDisagreeingReceiverIsFlagged)
+{
+  init(Mode::MERGE, 3);
+  frames[2].latitude = romea::core::Latitude(0.7854 + 1e-5);
+  warmUp({0, 1, 2});
+
+  EXPECT_EQ(feedEpoch(4, {0, 1, 2}), 1u);
+  EXPECT_NE(output.referenceReceiver, 2u);
+  EXPECT_EQ(output.numberOfMergedReceivers, 2u);
+  EXPECT_TRUE(redundancy->getReceiverStatus(2).isDisagreeing);
+  EXPECT_EQ(redundancy->getReceiverStatus(2).numberOfDisagreements, 1u);
+  EXPECT_FALSE(redundancy->getReceiverStatus(0).isDisagreeing);
+
+  auto report = redundancy->makeDiagnosticReport();
+  ASSERT_EQ(report.diagnostics.size(), 3u);
+  EXPECT_EQ(report.diagnostics.back().status, romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(report.info["gps_receiver_2_disagreements"], "1");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationGPSRedundancy, checkMissingReceiverDelaysEpochAtMostTolerance)
+{
+  init(Mode::BEST, 2);
+  warmUp({0, 1});
+
+  // receiver 1 is silent, epoch is closed by flush once tolerance elapsed
+  EXPECT_EQ(feedEpoch(4, {0}), 0u);
+  EXPECT_FALSE(redundancy->flush(romea::core::durationFromSecond(4.1), output));
+  EXPECT_TRUE(redundancy->flush(romea::core::durationFromSecond(4.3), output));
+  EXPECT_EQ(output.referenceReceiver, 0u);
+
+  // or by the fix of the next epoch
+  EXPECT_EQ(feedEpoch(5, {0}), 0u);
+  EXPECT_EQ(feedEpoch(6, {0}), 1u);
+  EXPECT_EQ(output.stamp, romea::core::durationFromSecond(5.));
+}
@@ -0,0 +1,93 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_gps/LockProfiler.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+romea::core::LockProfile findProfile(const std::string & name)
+{
+  auto profiles = romea::core::LockProfiler::getProfiles();
+  auto it = std::find_if(
+    profiles.begin(), profiles.end(),
+    [&](const romea::core::LockProfile & profile) {return profile.name == name;});
+  EXPECT_NE(it, profiles.end());
+  return it != profiles.end() ? *it : romea::core::LockProfile{};
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestLockProfiler, checkNothingIsRecordedWhenDisabled)
+{
+  romea::core::LockProfiler::enable(false);
+  romea::core::LockProfiler::reset();
+  romea::core::ProfiledMutex mutex("test_disabled");
+  {
+    std::lock_guard<romea::core::ProfiledMutex> lock(mutex);
+  }
+  EXPECT_EQ(findProfile("test_disabled").numberOfLocks, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLockProfiler, checkLocksAndHoldTimesAreRecorded)
+{
+  romea::core::LockProfiler::enable(true);
+  romea::core::LockProfiler::reset();
+  romea::core::ProfiledMutex mutex("test_hold");
+  for (size_t n = 0; n < 3; ++n) {
+    std::lock_guard<romea::core::ProfiledMutex> lock(mutex);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+
+  auto profile = findProfile("test_hold");
+  EXPECT_EQ(profile.numberOfLocks, 3u);
+  EXPECT_EQ(profile.numberOfContentions, 0u);
+  EXPECT_GE(profile.maximalHoldTime, std::chrono::milliseconds(2));
+  EXPECT_GE(profile.totalHoldTime, std::chrono::milliseconds(6));
+  romea::core::LockProfiler::enable(false);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLockProfiler, checkContentionIsRecorded)
+{
+  romea::core::LockProfiler::enable(true);
+  romea::core::LockProfiler::reset();
+  romea::core::ProfiledMutex mutex("test_contention");
+
+  std::unique_lock<romea::core::ProfiledMutex> lock(mutex);
+  std::thread thread([&]() {std::lock_guard<romea::core::ProfiledMutex> other(mutex);});
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  lock.unlock();
+  thread.join();
+
+  auto profile = findProfile("test_contention");
+  EXPECT_EQ(profile.numberOfLocks, 2u);
+  EXPECT_EQ(profile.numberOfContentions, 1u);
+  EXPECT_GE(profile.maximalWaitTime, std::chrono::milliseconds(10));
+  romea::core::LockProfiler::enable(false);
+}
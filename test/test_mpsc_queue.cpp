@@ -0,0 +1,89 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_gps/MPSCQueue.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestMPSCQueue, checkCapacityIsRoundedUpToPowerOfTwo)
+{
+  romea::core::MPSCQueue<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMPSCQueue, checkFullQueueRejectsElements)
+{
+  romea::core::MPSCQueue<int> queue(2);
+  EXPECT_TRUE(queue.tryPush(1));
+  EXPECT_TRUE(queue.tryPush(2));
+  EXPECT_FALSE(queue.tryPush(3));
+  EXPECT_EQ(queue.size(), 2u);
+
+  int value;
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.tryPush(3));
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(queue.tryPop(value));
+  EXPECT_EQ(queue.size(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMPSCQueue, checkElementsOfEachProducerAreReceivedInOrder)
+{
+  const int number_of_producers = 4;
+  const int number_of_elements = 50000;
+  romea::core::MPSCQueue<int> queue(16);
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < number_of_producers; ++producer) {
+    producers.emplace_back([&queue, producer] {
+        for (int n = 0; n < number_of_elements; ++n) {
+          while (!queue.tryPush(producer * number_of_elements + n)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  std::vector<int> expected(number_of_producers, 0);
+  int number_of_received_elements = 0;
+  int value;
+  while (number_of_received_elements != number_of_producers * number_of_elements) {
+    if (queue.tryPop(value)) {
+      int producer = value / number_of_elements;
+      ASSERT_EQ(value % number_of_elements, expected[producer]++);
+      ++number_of_received_elements;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(expected, std::vector<int>(number_of_producers, number_of_elements));
+}
@@ -0,0 +1,227 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+
+// romea
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/NMEACorpusGenerator.hpp"
+#include "romea_core_localisation_gps/NMEAFieldScanner.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+romea::core::NMEACorpusOptions cleanOptions(const double & duration)
+{
+  romea::core::NMEACorpusOptions options;
+  options.seed = 7;
+  options.rtkDropoutRate = 0.;
+  options.multipathProbability = 0.;
+  options.hdopSpikeProbability = 0.;
+  options.gsvBurstProbability = 0.;
+  options.corruptChecksumProbability = 0.;
+  options.truncationProbability = 0.;
+  options.duration = romea::core::durationFromSecond(duration);
+  return options;
+}
+
+//-----------------------------------------------------------------------------
+std::string sentenceId(const std::string & sentence)
+{
+  return sentence.substr(3, 3);
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEACorpusGenerator, checkSameSeedGivesSameCorpus)
+{
+  romea::core::NMEACorpusOptions options;
+  options.duration = romea::core::durationFromSecond(20.);
+  romea::core::NMEACorpusGenerator generator1(options);
+  romea::core::NMEACorpusGenerator generator2(options);
+  options.seed = 1;
+  romea::core::NMEACorpusGenerator generator3(options);
+
+  romea::core::NMEACorpusRecord record1, record2, record3;
+  size_t numberOfDifferences = 0;
+  while (generator1.next(record1)) {
+    ASSERT_TRUE(generator2.next(record2));
+    ASSERT_TRUE(generator3.next(record3));
+    EXPECT_EQ(record1.stamp, record2.stamp);
+    EXPECT_EQ(record1.sentence, record2.sentence);
+    EXPECT_EQ(record1.fault, record2.fault);
+    EXPECT_EQ(record1.truth.position, record2.truth.position);
+    numberOfDifferences += record1.sentence != record3.sentence;
+  }
+  EXPECT_FALSE(generator2.next(record2));
+  EXPECT_GT(numberOfDifferences, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEACorpusGenerator, checkSentenceRates)
+{
+  romea::core::NMEACorpusGenerator generator(cleanOptions(10.));
+
+  std::map<std::string, size_t> numberOfSentences;
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    EXPECT_TRUE(romea::core::NMEAFieldScanner(record.sentence).isValid());
+    EXPECT_EQ(record.fault, romea::core::NMEAFault::NONE);
+    EXPECT_LT(record.stamp, romea::core::durationFromSecond(10.));
+    numberOfSentences[sentenceId(record.sentence)]++;
+  }
+
+  EXPECT_EQ(numberOfSentences["GGA"], 100u);
+  EXPECT_EQ(numberOfSentences["RMC"], 100u);
+  EXPECT_EQ(numberOfSentences["HDT"], 100u);
+  EXPECT_EQ(numberOfSentences["GSV"], 30u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEACorpusGenerator, checkSentencesMatchGroundTruth)
+{
+  romea::core::NMEACorpusGenerator generator(cleanOptions(60.));
+  const auto & enuConverter = generator.getENUConverter();
+
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    std::string id = sentenceId(record.sentence);
+    if (id == "GGA") {
+      romea::core::GGAFrame frame;
+      ASSERT_TRUE(romea::core::scanGGAFrame(record.sentence, frame));
+      EXPECT_EQ(*frame.fixQuality, romea::core::FixQuality::RTK_FIX);
+      Eigen::Vector3d position = enuConverter.toENU(
+        romea::core::makeGeodeticCoordinates(
+          frame.latitude->toDouble(), frame.longitude->toDouble(), 0.));
+      EXPECT_NEAR(position.x(), record.truth.position.x(), 0.06);
+      EXPECT_NEAR(position.y(), record.truth.position.y(), 0.06);
+    } else if (id == "RMC") {
+      romea::core::RMCFrame frame;
+      ASSERT_TRUE(romea::core::scanRMCFrame(record.sentence, frame));
+      EXPECT_NEAR(*frame.speedOverGroundInMeterPerSecond, record.truth.linearSpeed, 0.1);
+    } else if (id == "HDT") {
+      romea::core::HDTFrame frame;
+      ASSERT_TRUE(romea::core::scanHDTFrame(record.sentence, frame));
+      EXPECT_NEAR(
+        std::remainder(romea::core::headingToCourseAngle(*frame.heading) - record.truth.course,
+        2 * M_PI), 0., 0.03);
+    }
+  }
+
+  // the vehicle has moved away from the anchor
+  EXPECT_GT(record.truth.position.norm(), 10.);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEACorpusGenerator, checkFaultsAreInjected)
+{
+  romea::core::NMEACorpusOptions options;
+  options.rtkDropoutRate = 0.05;
+  options.multipathProbability = 0.05;
+  options.hdopSpikeProbability = 0.05;
+  options.gsvBurstProbability = 0.2;
+  options.corruptChecksumProbability = 0.02;
+  options.truncationProbability = 0.02;
+  options.duration = romea::core::durationFromSecond(300.);
+  romea::core::NMEACorpusGenerator generator(options);
+
+  std::map<romea::core::NMEAFault, size_t> numberOfFaults;
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    numberOfFaults[record.fault]++;
+
+    romea::core::NMEAFieldScanner scanner(record.sentence);
+    romea::core::GGAFrame frame;
+    switch (record.fault) {
+      case romea::core::NMEAFault::CORRUPT_CHECKSUM:
+        EXPECT_FALSE(scanner.isValid());
+        break;
+      case romea::core::NMEAFault::TRUNCATED:
+        EXPECT_EQ(record.sentence.find("\r\n"), std::string::npos);
+        break;
+      case romea::core::NMEAFault::RTK_DROPOUT:
+        ASSERT_TRUE(romea::core::scanGGAFrame(record.sentence, frame));
+        EXPECT_EQ(*frame.fixQuality, romea::core::FixQuality::FLOAT_RTK_FIX);
+        break;
+      case romea::core::NMEAFault::HDOP_SPIKE:
+        ASSERT_TRUE(romea::core::scanGGAFrame(record.sentence, frame));
+        EXPECT_GT(*frame.horizontalDilutionOfPrecision, 5.);
+        break;
+      case romea::core::NMEAFault::GSV_BURST:
+        EXPECT_EQ(sentenceId(record.sentence), "GSV");
+        break;
+      default:
+        EXPECT_TRUE(scanner.isValid());
+        break;
+    }
+  }
+
+  for (auto fault : {
+      romea::core::NMEAFault::RTK_DROPOUT,
+      romea::core::NMEAFault::MULTIPATH,
+      romea::core::NMEAFault::HDOP_SPIKE,
+      romea::core::NMEAFault::GSV_BURST,
+      romea::core::NMEAFault::CORRUPT_CHECKSUM,
+      romea::core::NMEAFault::TRUNCATED})
+  {
+    EXPECT_GT(numberOfFaults[fault], 0u) << toString(fault);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEACorpusGenerator, checkPluginFollowsGroundTruth)
+{
+  romea::core::NMEACorpusOptions options = cleanOptions(60.);
+  options.multipathProbability = 0.01;
+  romea::core::NMEACorpusGenerator generator(options);
+
+  romea::core::LocalisationDualAntennaGPSPlugin plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setAnchor(generator.getENUConverter().getAnchor());
+
+  size_t numberOfFixes = 0;
+  size_t numberOfPositions = 0;
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+  romea::core::NMEACorpusRecord record;
+  while (generator.next(record)) {
+    std::string id = sentenceId(record.sentence);
+    if (id == "GGA") {
+      numberOfFixes++;
+      if (plugin.processGGA(record.stamp, record.sentence, position)) {
+        numberOfPositions++;
+        // multipath fixes are either gated or published with an inflated covariance
+        double tolerance = 5 * std::sqrt(position.R()(0, 0)) + 0.05;
+        EXPECT_NEAR(position.Y(0), record.truth.position.x(), tolerance);
+        EXPECT_NEAR(position.Y(1), record.truth.position.y(), tolerance);
+      }
+    } else if (id == "HDT") {
+      plugin.processHDT(record.stamp, record.sentence, course);
+    } else {
+      plugin.processGSV(record.sentence);
+    }
+  }
+
+  EXPECT_GT(numberOfPositions, numberOfFixes * 9 / 10);
+}
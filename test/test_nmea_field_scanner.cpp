@@ -0,0 +1,189 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <string>
+#include <string_view>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/NMEAFieldScanner.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkFields)
+{
+  romea::core::NMEAFieldScanner scanner("$GPHDT,12.5,T*03\r\n");
+  ASSERT_TRUE(scanner.isValid());
+  EXPECT_EQ(scanner.getTalker(), "GP");
+  EXPECT_EQ(scanner.getSentenceId(), "HDT");
+
+  std::string_view field;
+  ASSERT_TRUE(scanner.next(field));
+  EXPECT_EQ(field, "12.5");
+  ASSERT_TRUE(scanner.next(field));
+  EXPECT_EQ(field, "T");
+  EXPECT_FALSE(scanner.next(field));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkEmptyFields)
+{
+  romea::core::NMEAFieldScanner scanner("$GPGGA,,1,,");
+  ASSERT_TRUE(scanner.isValid());
+
+  std::string_view field;
+  ASSERT_TRUE(scanner.next(field));
+  EXPECT_TRUE(field.empty());
+  EXPECT_TRUE(scanner.skip(1));
+  ASSERT_TRUE(scanner.next(field));
+  EXPECT_TRUE(field.empty());
+  ASSERT_TRUE(scanner.next(field));
+  EXPECT_TRUE(field.empty());
+  EXPECT_FALSE(scanner.skip(1));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkInvalidSentences)
+{
+  EXPECT_FALSE(romea::core::NMEAFieldScanner("").isValid());
+  EXPECT_FALSE(romea::core::NMEAFieldScanner("GPHDT,12.5,T").isValid());
+  EXPECT_FALSE(romea::core::NMEAFieldScanner("$GPHDT,12.5,T*04").isValid());
+  EXPECT_FALSE(romea::core::NMEAFieldScanner("$GPHDT,12.5,T*0").isValid());
+  EXPECT_FALSE(romea::core::NMEAFieldScanner("$GPHDT;12.5,T").isValid());
+  EXPECT_TRUE(romea::core::NMEAFieldScanner("$GPHDT,12.5,T").isValid());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkNumbers)
+{
+  EXPECT_DOUBLE_EQ(*romea::core::parseNMEANumber("4807.038"), 4807.038);
+  EXPECT_DOUBLE_EQ(*romea::core::parseNMEANumber("-12"), -12);
+  EXPECT_FALSE(romea::core::parseNMEANumber(""));
+  EXPECT_FALSE(romea::core::parseNMEANumber("12a"));
+  EXPECT_FALSE(romea::core::parseNMEANumber("M"));
+  EXPECT_FALSE(romea::core::parseNMEANumber("inf"));
+  EXPECT_FALSE(romea::core::parseNMEANumber("nan"));
+  EXPECT_FALSE(romea::core::parseNMEANumber("1e999"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkGGAFrameMatchesStringConstructor)
+{
+  std::string sentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::GGAFrame expected(sentence);
+
+  romea::core::GGAFrame frame;
+  EXPECT_TRUE(romea::core::scanGGAFrame(sentence, frame));
+  EXPECT_EQ(frame.talkerId, expected.talkerId);
+  EXPECT_NEAR((*frame.latitude).toDouble(), (*expected.latitude).toDouble(), 1e-12);
+  EXPECT_NEAR((*frame.longitude).toDouble(), (*expected.longitude).toDouble(), 1e-12);
+  EXPECT_EQ(*frame.fixQuality, *expected.fixQuality);
+  EXPECT_EQ(*frame.numberSatellitesUsedToComputeFix, *expected.numberSatellitesUsedToComputeFix);
+  EXPECT_DOUBLE_EQ(*frame.horizontalDilutionOfPrecision, *expected.horizontalDilutionOfPrecision);
+  EXPECT_DOUBLE_EQ(*frame.altitudeAboveGeoid, *expected.altitudeAboveGeoid);
+  EXPECT_DOUBLE_EQ(*frame.geoidHeight, *expected.geoidHeight);
+  EXPECT_DOUBLE_EQ(*frame.dgpsCorrectionAgeInSecond, *expected.dgpsCorrectionAgeInSecond);
+  EXPECT_EQ(*frame.dgpsStationIdNumber, *expected.dgpsStationIdNumber);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkIncompleteGGAFrame)
+{
+  romea::core::GGAFrame gga_frame = minimalGoodGGAFrame();
+  gga_frame.horizontalDilutionOfPrecision.reset();
+  gga_frame.latitude.reset();
+
+  romea::core::GGAFrame frame;
+  EXPECT_TRUE(romea::core::scanGGAFrame(gga_frame.toNMEA(), frame));
+  EXPECT_FALSE(frame.horizontalDilutionOfPrecision);
+  EXPECT_FALSE(frame.latitude);
+  EXPECT_TRUE(frame.longitude);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkOutOfRangeIntegers)
+{
+  romea::core::GGAFrame frame;
+  EXPECT_TRUE(
+    romea::core::scanGGAFrame(
+      "$GNGGA,120000.00,4500.0000,N,00130.0000,E,4,99999999999,1.2,53.3,M,400.8,M,2.5,-1",
+      frame));
+  EXPECT_FALSE(frame.numberSatellitesUsedToComputeFix);
+  EXPECT_FALSE(frame.dgpsStationIdNumber);
+  EXPECT_EQ(*frame.fixQuality, romea::core::FixQuality::RTK_FIX);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkRMCFrameMatchesStringConstructor)
+{
+  std::string sentence = minimalGoodRMCFrame().toNMEA();
+  romea::core::RMCFrame expected(sentence);
+
+  romea::core::RMCFrame frame;
+  EXPECT_TRUE(romea::core::scanRMCFrame(sentence, frame));
+  EXPECT_EQ(frame.talkerId, expected.talkerId);
+  EXPECT_DOUBLE_EQ(*frame.speedOverGroundInMeterPerSecond, *expected.speedOverGroundInMeterPerSecond);
+  EXPECT_DOUBLE_EQ(*frame.trackAngleTrue, *expected.trackAngleTrue);
+  EXPECT_DOUBLE_EQ(*frame.magneticDeviation, *expected.magneticDeviation);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkHDTFrameMatchesStringConstructor)
+{
+  std::string sentence = minimalGoodHDTFrame().toNMEA();
+  romea::core::HDTFrame expected(sentence);
+
+  romea::core::HDTFrame frame;
+  EXPECT_TRUE(romea::core::scanHDTFrame(sentence, frame));
+  EXPECT_EQ(frame.talkerId, expected.talkerId);
+  EXPECT_DOUBLE_EQ(*frame.heading, *expected.heading);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkGSTFrame)
+{
+  romea::core::GSTFrame frame;
+  EXPECT_TRUE(
+    romea::core::scanGSTFrame("$GNGST,120000.00,1.8,0.03,0.02,90.0,0.021,0.029,0.05", frame));
+  EXPECT_EQ(frame.talkerId, romea::core::TalkerId::GN);
+  EXPECT_DOUBLE_EQ(*frame.rangeRMS, 1.8);
+  EXPECT_DOUBLE_EQ(*frame.semiMajorAxisStd, 0.03);
+  EXPECT_DOUBLE_EQ(*frame.semiMinorAxisStd, 0.02);
+  EXPECT_DOUBLE_EQ(*frame.semiMajorAxisOrientation, M_PI / 2.);
+  EXPECT_DOUBLE_EQ(*frame.latitudeStd, 0.021);
+  EXPECT_DOUBLE_EQ(*frame.longitudeStd, 0.029);
+  EXPECT_DOUBLE_EQ(*frame.altitudeStd, 0.05);
+
+  EXPECT_TRUE(romea::core::scanGSTFrame("$GPGST,120000.00,1.8,,,,0.021,0.029,0.05", frame));
+  EXPECT_FALSE(frame.semiMajorAxisStd);
+  EXPECT_FALSE(frame.semiMajorAxisOrientation);
+  EXPECT_DOUBLE_EQ(*frame.latitudeStd, 0.021);
+
+  EXPECT_FALSE(romea::core::scanGSTFrame("$GPGST,120000.00,1.8,0.03,0.02", frame));
+  EXPECT_FALSE(frame.rangeRMS);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEAFieldScanner, checkFramesOfAnotherTypeAreLeftEmpty)
+{
+  romea::core::HDTFrame frame;
+  frame.heading = 1.0;
+  EXPECT_FALSE(romea::core::scanHDTFrame(minimalGoodRMCFrame().toNMEA(), frame));
+  EXPECT_FALSE(frame.heading);
+  EXPECT_EQ(frame.talkerId, romea::core::TalkerId::UNSUPPORTED);
+}
@@ -0,0 +1,87 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <string>
+
+// romea
+#include "romea_core_localisation_gps/NMEASentenceClassifier.hpp"
+#include "romea_core_localisation_gps/NMEASentenceCounters.hpp"
+
+using romea::core::NMEASentenceType;
+using romea::core::classifyNMEASentence;
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEASentenceClassifier, checkSupportedSentenceTypes)
+{
+  EXPECT_EQ(classifyNMEASentence("$GNGGA,120000.00,4530.0000,N*00"), NMEASentenceType::GGA);
+  EXPECT_EQ(classifyNMEASentence("$GPRMC,120000.00,A*00"), NMEASentenceType::RMC);
+  EXPECT_EQ(classifyNMEASentence("$GNHDT,21.6,T*00"), NMEASentenceType::HDT);
+  EXPECT_EQ(classifyNMEASentence("$GLGSV,3,1,11*00"), NMEASentenceType::GSV);
+  EXPECT_EQ(classifyNMEASentence("$GNGSA,A,3*00"), NMEASentenceType::GSA);
+  EXPECT_EQ(classifyNMEASentence("$GPVTG,054.7,T*00"), NMEASentenceType::VTG);
+  EXPECT_EQ(classifyNMEASentence("$GPZDA,120000.00,19,10,2026*00"), NMEASentenceType::ZDA);
+  EXPECT_EQ(classifyNMEASentence("$GNGST,120000.00,1.2*00"), NMEASentenceType::GST);
+  EXPECT_EQ(classifyNMEASentence("$GNGGA"), NMEASentenceType::GGA);
+  EXPECT_EQ(classifyNMEASentence("$GNGGA*00"), NMEASentenceType::GGA);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEASentenceClassifier, checkOtherSentenceTypes)
+{
+  EXPECT_EQ(classifyNMEASentence("$PUBX,00,120000.00*00"), NMEASentenceType::PROPRIETARY);
+  EXPECT_EQ(classifyNMEASentence("$PTNL,GGK,120000.00*00"), NMEASentenceType::PROPRIETARY);
+  EXPECT_EQ(classifyNMEASentence("$GPGLL,4530.0000,N*00"), NMEASentenceType::UNSUPPORTED);
+  EXPECT_EQ(classifyNMEASentence("$GPGGB,120000.00*00"), NMEASentenceType::UNSUPPORTED);
+  EXPECT_EQ(classifyNMEASentence("$GPgga,120000.00*00"), NMEASentenceType::UNSUPPORTED);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEASentenceClassifier, checkMalformedSentences)
+{
+  EXPECT_EQ(classifyNMEASentence(""), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("$"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("$GPGG"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("GPGGA,120000.00"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("!AIVDM,1,1*00"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("$GPGGAX,120000.00"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("$gpGGA,120000.00"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence("$P,00"), NMEASentenceType::MALFORMED);
+  EXPECT_EQ(classifyNMEASentence(std::string("$G\0GGA,", 7)), NMEASentenceType::MALFORMED);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestNMEASentenceClassifier, checkCountersReport)
+{
+  romea::core::NMEASentenceCounters counters;
+  EXPECT_TRUE(counters.getReport().info.empty());
+
+  counters.count(NMEASentenceType::GGA);
+  counters.count(NMEASentenceType::GGA);
+  counters.count(NMEASentenceType::PROPRIETARY);
+  EXPECT_EQ(counters.getCount(NMEASentenceType::GGA), 2u);
+  EXPECT_EQ(counters.getCount(NMEASentenceType::RMC), 0u);
+
+  auto report = counters.getReport();
+  EXPECT_EQ(report.info.size(), 2u);
+  EXPECT_EQ(report.info["nmea_gga_sentences"], "2");
+  EXPECT_EQ(report.info["nmea_proprietary_sentences"], "1");
+
+  counters.reset();
+  EXPECT_EQ(counters.getCount(NMEASentenceType::GGA), 0u);
+}
@@ -0,0 +1,147 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/ObservationQueue.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationQueue, checkObservationsAreDrainedInBatches)
+{
+  romea::core::ObservationQueue queue(8);
+  romea::core::ObservationPosition positionObs;
+  positionObs.Y() << 1., 2.;
+  romea::core::ObservationCourse courseObs;
+  courseObs.Y() = 0.5;
+
+  EXPECT_TRUE(queue.publish(1, romea::core::Duration(10), positionObs));
+  EXPECT_TRUE(queue.publish(2, romea::core::Duration(20), courseObs));
+  EXPECT_TRUE(queue.publish(1, romea::core::Duration(30), positionObs));
+  EXPECT_EQ(queue.getDepth(), 3u);
+
+  std::vector<romea::core::QueuedObservation> observations;
+  auto handler = [&](const romea::core::QueuedObservation & observation) {
+      observations.push_back(observation);
+    };
+  EXPECT_EQ(queue.drain(handler, 2), 2u);
+  EXPECT_EQ(queue.getDepth(), 1u);
+  EXPECT_EQ(queue.drain(handler), 1u);
+  EXPECT_EQ(queue.drain(handler), 0u);
+
+  ASSERT_EQ(observations.size(), 3u);
+  EXPECT_EQ(observations[0].type, romea::core::QueuedObservationType::POSITION);
+  EXPECT_EQ(observations[0].sourceId, 1u);
+  EXPECT_EQ(observations[0].stamp, romea::core::Duration(10));
+  EXPECT_DOUBLE_EQ(observations[0].positionObs.Y(1), 2.);
+  EXPECT_EQ(observations[1].type, romea::core::QueuedObservationType::COURSE);
+  EXPECT_EQ(observations[1].sourceId, 2u);
+  EXPECT_DOUBLE_EQ(observations[1].courseObs.Y(), 0.5);
+  EXPECT_EQ(observations[2].stamp, romea::core::Duration(30));
+
+  EXPECT_EQ(queue.getNumberOfPublishedObservations(), 3u);
+  EXPECT_EQ(queue.getMaximalDepth(), 3u);
+  EXPECT_GE(queue.getMaximalLatency(), queue.getMeanLatency());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationQueue, checkDropsAreCountedAndReported)
+{
+  romea::core::ObservationQueue queue(2);
+  romea::core::ObservationCourse courseObs;
+  EXPECT_TRUE(queue.publish(0, romea::core::Duration(1), courseObs));
+  EXPECT_TRUE(queue.publish(0, romea::core::Duration(2), courseObs));
+  EXPECT_FALSE(queue.publish(0, romea::core::Duration(3), courseObs));
+  EXPECT_EQ(queue.getNumberOfDroppedObservations(), 1u);
+
+  auto report = queue.getReport();
+  ASSERT_EQ(report.diagnostics.size(), 1u);
+  EXPECT_EQ(report.diagnostics.front().status, romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(report.info["observation_queue_depth"], "2");
+  EXPECT_EQ(report.info["observation_queue_drops"], "1");
+
+  // drops are only warned about once
+  EXPECT_TRUE(queue.getReport().diagnostics.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationQueue, checkLatencyIsMeasured)
+{
+  romea::core::ObservationQueue queue;
+  romea::core::ObservationPosition positionObs;
+  queue.publish(0, romea::core::Duration(1), positionObs);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  queue.drain([](const romea::core::QueuedObservation &) {});
+
+  EXPECT_GE(queue.getMeanLatency(), std::chrono::milliseconds(2));
+  EXPECT_EQ(queue.getMeanLatency(), queue.getMaximalLatency());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationQueue, checkPluginsPublishIntoSharedQueue)
+{
+  auto queue = std::make_shared<romea::core::ObservationQueue>();
+  romea::core::LocalisationSingleAntennaGPSPlugin singleAntennaPlugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.);
+  romea::core::LocalisationDualAntennaGPSPlugin dualAntennaPlugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  singleAntennaPlugin.setObservationQueue(queue, 1);
+  dualAntennaPlugin.setObservationQueue(queue, 2);
+
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  std::string rmcSentence = minimalGoodRMCFrame().toNMEA();
+  std::string hdtSentence = minimalGoodHDTFrame().toNMEA();
+  romea::core::ObservationPosition positionObs;
+  romea::core::ObservationCourse courseObs;
+
+  size_t numberOfObservations[3] = {0, 0, 0};
+  size_t numberOfProducedObservations = 0;
+  for (size_t n = 0; n <= 20; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / 20.);
+    singleAntennaPlugin.processLinearSpeed(stamp, 2.);
+    numberOfProducedObservations +=
+      singleAntennaPlugin.processGGA(stamp, ggaSentence, positionObs) +
+      singleAntennaPlugin.processRMC(stamp, rmcSentence, courseObs) +
+      dualAntennaPlugin.processGGA(stamp, ggaSentence, positionObs) +
+      dualAntennaPlugin.processHDT(stamp, hdtSentence, courseObs);
+
+    queue->drain(
+      [&](const romea::core::QueuedObservation & observation) {
+        numberOfObservations[observation.sourceId]++;
+        if (observation.sourceId == 2 &&
+        observation.type == romea::core::QueuedObservationType::COURSE)
+        {
+          EXPECT_DOUBLE_EQ(observation.courseObs.Y(), courseObs.Y());
+        }
+      });
+  }
+
+  EXPECT_GT(numberOfProducedObservations, 0u);
+  EXPECT_EQ(numberOfObservations[0], 0u);
+  EXPECT_GT(numberOfObservations[1], 0u);
+  EXPECT_GT(numberOfObservations[2], 0u);
+  EXPECT_EQ(numberOfObservations[1] + numberOfObservations[2], numberOfProducedObservations);
+  EXPECT_EQ(queue->getNumberOfDroppedObservations(), 0u);
+}
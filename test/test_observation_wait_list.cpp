@@ -0,0 +1,120 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <vector>
+
+// romea
+#include "romea_core_localisation_gps/ObservationWaitList.hpp"
+
+namespace
+{
+
+using WaitList = romea::core::ObservationWaitList<double>;
+
+struct RecordingWaiter
+{
+  explicit RecordingWaiter(std::vector<double> & observations)
+  : waiter(),
+    resumedObservations(observations),
+    waitListToJoinAgain(nullptr)
+  {
+    waiter.resume = &record;
+    waiter.context = this;
+  }
+
+  RecordingWaiter(const RecordingWaiter &) = delete;
+  RecordingWaiter & operator=(const RecordingWaiter &) = delete;
+
+  static void record(WaitList::Waiter & waiter)
+  {
+    auto * recordingWaiter = static_cast<RecordingWaiter *>(waiter.context);
+    recordingWaiter->resumedObservations.push_back(waiter.observation);
+    if (recordingWaiter->waitListToJoinAgain != nullptr) {
+      recordingWaiter->waitListToJoinAgain->push(waiter);
+    }
+  }
+
+  WaitList::Waiter waiter;
+  std::vector<double> & resumedObservations;
+  WaitList * waitListToJoinAgain;
+};
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationWaitList, checkWaitersAreResumedOnceInOrder)
+{
+  WaitList waitList("test_order");
+  std::vector<double> first;
+  std::vector<double> second;
+  RecordingWaiter firstWaiter(first);
+  RecordingWaiter secondWaiter(second);
+
+  waitList.notify(romea::core::Duration(1), 1.);
+  waitList.push(firstWaiter.waiter);
+  waitList.push(secondWaiter.waiter);
+  EXPECT_FALSE(waitList.empty());
+
+  waitList.notify(romea::core::Duration(2), 2.);
+  waitList.notify(romea::core::Duration(3), 3.);
+  EXPECT_TRUE(waitList.empty());
+  EXPECT_EQ(first, std::vector<double>({2.}));
+  EXPECT_EQ(second, std::vector<double>({2.}));
+  EXPECT_EQ(firstWaiter.waiter.stamp, romea::core::Duration(2));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationWaitList, checkWaitersJoiningAgainWaitForNextObservation)
+{
+  WaitList waitList("test_join_again");
+  std::vector<double> observations;
+  RecordingWaiter waiter(observations);
+  waiter.waitListToJoinAgain = &waitList;
+
+  waitList.push(waiter.waiter);
+  for (size_t n = 0; n < 3; ++n) {
+    waitList.notify(romea::core::Duration(n), n);
+  }
+  EXPECT_EQ(observations, std::vector<double>({0., 1., 2.}));
+  EXPECT_TRUE(waitList.remove(waiter.waiter));
+  EXPECT_TRUE(waitList.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationWaitList, checkRemovedWaitersAreNotResumed)
+{
+  WaitList waitList("test_remove");
+  std::vector<double> observations;
+  RecordingWaiter first(observations);
+  RecordingWaiter second(observations);
+  RecordingWaiter third(observations);
+
+  waitList.push(first.waiter);
+  waitList.push(second.waiter);
+  waitList.push(third.waiter);
+  EXPECT_TRUE(waitList.remove(third.waiter));
+  EXPECT_TRUE(waitList.remove(first.waiter));
+  EXPECT_FALSE(waitList.remove(first.waiter));
+
+  // the tail has been removed, pushing must still link after second
+  waitList.push(first.waiter);
+  waitList.notify(romea::core::Duration(1), 1.);
+  EXPECT_EQ(observations, std::vector<double>({1., 1.}));
+  EXPECT_TRUE(waitList.empty());
+}
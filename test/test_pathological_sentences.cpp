@@ -0,0 +1,155 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+
+// romea
+#include "romea_core_localisation_gps/RealtimeLocalisationGPSPlugin.hpp"
+
+namespace
+{
+
+// loose enough for sanitizer builds, a linear parser is 100 times faster
+const double MINIMAL_BYTES_PER_SECOND = 10e6;
+
+const size_t SMALL_SIZE = 4096;
+const size_t LARGE_SIZE = 64 * SMALL_SIZE;
+
+using Process = std::function<void (const romea::core::Duration &, const std::string &)>;
+
+//-----------------------------------------------------------------------------
+std::string finishSentence(const std::string & body)
+{
+  unsigned char checksum = 0;
+  for (size_t n = 1; n < body.size(); ++n) {
+    checksum ^= static_cast<unsigned char>(body[n]);
+  }
+  char suffix[8];
+  std::snprintf(suffix, sizeof(suffix), "*%02X\r\n", checksum);
+  return body + suffix;
+}
+
+//-----------------------------------------------------------------------------
+// best time over a few runs, in seconds
+double measure(const Process & process, const std::string & sentence)
+{
+  double bestTime = std::numeric_limits<double>::infinity();
+  for (size_t run = 0; run < 5; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < 10; ++n) {
+      process(romea::core::durationFromSecond(0.1 * (10 * run + n)), sentence);
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    bestTime = std::min(bestTime, time.count() / 10);
+  }
+  return bestTime;
+}
+
+//-----------------------------------------------------------------------------
+// a quadratic parser would be 64 times slower per byte on the large sentence
+void checkThroughput(
+  const Process & process,
+  const std::function<std::string(size_t)> & makeSentence)
+{
+  std::string smallSentence = makeSentence(SMALL_SIZE);
+  std::string largeSentence = makeSentence(LARGE_SIZE);
+  double smallTime = measure(process, smallSentence);
+  double largeTime = measure(process, largeSentence);
+
+  EXPECT_GT(largeSentence.size() / largeTime, MINIMAL_BYTES_PER_SECOND);
+  EXPECT_LT(largeTime / smallTime, 4. * largeSentence.size() / smallSentence.size());
+}
+
+}  // namespace
+
+// sentences are parsed by the scanners of the realtime plugin, the regular
+// plugin relies on the frame constructors of romea_core_gps
+class TestPathologicalSentences : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    plugin = std::make_unique<romea::core::RealtimeLocalisationSingleAntennaGPSPlugin>(
+      std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 1.);
+  }
+
+  Process processGGA()
+  {
+    return [this](const romea::core::Duration & stamp, const std::string & sentence) {
+             plugin->processGGA(stamp, sentence, position);
+           };
+  }
+
+  Process processRMC()
+  {
+    return [this](const romea::core::Duration & stamp, const std::string & sentence) {
+             plugin->processRMC(stamp, sentence, course);
+           };
+  }
+
+  std::unique_ptr<romea::core::RealtimeLocalisationSingleAntennaGPSPlugin> plugin;
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathologicalSentences, checkLongNumbers)
+{
+  checkThroughput(
+    processGGA(), [](size_t size) {
+      return finishSentence(
+        "$GNGGA,120000.00,45" + std::string(size, '9') +
+        ",N,00130.0000,E,4,12,1.2," + std::string(size, '9') + ",M,400.8,M,2.5,1");
+    });
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathologicalSentences, checkManyCommas)
+{
+  auto makeSentence = [](const char * address) {
+      return [address](size_t size) {
+               return finishSentence(std::string("$") + address + std::string(size, ','));
+             };
+    };
+  checkThroughput(processGGA(), makeSentence("GNGGA"));
+  checkThroughput(processRMC(), makeSentence("GPRMC"));
+  checkThroughput(
+    [this](const romea::core::Duration &, const std::string & sentence) {
+      plugin->processGSV(sentence);
+    }, makeSentence("GPGSV"));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathologicalSentences, checkHugeNumbers)
+{
+  checkThroughput(
+    processRMC(), [](size_t size) {
+      std::string body = "$GPRMC";
+      while (body.size() < size) {
+        body += ",1e308,-1e-308";
+      }
+      return finishSentence(body);
+    });
+}
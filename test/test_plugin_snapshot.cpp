@@ -0,0 +1,222 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/PluginSnapshot.hpp"
+
+namespace
+{
+
+const char GSV_SENTENCE[] = "$GPGSV,1,1,01,05,40,083,46*4C";
+
+//-----------------------------------------------------------------------------
+romea::core::Duration seconds(const double & value)
+{
+  return romea::core::durationFromSecond(value);
+}
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<romea::core::LocalisationSingleAntennaGPSPlugin> makePlugin()
+{
+  return std::make_unique<romea::core::LocalisationSingleAntennaGPSPlugin>(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX, 0.8);
+}
+
+//-----------------------------------------------------------------------------
+// feeds one GGA sentence per second from the given stamp and returns the
+// time elapsed until the first position observation
+double timeToFirstPosition(
+  romea::core::LocalisationSingleAntennaGPSPlugin & plugin,
+  const double & start)
+{
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::ObservationPosition position;
+  for (size_t n = 0; n < 20; ++n) {
+    if (plugin.processGGA(seconds(start + n), ggaSentence, position)) {
+      return n;
+    }
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+}  // namespace
+
+class TestPluginSnapshot : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    anchor = romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1);
+    plugin = makePlugin();
+    plugin->setAnchor(anchor);
+
+    std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+    romea::core::ObservationPosition position;
+    for (size_t n = 0; n < 8; ++n) {
+      plugin->processLinearSpeed(seconds(n), 1.5);
+      plugin->processGGA(seconds(n), ggaSentence, position);
+      plugin->processGSV(GSV_SENTENCE);
+    }
+  }
+
+  romea::core::GeodeticCoordinates anchor;
+  std::unique_ptr<romea::core::LocalisationSingleAntennaGPSPlugin> plugin;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginSnapshot, checkEncodingRoundTrip)
+{
+  auto snapshot = plugin->makeSnapshot(seconds(7.5));
+  EXPECT_EQ(snapshot.ggaStamps.size(), 8u);
+  EXPECT_EQ(snapshot.linearSpeedStamps.size(), 8u);
+  EXPECT_TRUE(snapshot.rmcStamps.empty());
+  EXPECT_TRUE(snapshot.hdtStamps.empty());
+  // only the last GSV cycle is kept
+  EXPECT_EQ(snapshot.gsvSentences, std::vector<std::string>{GSV_SENTENCE});
+
+  auto buffer = romea::core::encode(snapshot);
+  auto decoded = romea::core::decodePluginSnapshot(buffer);
+  EXPECT_EQ(decoded.stamp, snapshot.stamp);
+  EXPECT_DOUBLE_EQ(decoded.anchor.getLatitude(), anchor.getLatitude());
+  EXPECT_DOUBLE_EQ(decoded.anchor.getLongitude(), anchor.getLongitude());
+  EXPECT_DOUBLE_EQ(decoded.anchor.getAltitude(), anchor.getAltitude());
+  EXPECT_EQ(decoded.ggaStamps, snapshot.ggaStamps);
+  EXPECT_EQ(decoded.lastGGAStamp, seconds(7.));
+  EXPECT_EQ(decoded.lastGGASentence, snapshot.lastGGASentence);
+  EXPECT_EQ(decoded.gsvSentences, snapshot.gsvSentences);
+  EXPECT_DOUBLE_EQ(decoded.linearSpeed, 1.5);
+  EXPECT_EQ(decoded.linearSpeedStamps, snapshot.linearSpeedStamps);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginSnapshot, checkDecodingRejectsInvalidBuffers)
+{
+  auto buffer = romea::core::encode(plugin->makeSnapshot(seconds(7.5)));
+
+  auto truncated = buffer;
+  truncated.pop_back();
+  EXPECT_THROW(romea::core::decodePluginSnapshot(truncated), std::runtime_error);
+
+  auto trailing = buffer;
+  trailing.push_back(0);
+  EXPECT_THROW(romea::core::decodePluginSnapshot(trailing), std::runtime_error);
+
+  auto version = buffer;
+  version[0] = 0xFF;
+  EXPECT_THROW(romea::core::decodePluginSnapshot(version), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginSnapshot, checkWarmStartTimeToFirstObservation)
+{
+  auto buffer = romea::core::encode(plugin->makeSnapshot(seconds(7.5)));
+
+  auto coldPlugin = makePlugin();
+  coldPlugin->setAnchor(anchor);
+  double coldTimeToFirstPosition = timeToFirstPosition(*coldPlugin, 9.);
+
+  auto warmPlugin = makePlugin();
+  EXPECT_TRUE(
+    warmPlugin->restoreSnapshot(romea::core::decodePluginSnapshot(buffer), seconds(8.5)));
+  double warmTimeToFirstPosition = timeToFirstPosition(*warmPlugin, 9.);
+
+  RecordProperty("cold_time_to_first_position", std::to_string(coldTimeToFirstPosition));
+  RecordProperty("warm_time_to_first_position", std::to_string(warmTimeToFirstPosition));
+  EXPECT_DOUBLE_EQ(coldTimeToFirstPosition, 4.);
+  EXPECT_DOUBLE_EQ(warmTimeToFirstPosition, 0.);
+
+  // the restored anchor gives the same positions
+  romea::core::ObservationPosition coldPosition;
+  romea::core::ObservationPosition warmPosition;
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  ASSERT_TRUE(coldPlugin->processGGA(seconds(30.), ggaSentence, coldPosition));
+  ASSERT_TRUE(warmPlugin->processGGA(seconds(30.), ggaSentence, warmPosition));
+  EXPECT_DOUBLE_EQ(coldPosition.Y(0), warmPosition.Y(0));
+  EXPECT_DOUBLE_EQ(coldPosition.Y(1), warmPosition.Y(1));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginSnapshot, checkWarmStartRestoresReports)
+{
+  auto warmPlugin = makePlugin();
+  // taken just after the last linear speed, whose 10 Hz heart beat is short
+  ASSERT_TRUE(warmPlugin->restoreSnapshot(plugin->makeSnapshot(seconds(7.05)), seconds(9.)));
+
+  auto report = warmPlugin->makeDiagnosticReport(seconds(9.));
+  ASSERT_EQ(report.diagnostics.size(), 4u);
+  auto diagnostic = report.diagnostics.begin();
+  EXPECT_EQ((diagnostic++)->status, romea::core::DiagnosticStatus::OK);  // linear speed rate
+  EXPECT_EQ((diagnostic++)->status, romea::core::DiagnosticStatus::OK);  // gga rate
+  EXPECT_EQ((diagnostic++)->status, romea::core::DiagnosticStatus::OK);  // gga fix
+  EXPECT_EQ(diagnostic->status, romea::core::DiagnosticStatus::ERROR);  // rmc rate
+
+  // restored positions std and linear speed give RMC courses once RMC rate is OK
+  auto rmcFrame = minimalGoodRMCFrame();
+  romea::core::ObservationCourse course;
+  bool isCourseValid = false;
+  for (size_t n = 0; n < 5; ++n) {
+    isCourseValid = warmPlugin->processRMC(seconds(9. + n * 0.1), rmcFrame, course);
+  }
+  EXPECT_TRUE(isCourseValid);
+  EXPECT_TRUE(std::isfinite(course.R()));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginSnapshot, checkWarmStartRestoresMultiConstellationGSVCycles)
+{
+  // GPS, GLONASS, Galileo and BeiDou cycles of 3 to 5 sentences
+  std::vector<std::string> gsvSentences;
+  for (const auto & [talker, total] : {std::pair<std::string, size_t>{"GP", 4},
+      {"GL", 3}, {"GA", 5}, {"GB", 3}})
+  {
+    for (size_t number = 1; number <= total; ++number) {
+      gsvSentences.push_back(
+        "$" + talker + "GSV," + std::to_string(total) + "," + std::to_string(number) +
+        ",12,05,40,083,46");
+      plugin->processGSV(gsvSentences.back());
+    }
+  }
+  auto snapshot = plugin->makeSnapshot(seconds(7.5));
+  EXPECT_EQ(snapshot.gsvSentences, gsvSentences);
+
+  auto warmPlugin = makePlugin();
+  ASSERT_TRUE(warmPlugin->restoreSnapshot(snapshot, seconds(8.5)));
+  EXPECT_EQ(warmPlugin->makeSnapshot(seconds(8.5)).gsvSentences, gsvSentences);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginSnapshot, checkStaleSnapshotOnlyRestoresAnchor)
+{
+  auto warmPlugin = makePlugin();
+  EXPECT_FALSE(warmPlugin->restoreSnapshot(plugin->makeSnapshot(seconds(7.5)), seconds(30.)));
+
+  const auto & restoredAnchor = warmPlugin->getENUConverter().getAnchor();
+  EXPECT_DOUBLE_EQ(restoredAnchor.getLatitude(), anchor.getLatitude());
+  EXPECT_DOUBLE_EQ(timeToFirstPosition(*warmPlugin, 31.), 4.);
+}
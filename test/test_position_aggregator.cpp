@@ -0,0 +1,211 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <memory>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/PositionAggregator.hpp"
+
+namespace
+{
+
+const double EARTH_RADIUS = 6378137.;
+
+//-----------------------------------------------------------------------------
+romea::core::Duration seconds(const double & value)
+{
+  return romea::core::durationFromSecond(value);
+}
+
+//-----------------------------------------------------------------------------
+romea::core::GGAFrame shiftedGGAFrame(const double & northOffset)
+{
+  auto frame = minimalGoodGGAFrame();
+  frame.latitude = romea::core::Latitude(0.7854 + northOffset / EARTH_RADIUS);
+  return frame;
+}
+
+//-----------------------------------------------------------------------------
+romea::core::ObservationPosition shiftedPosition(const double & northOffset)
+{
+  romea::core::ObservationPosition position;
+  position.Y() = Eigen::Vector2d(0., northOffset);
+  return position;
+}
+
+}  // namespace
+
+class TestPositionAggregator : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    enuConverter.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  }
+
+  romea::core::ENUConverter enuConverter;
+  romea::core::GPSReceiver gps;
+  romea::core::ObservationPosition position;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkDisabledByDefault)
+{
+  EXPECT_FALSE(romea::core::PositionAggregator().isEnabled());
+  EXPECT_TRUE(romea::core::PositionAggregator(5).isEnabled());
+  EXPECT_TRUE(romea::core::PositionAggregator(0, seconds(0.2)).isEnabled());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkAggregationOverNumberOfFixes)
+{
+  romea::core::PositionAggregator aggregator(4);
+  EXPECT_FALSE(aggregator.add(seconds(0.00), shiftedPosition(0.), 0.02));
+  EXPECT_FALSE(aggregator.add(seconds(0.05), shiftedPosition(1.), 0.02));
+  EXPECT_FALSE(aggregator.add(seconds(0.10), shiftedPosition(2.), 0.02));
+  EXPECT_TRUE(aggregator.add(seconds(0.15), shiftedPosition(3.), 0.02));
+
+  // the position is given at the last stamp and the fix variance is kept
+  double positionStd = aggregator.makePositionObservation(position);
+  EXPECT_NEAR(position.Y(romea::core::ObservationPosition::POSITION_X), 0., 1e-9);
+  EXPECT_NEAR(position.Y(romea::core::ObservationPosition::POSITION_Y), 3., 1e-9);
+  EXPECT_DOUBLE_EQ(positionStd, 0.02);
+  EXPECT_DOUBLE_EQ(position.R()(0, 0), 0.0004);
+  EXPECT_DOUBLE_EQ(position.R()(1, 1), 0.0004);
+  EXPECT_DOUBLE_EQ(position.R()(0, 1), 0.);
+  EXPECT_EQ(aggregator.getNumberOfAccumulatedFixes(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkFixesAreWeightedByInverseVariance)
+{
+  romea::core::PositionAggregator aggregator(2);
+  EXPECT_FALSE(aggregator.add(seconds(0.1), shiftedPosition(0.), 0.01));
+  EXPECT_TRUE(aggregator.add(seconds(0.1), shiftedPosition(5.), 0.02));
+
+  double positionStd = aggregator.makePositionObservation(position);
+  EXPECT_NEAR(position.Y(romea::core::ObservationPosition::POSITION_Y), 1., 1e-9);
+  EXPECT_DOUBLE_EQ(positionStd, std::sqrt(2. / (1. / 0.0001 + 1. / 0.0004)));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkStationaryNoiseIsAveraged)
+{
+  romea::core::PositionAggregator aggregator(0, seconds(0.4));
+  for (size_t n = 0; n < 9; ++n) {
+    aggregator.add(seconds(n * 0.05), shiftedPosition(n % 2 ? 0.01 : -0.01), 0.02);
+  }
+
+  aggregator.makePositionObservation(position);
+  EXPECT_LT(std::abs(position.Y(romea::core::ObservationPosition::POSITION_Y)), 0.01);
+  EXPECT_DOUBLE_EQ(position.R()(0, 0), 0.0004);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkAveragingOverWindow)
+{
+  romea::core::PositionAggregator aggregator(0, seconds(0.2));
+  for (size_t n = 0; n < 4; ++n) {
+    EXPECT_FALSE(aggregator.add(seconds(n * 0.05), shiftedPosition(0.), 0.02));
+  }
+  EXPECT_TRUE(aggregator.add(seconds(0.2), shiftedPosition(0.), 0.02));
+  EXPECT_EQ(aggregator.getNumberOfAccumulatedFixes(), 5u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkRestartWhenStampsGoBackward)
+{
+  romea::core::PositionAggregator aggregator(3);
+  EXPECT_FALSE(aggregator.add(seconds(1.0), shiftedPosition(0.), 0.02));
+  EXPECT_FALSE(aggregator.add(seconds(1.1), shiftedPosition(0.), 0.02));
+  EXPECT_FALSE(aggregator.add(seconds(0.5), shiftedPosition(0.), 0.02));
+  EXPECT_EQ(aggregator.getNumberOfAccumulatedFixes(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkPluginPublishesAveragedPositions)
+{
+  romea::core::LocalisationGPSPlugin<> plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  plugin.setPositionAggregation(5, romea::core::Duration::zero());
+
+  // the GGA rate checkup needs a few frames before validating fixes
+  auto frame = minimalGoodGGAFrame();
+  for (size_t n = 0; n < 4; ++n) {
+    EXPECT_FALSE(plugin.processGGA(seconds(n * 0.1), frame, position));
+  }
+
+  size_t numberOfPublishedPositions = 0;
+  for (size_t n = 4; n < 24; ++n) {
+    if (plugin.processGGA(seconds(n * 0.1), frame, position)) {
+      numberOfPublishedPositions++;
+      EXPECT_NEAR(position.R()(0, 0), 0.024 * 0.024, 1e-12);
+    }
+  }
+  EXPECT_EQ(numberOfPublishedPositions, 4u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkPluginAggregatedPositionsFollowMovingVehicle)
+{
+  romea::core::LocalisationGPSPlugin<> plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  plugin.setPositionAggregation(5, romea::core::Duration::zero());
+
+  // 2 m/s northward at 10 Hz with a fix noise of the order of the fix std,
+  // an aggregated position stamped with the last fix but lying in the middle
+  // of the window would be 0.4 m behind
+  size_t numberOfPublishedPositions = 0;
+  for (size_t n = 0; n < 44; ++n) {
+    double northOffset = 0.2 * n + (n % 2 ? 0.02 : -0.02);
+    if (plugin.processGGA(seconds(n * 0.1), shiftedGGAFrame(northOffset), position)) {
+      numberOfPublishedPositions++;
+      double bias = position.Y(romea::core::ObservationPosition::POSITION_Y) - 0.2 * n;
+      EXPECT_LT(std::abs(bias), 3 * std::sqrt(position.R()(1, 1)));
+    }
+  }
+  EXPECT_EQ(numberOfPublishedPositions, 8u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPositionAggregator, checkPluginGatesFixesBeforeAggregation)
+{
+  romea::core::LocalisationGPSPlugin<> plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  plugin.setPositionAggregation(5, romea::core::Duration::zero());
+
+  // a 20 m outlier is dropped by the jump gate instead of dragging the
+  // aggregated position
+  size_t numberOfPublishedPositions = 0;
+  for (size_t n = 0; n < 24; ++n) {
+    double northOffset = n == 16 ? 20. : 0.;
+    if (plugin.processGGA(seconds(n * 0.1), shiftedGGAFrame(northOffset), position)) {
+      numberOfPublishedPositions++;
+      EXPECT_NEAR(position.Y(romea::core::ObservationPosition::POSITION_Y), 0., 1e-6);
+    }
+  }
+  EXPECT_EQ(numberOfPublishedPositions, 3u);
+}
@@ -0,0 +1,177 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <limits>
+
+// romea
+#include "romea_core_localisation_gps/PositionJumpGate.hpp"
+
+namespace
+{
+
+using Decision = romea::core::PositionJumpGate::Decision;
+
+//-----------------------------------------------------------------------------
+romea::core::ObservationPosition makePosition(
+  const double & x,
+  const double & y,
+  const double & std = 0.02)
+{
+  romea::core::ObservationPosition positionObs;
+  positionObs.Y(romea::core::ObservationPosition::POSITION_X) = x;
+  positionObs.Y(romea::core::ObservationPosition::POSITION_Y) = y;
+  positionObs.R() = Eigen::Matrix2d::Identity() * std * std;
+  return positionObs;
+}
+
+//-----------------------------------------------------------------------------
+Decision evaluate(
+  romea::core::PositionJumpGate & gate,
+  const double & stamp,
+  const double & x,
+  const double & linearSpeed = std::numeric_limits<double>::quiet_NaN())
+{
+  auto positionObs = makePosition(x, 0);
+  return gate.evaluate(romea::core::durationFromSecond(stamp), linearSpeed, positionObs);
+}
+
+//-----------------------------------------------------------------------------
+void drive(
+  romea::core::PositionJumpGate & gate,
+  const double & speed,
+  const double & linearSpeed = std::numeric_limits<double>::quiet_NaN())
+{
+  for (size_t n = 0; n < 10; ++n) {
+    EXPECT_EQ(evaluate(gate, n, speed * n, linearSpeed), Decision::ACCEPTED);
+  }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkConsistentPositionsAreAccepted)
+{
+  romea::core::PositionJumpGate gate;
+  drive(gate, 1., 1.);
+
+  auto report = gate.getReport();
+  EXPECT_TRUE(report.diagnostics.empty());
+  EXPECT_EQ(report.info.at("position_jumps_rejected"), "0");
+  EXPECT_EQ(report.info.at("position_jumps_inflated"), "0");
+  EXPECT_EQ(report.info.count("position_jump_excess"), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkJumpIsRejected)
+{
+  romea::core::PositionJumpGate gate;
+  drive(gate, 1., 1.);
+  EXPECT_EQ(evaluate(gate, 10., 15., 1.), Decision::REJECTED);
+  EXPECT_EQ(gate.getNumberOfRejections(), 1u);
+
+  auto report = gate.getReport();
+  ASSERT_EQ(report.diagnostics.size(), 1u);
+  EXPECT_EQ(report.diagnostics.front().status, romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(report.diagnostics.front().message, "GGA position jump rejected.");
+  EXPECT_EQ(report.info.at("position_jumps_rejected"), "1");
+  EXPECT_EQ(report.info.count("position_jump_excess"), 1u);
+
+  // the rejected fix is not used as reference
+  EXPECT_EQ(evaluate(gate, 11., 11., 1.), Decision::ACCEPTED);
+  EXPECT_TRUE(gate.getReport().diagnostics.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkSmallExcessInflatesCovariance)
+{
+  romea::core::PositionJumpGate gate;
+  drive(gate, 1., 1.);
+
+  // predicted displacement is 1 m + 2 m/s^2 * 1 s^2 / 2 = 2 m
+  auto positionObs = makePosition(9. + 2.2, 0);
+  EXPECT_EQ(
+    gate.evaluate(romea::core::durationFromSecond(10.), 1., positionObs),
+    Decision::INFLATED);
+  EXPECT_EQ(gate.getNumberOfInflations(), 1u);
+
+  // the excess is brought back to the gate threshold
+  double excess = 0.2 / std::hypot(0.02, 0.02);
+  EXPECT_NEAR(positionObs.R()(0, 0), 0.02 * 0.02 * (excess / 3.) * (excess / 3.), 1e-12);
+  EXPECT_DOUBLE_EQ(positionObs.R()(0, 1), 0.);
+  EXPECT_EQ(
+    gate.getReport().diagnostics.front().message,
+    "GGA position covariance inflated after a jump.");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkWindowSpeedIsUsedWithoutOdometry)
+{
+  romea::core::PositionJumpGate gate;
+  drive(gate, 3.);
+
+  EXPECT_EQ(evaluate(gate, 10., 30.), Decision::ACCEPTED);
+  EXPECT_EQ(evaluate(gate, 11., 45.), Decision::REJECTED);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkFirstPositionIsAccepted)
+{
+  romea::core::PositionJumpGate gate;
+  EXPECT_EQ(evaluate(gate, 0., 100.), Decision::ACCEPTED);
+  // no speed can be estimated from a single position
+  EXPECT_EQ(evaluate(gate, 1., 200.), Decision::ACCEPTED);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkPersistentJumpIsFollowed)
+{
+  romea::core::PositionJumpGate gate(2., 3., 10., romea::core::durationFromSecond(10.), 3);
+  drive(gate, 0., 0.);
+
+  EXPECT_EQ(evaluate(gate, 10., 20., 0.), Decision::REJECTED);
+  EXPECT_EQ(evaluate(gate, 11., 20., 0.), Decision::REJECTED);
+  EXPECT_EQ(evaluate(gate, 12., 20., 0.), Decision::REJECTED);
+  EXPECT_EQ(evaluate(gate, 13., 20., 0.), Decision::ACCEPTED);
+  EXPECT_EQ(evaluate(gate, 14., 20., 0.), Decision::ACCEPTED);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkGateRestartsAfterGap)
+{
+  romea::core::PositionJumpGate gate;
+  drive(gate, 0., 0.);
+  EXPECT_EQ(evaluate(gate, 15., 20., 0.), Decision::ACCEPTED);
+  EXPECT_EQ(evaluate(gate, 16., 40., 0.), Decision::REJECTED);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPositionJumpGate, checkResetForgetsAcceptedPositions)
+{
+  romea::core::PositionJumpGate gate;
+  drive(gate, 0., 0.);
+  EXPECT_EQ(evaluate(gate, 10., 40., 0.), Decision::REJECTED);
+
+  gate.reset();
+  EXPECT_TRUE(gate.getReport().diagnostics.empty());
+  EXPECT_EQ(gate.getNumberOfRejections(), 1u);
+  EXPECT_EQ(evaluate(gate, 11., 40., 0.), Decision::ACCEPTED);
+  EXPECT_EQ(evaluate(gate, 12., 40., 0.), Decision::ACCEPTED);
+}
@@ -0,0 +1,226 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <algorithm>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/ProcessingTracer.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+std::vector<romea::core::TraceEvent> findEvents(const std::string & name)
+{
+  std::vector<romea::core::TraceEvent> events;
+  for (const auto & event : romea::core::ProcessingTracer::getEvents()) {
+    if (name == event.name) {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+}  // namespace
+
+class TestProcessingTracer : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    romea::core::ProcessingTracer::reset();
+    romea::core::ProcessingTracer::enable(true);
+  }
+
+  void TearDown() override
+  {
+    romea::core::ProcessingTracer::enable(false);
+    romea::core::ProcessingTracer::reset();
+  }
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkNothingIsRecordedWhenDisabled)
+{
+  romea::core::ProcessingTracer::enable(false);
+  {
+    romea::core::TraceScope trace("disabled", romea::core::Duration(1));
+  }
+  EXPECT_TRUE(romea::core::ProcessingTracer::getEvents().empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkScopeIsRecorded)
+{
+  {
+    romea::core::TraceScope trace("scope", romea::core::durationFromSecond(2.5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    trace.setOutcome(false);
+  }
+
+  auto events = findEvents("scope");
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].stamp, romea::core::durationFromSecond(2.5));
+  EXPECT_EQ(events[0].outcome, romea::core::TraceOutcome::NO_OBSERVATION);
+  EXPECT_GE(events[0].endTime - events[0].beginTime, std::chrono::milliseconds(1));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkEventsAreDroppedWhenBufferIsFull)
+{
+  romea::core::ProcessingTracer::setBufferCapacity(4);
+  std::thread thread([]() {
+      for (int64_t n = 0; n < 10; ++n) {
+        romea::core::TraceScope trace("full", romea::core::Duration(n));
+      }
+    });
+  thread.join();
+  romea::core::ProcessingTracer::setBufferCapacity(
+    romea::core::ProcessingTracer::DEFAULT_BUFFER_CAPACITY);
+
+  auto events = findEvents("full");
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events.back().stamp, romea::core::Duration(3));
+  EXPECT_EQ(romea::core::ProcessingTracer::getNumberOfDroppedEvents(), 6u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkThreadsHaveTheirOwnBuffer)
+{
+  auto feed = [](const std::string & name) {
+      romea::core::ProcessingTracer::setThreadName(name);
+      for (int64_t n = 0; n < 1000; ++n) {
+        romea::core::TraceScope trace("thread", romea::core::Duration(n));
+      }
+    };
+  std::thread serial(feed, "serial");
+  std::thread odometry(feed, "odometry");
+  serial.join();
+  odometry.join();
+
+  auto events = findEvents("thread");
+  ASSERT_EQ(events.size(), 2000u);
+  auto numberOfSerialEvents = std::count_if(
+    events.begin(), events.end(),
+    [&](const romea::core::TraceEvent & event) {
+      return event.threadIndex == events.front().threadIndex;
+    });
+  EXPECT_EQ(numberOfSerialEvents, 1000);
+
+  std::ostringstream os;
+  romea::core::ProcessingTracer::writeChromeTrace(os);
+  EXPECT_NE(os.str().find("\"args\":{\"name\":\"serial\"}"), std::string::npos);
+  EXPECT_NE(os.str().find("\"args\":{\"name\":\"odometry\"}"), std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkBuffersOfExitedThreadsAreFreedByReset)
+{
+  std::thread thread([]() {
+      romea::core::ProcessingTracer::setThreadName("exited");
+      romea::core::TraceScope trace("exited", romea::core::Duration(0));
+    });
+  thread.join();
+
+  // events of an exited thread are kept until the next reset
+  EXPECT_EQ(findEvents("exited").size(), 1u);
+  std::ostringstream os;
+  romea::core::ProcessingTracer::writeChromeTrace(os);
+  EXPECT_NE(os.str().find("\"args\":{\"name\":\"exited\"}"), std::string::npos);
+
+  romea::core::ProcessingTracer::setThreadName("alive");
+  romea::core::ProcessingTracer::reset();
+  os.str("");
+  romea::core::ProcessingTracer::writeChromeTrace(os);
+  EXPECT_EQ(os.str().find("\"args\":{\"name\":\"exited\"}"), std::string::npos);
+  EXPECT_NE(os.str().find("\"args\":{\"name\":\"alive\"}"), std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkPluginProcessingIsTraced)
+{
+  auto gps = std::make_unique<romea::core::GPSReceiver>();
+  romea::core::LocalisationSingleAntennaGPSPlugin plugin(
+    std::move(gps), romea::core::FixQuality::RTK_FIX, 1.);
+
+  romea::core::ObservationPosition positionObs;
+  romea::core::ObservationCourse courseObs;
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  std::string rmcSentence = minimalGoodRMCFrame().toNMEA();
+  for (size_t n = 0; n < 20; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / 10.);
+    plugin.processGGA(stamp, ggaSentence, positionObs);
+    plugin.processRMC(stamp, rmcSentence, courseObs);
+  }
+  plugin.makeDiagnosticReport(romea::core::durationFromSecond(2.));
+
+  EXPECT_EQ(findEvents("parseGGA").size(), 20u);
+  EXPECT_EQ(findEvents("parseRMC").size(), 20u);
+  EXPECT_EQ(findEvents("processRMC").size(), 20u);
+  EXPECT_EQ(findEvents("makeDiagnosticReport").size(), 1u);
+
+  auto ggaEvents = findEvents("processGGA");
+  ASSERT_EQ(ggaEvents.size(), 20u);
+  EXPECT_EQ(ggaEvents.front().outcome, romea::core::TraceOutcome::NO_OBSERVATION);
+  EXPECT_EQ(ggaEvents.back().outcome, romea::core::TraceOutcome::OBSERVATION);
+  EXPECT_EQ(ggaEvents.back().stamp, romea::core::durationFromSecond(1.9));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkChromeTraceFormat)
+{
+  {
+    romea::core::TraceScope trace("format", romea::core::durationFromSecond(1.));
+    trace.setOutcome(true);
+  }
+
+  std::ostringstream os;
+  romea::core::ProcessingTracer::writeChromeTrace(os);
+  std::string trace = os.str();
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find("\"name\":\"format\",\"cat\":\"gps\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(
+    trace.find("\"args\":{\"stamp\":1.000000000,\"outcome\":\"observation\"}"),
+    std::string::npos);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestProcessingTracer, checkChromeTraceKeepsStreamFormat)
+{
+  {
+    romea::core::TraceScope trace("format", romea::core::durationFromSecond(1.));
+  }
+
+  std::ostringstream os;
+  os << std::scientific << std::setprecision(2);
+  romea::core::ProcessingTracer::writeChromeTrace(os);
+  EXPECT_EQ(os.precision(), 2);
+  EXPECT_EQ(os.flags() & std::ios_base::floatfield, std::ios_base::scientific);
+}
@@ -0,0 +1,331 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <dlfcn.h>
+#include <pthread.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/RealtimeLocalisationGPSPlugin.hpp"
+
+// Every heap allocation and mutex lock made by a thread flagged as running
+// the realtime hot path is counted by the hooks below
+thread_local bool inHotPath = false;
+std::atomic<size_t> hotPathAllocations(0);
+std::atomic<size_t> hotPathLocks(0);
+
+extern "C" void * __libc_malloc(size_t size);
+extern "C" void * __libc_calloc(size_t number, size_t size);
+extern "C" void * __libc_realloc(void * ptr, size_t size);
+
+extern "C" void * malloc(size_t size)
+{
+  if (inHotPath) {
+    hotPathAllocations++;
+  }
+  return __libc_malloc(size);
+}
+
+extern "C" void * calloc(size_t number, size_t size)
+{
+  if (inHotPath) {
+    hotPathAllocations++;
+  }
+  return __libc_calloc(number, size);
+}
+
+extern "C" void * realloc(void * ptr, size_t size)
+{
+  if (inHotPath) {
+    hotPathAllocations++;
+  }
+  return __libc_realloc(ptr, size);
+}
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t * mutex)
+{
+  using Lock = int (*)(pthread_mutex_t *);
+  static Lock lock = reinterpret_cast<Lock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+  if (inHotPath) {
+    hotPathLocks++;
+  }
+  return lock(mutex);
+}
+
+class HotPath
+{
+public:
+  HotPath()
+  {
+    hotPathAllocations = 0;
+    hotPathLocks = 0;
+    inHotPath = true;
+  }
+
+  ~HotPath()
+  {
+    inHotPath = false;
+  }
+};
+
+class TestRealtimeLocalisationGPSPlugin : public ::testing::Test
+{
+public:
+  TestRealtimeLocalisationGPSPlugin()
+  : gga_sentence(minimalGoodGGAFrame().toNMEA()),
+    rmc_sentence(minimalGoodRMCFrame().toNMEA()),
+    hdt_sentence(minimalGoodHDTFrame().toNMEA()),
+    position(),
+    course()
+  {
+  }
+
+  std::unique_ptr<romea::core::GPSReceiver> makeGPS()
+  {
+    auto gps = std::make_unique<romea::core::GPSReceiver>();
+    gps->setAntennaBodyPosition(Eigen::Vector3d(0.3, 0, 2.));
+    return gps;
+  }
+
+  romea::core::Duration stamp(const double & seconds)
+  {
+    return romea::core::durationFromSecond(seconds);
+  }
+
+  std::string gga_sentence;
+  std::string rmc_sentence;
+  std::string hdt_sentence;
+  romea::core::ObservationPosition position;
+  romea::core::ObservationCourse course;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkHooksDetectAllocationsAndLocks)
+{
+  std::mutex mutex;
+  {
+    HotPath hotPath;
+    std::string string(100, 'a');
+    std::lock_guard<std::mutex> lock(mutex);
+    inHotPath = false;
+  }
+  EXPECT_GT(hotPathAllocations.load(), 0u);
+  EXPECT_GT(hotPathLocks.load(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkSingleAntennaHotPathNeitherAllocatesNorLocks)
+{
+  romea::core::RealtimeLocalisationSingleAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX, 1.);
+
+  bool is_position_valid = false;
+  bool is_course_valid = false;
+  {
+    HotPath hotPath;
+    for (size_t n = 0; n < 100; ++n) {
+      plugin.processLinearSpeed(stamp(n / 10.), 2.0);
+      if (n % 10 == 0) {
+        is_position_valid = plugin.processGGA(stamp(n / 10.), gga_sentence, position);
+        is_course_valid = plugin.processRMC(stamp(n / 10.), rmc_sentence, course);
+      }
+    }
+  }
+
+  EXPECT_EQ(hotPathAllocations.load(), 0u);
+  EXPECT_EQ(hotPathLocks.load(), 0u);
+  EXPECT_TRUE(is_position_valid);
+  EXPECT_TRUE(is_course_valid);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkDualAntennaHotPathNeitherAllocatesNorLocks)
+{
+  romea::core::RealtimeLocalisationDualAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX, 0.8);
+
+  bool is_position_valid = false;
+  bool is_course_valid = false;
+  {
+    HotPath hotPath;
+    for (size_t n = 0; n < 10; ++n) {
+      is_position_valid = plugin.processGGA(stamp(n), gga_sentence, position);
+      is_course_valid = plugin.processHDT(stamp(n), hdt_sentence, course);
+    }
+  }
+
+  EXPECT_EQ(hotPathAllocations.load(), 0u);
+  EXPECT_EQ(hotPathLocks.load(), 0u);
+  EXPECT_TRUE(is_position_valid);
+  EXPECT_TRUE(is_course_valid);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkSingleAntennaMatchesRegularPlugin)
+{
+  romea::core::RealtimeLocalisationSingleAntennaGPSPlugin realtime_plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX, 1.);
+  romea::core::LocalisationSingleAntennaGPSPlugin regular_plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX, 1.);
+
+  romea::core::ObservationPosition regular_position;
+  romea::core::ObservationCourse regular_course;
+  for (size_t n = 0; n < 100; ++n) {
+    realtime_plugin.processLinearSpeed(stamp(n / 10.), 2.0);
+    regular_plugin.processLinearSpeed(stamp(n / 10.), 2.0);
+    if (n % 10 == 0) {
+      EXPECT_EQ(
+        realtime_plugin.processGGA(stamp(n / 10.), gga_sentence, position),
+        regular_plugin.processGGA(stamp(n / 10.), gga_sentence, regular_position));
+      EXPECT_EQ(
+        realtime_plugin.processRMC(stamp(n / 10.), rmc_sentence, course),
+        regular_plugin.processRMC(stamp(n / 10.), rmc_sentence, regular_course));
+    }
+  }
+
+  EXPECT_NEAR(position.Y(0), regular_position.Y(0), 1e-9);
+  EXPECT_NEAR(position.Y(1), regular_position.Y(1), 1e-9);
+  EXPECT_DOUBLE_EQ(position.R()(0, 0), regular_position.R()(0, 0));
+  EXPECT_NEAR(course.Y(), regular_course.Y(), 1e-12);
+  EXPECT_NEAR(course.R(), regular_course.R(), 1e-12);
+
+  auto realtime_report = realtime_plugin.makeDiagnosticReport(stamp(10.));
+  auto regular_report = regular_plugin.makeDiagnosticReport(stamp(10.));
+  EXPECT_EQ(realtime_report.info.at("realtime_dropped_events"), "0");
+  realtime_report.info.erase("realtime_dropped_events");
+  EXPECT_EQ(realtime_report.info, regular_report.info);
+  ASSERT_EQ(realtime_report.diagnostics.size(), regular_report.diagnostics.size());
+  auto it = regular_report.diagnostics.cbegin();
+  for (const auto & diagnostic : realtime_report.diagnostics) {
+    EXPECT_EQ(diagnostic.status, it->status);
+    EXPECT_EQ(diagnostic.message, it->message);
+    ++it;
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkRealtimeCourseIsLostWithLinearSpeed)
+{
+  romea::core::RealtimeLocalisationSingleAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX, 1.);
+
+  for (size_t n = 0; n < 5; ++n) {
+    plugin.processLinearSpeed(stamp(n), 2.0);
+    plugin.processRMC(stamp(n), rmc_sentence, course);
+  }
+  EXPECT_FALSE(plugin.processRMC(stamp(5), rmc_sentence, course));
+
+  plugin.processLinearSpeed(stamp(5.9), 2.0);
+  EXPECT_TRUE(plugin.processRMC(stamp(6), rmc_sentence, course));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkTransitionsAreDispatchedByDiagnosticsThread)
+{
+  romea::core::RealtimeLocalisationDualAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX);
+
+  std::vector<std::thread::id> threads;
+  plugin.registerStatusTransitionCallback(
+    [&threads](const romea::core::StatusTransition &) {
+      threads.push_back(std::this_thread::get_id());
+    });
+
+  std::thread realtime_thread([&] {
+      for (size_t n = 0; n < 10; ++n) {
+        plugin.processGGA(stamp(n), gga_sentence, position);
+        plugin.processHDT(stamp(n), hdt_sentence, course);
+      }
+    });
+  realtime_thread.join();
+  EXPECT_TRUE(threads.empty());
+
+  plugin.processPendingEvents();
+  EXPECT_FALSE(threads.empty());
+  for (const auto & thread : threads) {
+    EXPECT_EQ(thread, std::this_thread::get_id());
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkEventsAreDroppedWhenQueueIsFull)
+{
+  romea::core::RealtimeLocalisationDualAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX,
+    std::numeric_limits<double>::quiet_NaN(), 4);
+
+  for (size_t n = 0; n < 10; ++n) {
+    plugin.processGGA(stamp(n), gga_sentence, position);
+  }
+  EXPECT_EQ(plugin.getNumberOfDroppedEvents(), 6u);
+
+  auto report = plugin.makeDiagnosticReport(stamp(10));
+  EXPECT_EQ(report.info.at("realtime_dropped_events"), "6");
+
+  plugin.processGGA(stamp(10), gga_sentence, position);
+  EXPECT_EQ(plugin.getNumberOfDroppedEvents(), 6u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkRealtimePositionJumpsAreRejected)
+{
+  romea::core::RealtimeLocalisationDualAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX);
+
+  for (size_t n = 0; n < 10; ++n) {
+    plugin.processGGA(stamp(n), gga_sentence, position);
+  }
+  EXPECT_TRUE(plugin.processGGA(stamp(10), gga_sentence, position));
+
+  auto jump_frame = minimalGoodGGAFrame();
+  jump_frame.latitude = romea::core::Latitude(0.7854 + 50. / 6378137.);
+  EXPECT_FALSE(plugin.processGGA(stamp(11), jump_frame.toNMEA(), position));
+
+  auto report = plugin.makeDiagnosticReport(stamp(11));
+  EXPECT_EQ(report.info.at("position_jumps_rejected"), "1");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRealtimeLocalisationGPSPlugin, checkGSVCanBeFedWhileDiagnosticsAreMade)
+{
+  romea::core::RealtimeLocalisationDualAntennaGPSPlugin plugin(
+    makeGPS(), romea::core::FixQuality::RTK_FIX);
+
+  std::thread gsv_thread([&] {
+      for (size_t n = 0; n < 100; ++n) {
+        plugin.processGSV("$GPGSV,1,1,01,05,40,083,46*4C");
+      }
+    });
+  for (size_t n = 0; n < 100; ++n) {
+    plugin.processGGA(stamp(n), gga_sentence, position);
+    plugin.makeDiagnosticReport(stamp(n));
+  }
+  gsv_thread.join();
+
+  auto report = plugin.makeDiagnosticReport(stamp(100));
+  EXPECT_EQ(report.info.at("realtime_dropped_events"), "0");
+}
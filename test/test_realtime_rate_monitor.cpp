@@ -0,0 +1,63 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// romea
+#include "romea_core_localisation_gps/RealtimeRateMonitor.hpp"
+
+//-----------------------------------------------------------------------------
+romea::core::Duration stamp(const double & seconds)
+{
+  return romea::core::durationFromSecond(seconds);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestRealtimeRateMonitor, checkRateIsOKOnceWindowIsFilled)
+{
+  romea::core::RealtimeRateMonitor monitor(10., 0.1);
+  EXPECT_FALSE(monitor.isAlive(stamp(0.)));
+  for (size_t n = 0; n < 4; ++n) {
+    EXPECT_EQ(monitor.evaluate(stamp(n * 0.1)), romea::core::DiagnosticStatus::ERROR);
+  }
+  EXPECT_EQ(monitor.evaluate(stamp(0.4)), romea::core::DiagnosticStatus::OK);
+  EXPECT_TRUE(monitor.isAlive(stamp(0.6)));
+  EXPECT_FALSE(monitor.isAlive(stamp(0.7)));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestRealtimeRateMonitor, checkLowRateIsDetected)
+{
+  romea::core::RealtimeRateMonitor monitor(10., 0.1);
+  for (size_t n = 0; n < 10; ++n) {
+    EXPECT_EQ(monitor.evaluate(stamp(n * 0.15)), romea::core::DiagnosticStatus::ERROR);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestRealtimeRateMonitor, checkGapRestartsEstimation)
+{
+  romea::core::RealtimeRateMonitor monitor(1., 0.1);
+  for (size_t n = 0; n < 5; ++n) {
+    monitor.evaluate(stamp(n));
+  }
+  EXPECT_EQ(monitor.evaluate(stamp(5.)), romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(monitor.evaluate(stamp(8.)), romea::core::DiagnosticStatus::ERROR);
+  for (size_t n = 9; n < 12; ++n) {
+    EXPECT_EQ(monitor.evaluate(stamp(n)), romea::core::DiagnosticStatus::ERROR);
+  }
+  EXPECT_EQ(monitor.evaluate(stamp(12.)), romea::core::DiagnosticStatus::OK);
+}
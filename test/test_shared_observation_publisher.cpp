@@ -0,0 +1,247 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/SharedObservationPublisher.hpp"
+#include "romea_core_localisation_gps/SharedObservationReader.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+std::string ringName(const std::string & test)
+{
+  return "/romea_gps_test_" + test + "_" + std::to_string(getpid());
+}
+
+//-----------------------------------------------------------------------------
+romea::core::ObservationPosition makePosition(const double & x)
+{
+  romea::core::ObservationPosition positionObs;
+  positionObs.Y(romea::core::ObservationPosition::POSITION_X) = x;
+  positionObs.Y(romea::core::ObservationPosition::POSITION_Y) = -2.5;
+  positionObs.R() << 0.04, 0.01, 0.01, 0.09;
+  positionObs.levelArm = Eigen::Vector3d(0.3, 0., 2.);
+  return positionObs;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkRecordsRoundTrip)
+{
+  romea::core::SharedObservationPublisher publisher(ringName("round_trip"), 16);
+  romea::core::SharedObservationReader reader(publisher.getName());
+
+  romea::core::ObservationCourse courseObs;
+  courseObs.Y() = 0.7;
+  courseObs.R() = 0.001;
+
+  romea::core::StatusTransition transition;
+  transition.checkup = romea::core::GPSCheckup::GGA_FIX;
+  transition.stamp = romea::core::durationFromSecond(3.);
+  transition.previousStatus = std::nullopt;
+  transition.currentStatus = romea::core::DiagnosticStatus::WARN;
+  transition.previousFixQuality = std::nullopt;
+  transition.currentFixQuality = romea::core::FixQuality::FLOAT_RTK_FIX;
+
+  publisher.publish(romea::core::durationFromSecond(1.), makePosition(4.));
+  publisher.publish(romea::core::durationFromSecond(2.), courseObs);
+  publisher.publish(transition);
+
+  romea::core::SharedObservationRecord record;
+  ASSERT_TRUE(reader.read(record));
+  EXPECT_EQ(record.index, 0u);
+  EXPECT_EQ(record.type, romea::core::SharedObservationType::POSITION);
+  EXPECT_EQ(record.stamp, romea::core::durationFromSecond(1.));
+  auto positionObs = romea::core::toObservationPosition(record);
+  EXPECT_DOUBLE_EQ(positionObs.Y(0), 4.);
+  EXPECT_DOUBLE_EQ(positionObs.Y(1), -2.5);
+  EXPECT_DOUBLE_EQ(positionObs.R()(1, 0), 0.01);
+  EXPECT_DOUBLE_EQ(positionObs.R()(1, 1), 0.09);
+  EXPECT_DOUBLE_EQ(positionObs.levelArm.z(), 2.);
+
+  ASSERT_TRUE(reader.read(record));
+  EXPECT_EQ(record.type, romea::core::SharedObservationType::COURSE);
+  EXPECT_DOUBLE_EQ(romea::core::toObservationCourse(record).Y(), 0.7);
+  EXPECT_DOUBLE_EQ(romea::core::toObservationCourse(record).R(), 0.001);
+
+  ASSERT_TRUE(reader.read(record));
+  EXPECT_EQ(record.type, romea::core::SharedObservationType::STATUS);
+  auto readTransition = romea::core::toStatusTransition(record);
+  EXPECT_EQ(readTransition.checkup, romea::core::GPSCheckup::GGA_FIX);
+  EXPECT_EQ(readTransition.stamp, transition.stamp);
+  EXPECT_FALSE(readTransition.previousStatus);
+  EXPECT_EQ(readTransition.currentStatus, transition.currentStatus);
+  EXPECT_FALSE(readTransition.previousFixQuality);
+  EXPECT_EQ(readTransition.currentFixQuality, transition.currentFixQuality);
+
+  EXPECT_FALSE(reader.read(record));
+  EXPECT_EQ(reader.getNumberOfLostRecords(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkReaderStartingPoint)
+{
+  romea::core::SharedObservationPublisher publisher(ringName("starting_point"), 4);
+  for (size_t n = 0; n < 6; ++n) {
+    publisher.publish(romea::core::durationFromSecond(n), makePosition(n));
+  }
+
+  romea::core::SharedObservationRecord record;
+  romea::core::SharedObservationReader newestReader(publisher.getName());
+  EXPECT_FALSE(newestReader.read(record));
+
+  romea::core::SharedObservationReader oldestReader(publisher.getName(), true);
+  ASSERT_TRUE(oldestReader.read(record));
+  EXPECT_EQ(record.index, 2u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkSlowReaderLosesRecords)
+{
+  romea::core::SharedObservationPublisher publisher(ringName("slow_reader"), 4);
+  romea::core::SharedObservationReader reader(publisher.getName());
+  for (size_t n = 0; n < 10; ++n) {
+    publisher.publish(romea::core::durationFromSecond(n), makePosition(n));
+  }
+
+  romea::core::SharedObservationRecord record;
+  ASSERT_TRUE(reader.read(record));
+  EXPECT_EQ(record.index, 6u);
+  EXPECT_DOUBLE_EQ(record.values[0], 6.);
+  EXPECT_EQ(reader.getNumberOfLostRecords(), 6u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkReaderInAnotherProcess)
+{
+  romea::core::SharedObservationPublisher publisher(ringName("other_process"), 16);
+  for (size_t n = 0; n < 5; ++n) {
+    publisher.publish(romea::core::durationFromSecond(n), makePosition(n));
+  }
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    romea::core::SharedObservationReader reader(publisher.getName(), true);
+    romea::core::SharedObservationRecord record;
+    int sum = 0;
+    while (reader.read(record)) {
+      sum += static_cast<int>(record.values[0]);
+    }
+    _exit(sum);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0 + 1 + 2 + 3 + 4);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkReaderRequiresPublisher)
+{
+  EXPECT_THROW(
+    romea::core::SharedObservationReader reader(ringName("missing")),
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkExistingObjectIsNotTakenOver)
+{
+  std::string name = ringName("existing");
+  {
+    romea::core::SharedObservationPublisher publisher(name, 4);
+    romea::core::SharedObservationReader reader(name);
+    EXPECT_THROW(romea::core::SharedObservationPublisher(name, 4), std::runtime_error);
+
+    // the ring of the first publisher is left untouched
+    publisher.publish(romea::core::durationFromSecond(1.), makePosition(1.));
+    romea::core::SharedObservationRecord record;
+    EXPECT_TRUE(reader.read(record));
+  }
+
+  // the name can be reused once the publisher is destroyed
+  romea::core::SharedObservationPublisher publisher(name, 4);
+  EXPECT_NO_THROW(romea::core::SharedObservationReader reader(name));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkOnlyOwnedObjectIsRemoved)
+{
+  std::string name = ringName("owned");
+  auto publisher = std::make_unique<romea::core::SharedObservationPublisher>(name, 4);
+
+  // the object is removed behind the back of the publisher and replaced
+  shm_unlink(name.c_str());
+  romea::core::SharedObservationPublisher replacement(name, 4);
+  publisher.reset();
+
+  EXPECT_NO_THROW(romea::core::SharedObservationReader reader(name));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSharedObservationPublisher, checkPluginPublishesObservations)
+{
+  auto publisher = std::make_shared<romea::core::SharedObservationPublisher>(
+    ringName("plugin"));
+  romea::core::SharedObservationReader reader(publisher->getName());
+
+  romea::core::LocalisationGPSPlugin<> plugin(
+    std::make_unique<romea::core::GPSReceiver>(), romea::core::FixQuality::RTK_FIX);
+  plugin.setSharedObservationPublisher(publisher);
+
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::ObservationPosition positionObs;
+  size_t numberOfPositions = 0;
+  for (size_t n = 0; n < 8; ++n) {
+    numberOfPositions += plugin.processGGA(
+      romea::core::durationFromSecond(n * 0.1), ggaSentence, positionObs);
+  }
+
+  size_t numberOfPublishedPositions = 0;
+  size_t numberOfPublishedTransitions = 0;
+  romea::core::SharedObservationRecord record;
+  while (reader.read(record)) {
+    if (record.type == romea::core::SharedObservationType::POSITION) {
+      numberOfPublishedPositions++;
+      EXPECT_DOUBLE_EQ(romea::core::toObservationPosition(record).Y(0), positionObs.Y(0));
+    } else if (record.type == romea::core::SharedObservationType::STATUS) {
+      numberOfPublishedTransitions++;
+    }
+  }
+
+  EXPECT_EQ(numberOfPositions, 4u);
+  EXPECT_EQ(numberOfPublishedPositions, numberOfPositions);
+  // gga rate error then ok, gga fix ok
+  EXPECT_EQ(numberOfPublishedTransitions, 3u);
+}
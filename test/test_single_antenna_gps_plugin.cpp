@@ -19,12 +19,15 @@
 // std
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <utility>
 #include <string>
 
 // romea
 #include "helper.hpp"
 #include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/CourseAngleCovariance.hpp"
+#include "romea_core_localisation_gps/GPSObservations.hpp"
 
 bool boolean(const romea::core::DiagnosticStatus & status)
 {
@@ -176,6 +179,140 @@ TEST_F(TestSingleAntennaGPSPlugin, testCannotComputeCourseBecauseLinearSpeedIsMi
     romea::core::DiagnosticStatus::ERROR);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestSingleAntennaGPSPlugin, testCourseAngleCovarianceFromSpeedOverGround)
+{
+  check(
+    romea::core::DiagnosticStatus::OK,
+    romea::core::DiagnosticStatus::OK,
+    romea::core::DiagnosticStatus::OK);
+
+  double positionStd = std::sqrt(position.R()(0, 0));
+  double courseAngleStd = romea::core::rmcCourseAngleStd(
+    *rmc_frame.speedOverGroundInMeterPerSecond, positionStd, 1.0);
+  EXPECT_NEAR(course.R(), courseAngleStd * courseAngleStd, 1e-9);
+  EXPECT_LT(course.R(), std::pow(romea::core::defaultCourseAngleStd(), 2.0));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSingleAntennaGPSPlugin, testDumpDiagnosticHistory)
+{
+  check(
+    romea::core::DiagnosticStatus::OK,
+    romea::core::DiagnosticStatus::OK,
+    romea::core::DiagnosticStatus::OK);
+
+  std::ostringstream os;
+  gps_plugin->dumpDiagnosticHistory(os);
+  std::string dump = os.str();
+  EXPECT_NE(dump.find("# linear_speed_rate\n"), std::string::npos);
+  EXPECT_NE(dump.find("# gga_rate\nstamp,status,rate\n"), std::string::npos);
+  EXPECT_NE(dump.find("0.600000000,ERROR,10\n"), std::string::npos);
+  EXPECT_NE(dump.find("# gga_fix\nstamp,status,fix_quality,hdop,number_of_satellites\n"
+    "0.500000000,OK,4,1.2,12\n"), std::string::npos);
+  EXPECT_NE(dump.find("# rmc_rate\n"), std::string::npos);
+  EXPECT_NE(dump.find("# rmc_track_angle\n"), std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSingleAntennaGPSPlugin, testMalformedSentencesAreIgnored)
+{
+  std::string gga_sentence = gga_frame.toNMEA();
+  std::string rmc_sentence = rmc_frame.toNMEA();
+  for (size_t length = 0; length < gga_sentence.size(); ++length) {
+    stamp = romea::core::durationFromSecond(0.1 * length);
+    EXPECT_NO_THROW(gps_plugin->processGGA(stamp, gga_sentence.substr(0, length), position));
+    EXPECT_NO_THROW(gps_plugin->processRMC(stamp, rmc_sentence.substr(0, length), course));
+  }
+  EXPECT_NO_THROW(
+    gps_plugin->processGGA(
+      stamp, "$GNGGA,120000.00,45" + std::string(400, '9') +
+      ",N,00130.0000,E,4,12,1.2,53.3,M,400.8,M,2.5,1", position));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSingleAntennaGPSPlugin, testProcessNMEADispatchesAndCountsSentences)
+{
+  std::string gga_sentence = gga_frame.toNMEA();
+  std::string rmc_sentence = rmc_frame.toNMEA();
+  std::string hdt_sentence = minimalGoodHDTFrame().toNMEA();
+  std::string vtg_sentence = "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48";
+  romea::core::NMEASentenceType type;
+
+  for (size_t n = 0; n <= 20; ++n) {
+    stamp = romea::core::durationFromSecond(n / 20.);
+    gps_plugin->processLinearSpeed(stamp, linear_speed);
+    gps_plugin->processNMEA(stamp, gga_sentence, type, position, course);
+    EXPECT_EQ(type, romea::core::NMEASentenceType::GGA);
+    gps_plugin->processNMEA(stamp, rmc_sentence, type, position, course);
+    EXPECT_EQ(type, romea::core::NMEASentenceType::RMC);
+    EXPECT_FALSE(gps_plugin->processNMEA(stamp, hdt_sentence, type, position, course));
+    EXPECT_FALSE(gps_plugin->processNMEA(stamp, vtg_sentence, type, position, course));
+  }
+
+  stamp = romea::core::durationFromSecond(1.05);
+  gps_plugin->processLinearSpeed(stamp, linear_speed);
+  EXPECT_TRUE(gps_plugin->processNMEA(stamp, gga_sentence, type, position, course));
+  EXPECT_TRUE(gps_plugin->processNMEA(stamp, rmc_sentence, type, position, course));
+  EXPECT_FALSE(gps_plugin->processNMEA(stamp, "GPGGA", type, position, course));
+  EXPECT_EQ(type, romea::core::NMEASentenceType::MALFORMED);
+
+  report = gps_plugin->makeDiagnosticReport(stamp);
+  EXPECT_EQ(report.info["nmea_gga_sentences"], "22");
+  EXPECT_EQ(report.info["nmea_rmc_sentences"], "22");
+  EXPECT_EQ(report.info["nmea_hdt_sentences"], "21");
+  EXPECT_EQ(report.info["nmea_vtg_sentences"], "21");
+  EXPECT_EQ(report.info["nmea_malformed_sentences"], "1");
+  EXPECT_EQ(report.info.count("nmea_gsv_sentences"), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSingleAntennaGPSPlugin, testGSTErrorEllipseGivesPositionCovariance)
+{
+  std::string gga_sentence = gga_frame.toNMEA();
+  std::string gst_sentence = "$GNGST,120000.00,1.8,0.03,0.01,90.0,0.011,0.029,0.05";
+  romea::core::NMEASentenceType type;
+
+  for (size_t n = 0; n <= 20; ++n) {
+    stamp = romea::core::durationFromSecond(n / 20.);
+    gps_plugin->processNMEA(stamp, gga_sentence, type, position, course);
+    gps_plugin->processNMEA(stamp, gst_sentence, type, position, course);
+    EXPECT_EQ(type, romea::core::NMEASentenceType::GST);
+  }
+
+  stamp = romea::core::durationFromSecond(1.05);
+  ASSERT_TRUE(gps_plugin->processGGA(stamp, gga_sentence, position));
+  EXPECT_NEAR(position.R()(0, 0), 0.0009, 1e-12);
+  EXPECT_NEAR(position.R()(1, 1), 0.0001, 1e-12);
+  EXPECT_NEAR(position.R()(0, 1), 0., 1e-12);
+
+  // the GST of the previous epoch is too old, HDOP gives the covariance
+  gps_plugin->setGSTMaximalAge(romea::core::durationFromSecond(0.02));
+  stamp = romea::core::durationFromSecond(1.1);
+  ASSERT_TRUE(gps_plugin->processGGA(stamp, gga_sentence, position));
+  double fixStd = romea::core::computeFixStd(gga_frame, romea::core::GPSReceiver());
+  EXPECT_DOUBLE_EQ(position.R()(0, 0), fixStd * fixStd);
+  EXPECT_DOUBLE_EQ(position.R()(1, 1), fixStd * fixStd);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSingleAntennaGPSPlugin, testPositionsAreNotGatedAcrossAnchors)
+{
+  std::string gga_sentence = gga_frame.toNMEA();
+  gps_plugin->setAnchor(romea::core::makeGeodeticCoordinates(0.7854, 0.03, 454.1));
+  for (size_t n = 0; n <= 20; ++n) {
+    stamp = romea::core::durationFromSecond(n / 20.);
+    gps_plugin->processGGA(stamp, gga_sentence, position);
+  }
+
+  // the same fix is 600 m away in the ENU frame of the new anchor
+  gps_plugin->setAnchor(romea::core::makeGeodeticCoordinates(0.7855, 0.03, 454.1));
+  stamp = romea::core::durationFromSecond(1.05);
+  EXPECT_TRUE(gps_plugin->processGGA(stamp, gga_sentence, position));
+  report = gps_plugin->makeDiagnosticReport(stamp);
+  EXPECT_EQ(report.info.at("position_jumps_rejected"), "0");
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
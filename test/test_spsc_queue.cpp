@@ -0,0 +1,76 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+
+// romea
+#include "romea_core_localisation_gps/SPSCQueue.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestSPSCQueue, checkCapacityIsRoundedUpToPowerOfTwo)
+{
+  romea::core::SPSCQueue<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSPSCQueue, checkFullQueueRejectsElements)
+{
+  romea::core::SPSCQueue<int> queue(2);
+  EXPECT_TRUE(queue.tryPush(1));
+  EXPECT_TRUE(queue.tryPush(2));
+  EXPECT_FALSE(queue.tryPush(3));
+  EXPECT_EQ(queue.size(), 2u);
+
+  int value;
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.tryPush(3));
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(queue.tryPop(value));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSPSCQueue, checkElementsAreReceivedInOrderAcrossThreads)
+{
+  const int number_of_elements = 100000;
+  romea::core::SPSCQueue<int> queue(16);
+
+  std::thread producer([&queue] {
+      for (int n = 0; n < number_of_elements; ++n) {
+        while (!queue.tryPush(n)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+  int expected = 0;
+  int value;
+  while (expected != number_of_elements) {
+    if (queue.tryPop(value)) {
+      ASSERT_EQ(value, expected++);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
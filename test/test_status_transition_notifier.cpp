@@ -0,0 +1,168 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "helper.hpp"
+#include "romea_core_localisation_gps/LocalisationGPSPlugin.hpp"
+#include "romea_core_localisation_gps/StatusTransitionNotifier.hpp"
+
+class TestStatusTransitionNotifier : public ::testing::Test
+{
+public:
+  TestStatusTransitionNotifier()
+  : notifier(),
+    transitions()
+  {
+    notifier.registerCallback(
+      [this](const romea::core::StatusTransition & transition) {
+        transitions.push_back(transition);
+      });
+  }
+
+  romea::core::StatusTransitionNotifier notifier;
+  std::vector<romea::core::StatusTransition> transitions;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestStatusTransitionNotifier, callbacksAreDeferredUntilDispatch)
+{
+  notifier.update(
+    romea::core::GPSCheckup::GGA_RATE, romea::core::Duration(1),
+    romea::core::DiagnosticStatus::OK);
+  EXPECT_TRUE(transitions.empty());
+
+  notifier.dispatch();
+  ASSERT_EQ(transitions.size(), 1);
+  EXPECT_EQ(transitions[0].checkup, romea::core::GPSCheckup::GGA_RATE);
+  EXPECT_EQ(transitions[0].stamp, romea::core::Duration(1));
+  EXPECT_FALSE(transitions[0].previousStatus);
+  EXPECT_EQ(*transitions[0].currentStatus, romea::core::DiagnosticStatus::OK);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestStatusTransitionNotifier, onlyTransitionsAreNotified)
+{
+  for (int n = 0; n < 10; ++n) {
+    notifier.update(
+      romea::core::GPSCheckup::GGA_FIX, romea::core::Duration(n),
+      romea::core::DiagnosticStatus::OK, romea::core::FixQuality::RTK_FIX);
+    notifier.dispatch();
+  }
+  EXPECT_EQ(transitions.size(), 1);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestStatusTransitionNotifier, fixQualityTransition)
+{
+  notifier.update(
+    romea::core::GPSCheckup::GGA_FIX, romea::core::Duration(1),
+    romea::core::DiagnosticStatus::OK, romea::core::FixQuality::RTK_FIX);
+  notifier.update(
+    romea::core::GPSCheckup::GGA_FIX, romea::core::Duration(2),
+    romea::core::DiagnosticStatus::OK, romea::core::FixQuality::FLOAT_RTK_FIX);
+  notifier.update(
+    romea::core::GPSCheckup::GGA_FIX, romea::core::Duration(3),
+    romea::core::DiagnosticStatus::WARN, romea::core::FixQuality::FLOAT_RTK_FIX);
+  notifier.dispatch();
+
+  ASSERT_EQ(transitions.size(), 3);
+  EXPECT_EQ(*transitions[1].previousFixQuality, romea::core::FixQuality::RTK_FIX);
+  EXPECT_EQ(*transitions[1].currentFixQuality, romea::core::FixQuality::FLOAT_RTK_FIX);
+  EXPECT_EQ(*transitions[1].previousStatus, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(*transitions[1].currentStatus, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(*transitions[2].previousStatus, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(*transitions[2].currentStatus, romea::core::DiagnosticStatus::WARN);
+  EXPECT_EQ(transitions[2].stamp, romea::core::Duration(3));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestStatusTransitionNotifier, transitionsQueuedByCallbackAreDispatched)
+{
+  notifier.registerCallback(
+    [this](const romea::core::StatusTransition & transition) {
+      if (transition.checkup == romea::core::GPSCheckup::GGA_RATE) {
+        notifier.update(
+          romea::core::GPSCheckup::GGA_FIX, transition.stamp,
+          romea::core::DiagnosticStatus::ERROR);
+        notifier.dispatch();
+      }
+    });
+
+  notifier.update(
+    romea::core::GPSCheckup::GGA_RATE, romea::core::Duration(1),
+    romea::core::DiagnosticStatus::OK);
+  notifier.dispatch();
+
+  ASSERT_EQ(transitions.size(), 2);
+  EXPECT_EQ(transitions[1].checkup, romea::core::GPSCheckup::GGA_FIX);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPluginStatusTransitions, notifyFixLoss)
+{
+  auto gps = std::make_unique<romea::core::GPSReceiver>();
+  romea::core::LocalisationDualAntennaGPSPlugin plugin(
+    std::move(gps), romea::core::FixQuality::RTK_FIX);
+
+  std::vector<romea::core::StatusTransition> transitions;
+  plugin.registerStatusTransitionCallback(
+    [&](const romea::core::StatusTransition & transition) {
+      // not called under checkup locks, the plugin can be queried
+      plugin.makeDiagnosticReport(transition.stamp);
+      transitions.push_back(transition);
+    });
+
+  std::string ggaSentence = minimalGoodGGAFrame().toNMEA();
+  romea::core::ObservationPosition position;
+  for (size_t n = 0; n < 4; ++n) {
+    plugin.processGGA(romea::core::durationFromSecond(0.5 + n / 10.), ggaSentence, position);
+  }
+  plugin.processGGA(romea::core::durationFromSecond(0.5), ggaSentence, position);
+
+  ASSERT_FALSE(transitions.empty());
+  EXPECT_EQ(transitions.back().checkup, romea::core::GPSCheckup::GGA_FIX);
+  EXPECT_EQ(*transitions.back().currentStatus, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(*transitions.back().currentFixQuality, romea::core::FixQuality::RTK_FIX);
+  for (const auto & transition : transitions) {
+    EXPECT_TRUE(
+      transition.previousStatus != transition.currentStatus ||
+      transition.previousFixQuality != transition.currentFixQuality);
+  }
+
+  transitions.clear();
+  plugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  ASSERT_EQ(transitions.size(), 2);
+  EXPECT_EQ(transitions[0].checkup, romea::core::GPSCheckup::GGA_RATE);
+  EXPECT_EQ(*transitions[0].currentStatus, romea::core::DiagnosticStatus::ERROR);
+  EXPECT_EQ(transitions[1].checkup, romea::core::GPSCheckup::GGA_FIX);
+  EXPECT_FALSE(transitions[1].currentStatus);
+  EXPECT_FALSE(transitions[1].currentFixQuality);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
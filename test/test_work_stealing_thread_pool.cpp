@@ -0,0 +1,108 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_gps/WorkStealingThreadPool.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestWorkStealingThreadPool, checkAllTasksAreExecutedBeforeDestruction)
+{
+  std::atomic<int> counter(0);
+  {
+    romea::core::WorkStealingThreadPool pool(4);
+    EXPECT_EQ(pool.getNumberOfThreads(), 4u);
+    for (int n = 0; n < 1000; ++n) {
+      pool.submit([&counter] {counter++;});
+    }
+  }
+  EXPECT_EQ(counter.load(), 1000);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestWorkStealingThreadPool, checkTasksSubmittedFromWorkersAreExecuted)
+{
+  std::atomic<int> counter(0);
+  {
+    romea::core::WorkStealingThreadPool pool(2);
+    for (int n = 0; n < 10; ++n) {
+      pool.submit([&pool, &counter] {
+          for (int m = 0; m < 10; ++m) {
+            pool.submit([&counter] {counter++;});
+          }
+        });
+    }
+  }
+  EXPECT_EQ(counter.load(), 100);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestWorkStealingThreadPool, checkIdleWorkersStealTasks)
+{
+  std::atomic<int> counter(0);
+  romea::core::WorkStealingThreadPool pool(4);
+
+  // all tasks are pushed in the deque of the worker running the first task
+  pool.submit([&pool, &counter] {
+      for (int n = 0; n < 64; ++n) {
+        pool.submit([&counter] {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            counter++;
+          });
+      }
+    });
+
+  while (pool.getMetrics().executedTasks != 65) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(counter.load(), 64);
+  EXPECT_EQ(pool.getMetrics().queuedTasks, 0u);
+  EXPECT_GT(pool.getMetrics().stolenTasks, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestWorkStealingThreadPool, checkYieldedTasksRunAfterQueuedTasks)
+{
+  std::mutex mutex;
+  std::string order;
+  {
+    romea::core::WorkStealingThreadPool pool(1);
+    pool.submit([&] {
+        pool.submit([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order += "q";
+          });
+        pool.yield([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order += "y";
+          });
+        pool.submit([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order += "q";
+          });
+      });
+  }
+  EXPECT_EQ(order, "qqy");
+}